@@ -0,0 +1,98 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpbatch.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Batches of equally sized MaxPlus matrices
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_ALGEBRA_BATCH_H_INCLUDED
+#define MAXPLUS_ALGEBRA_BATCH_H_INCLUDED
+
+#include "maxplus/base/memory/alignedallocator.h"
+#include "mpmatrix.h"
+#include "mptype.h"
+#include <vector>
+
+namespace MaxPlus {
+
+/**
+ * MatrixBatch, a collection of K square max-plus matrices of the same size N.
+ * Entries are stored interleaved across the matrices (structure of arrays): entry (i, j)
+ * of all K matrices is contiguous, so that algorithms can process many matrices with the
+ * same vector instructions.
+ */
+class MatrixBatch {
+public:
+    MatrixBatch(unsigned int nrMatrices, unsigned int size, MPTime value = MP_MINUS_INFINITY);
+
+    /**
+     * Construct a batch from \p nrMatrices row-major matrices of \p size by \p size, stored
+     * one after the other in \p packed.
+     */
+    MatrixBatch(unsigned int nrMatrices, unsigned int size, const CDouble *packed);
+
+    [[nodiscard]] inline unsigned int getNrMatrices() const { return this->nrMatrices; }
+
+    [[nodiscard]] inline unsigned int getSize() const { return this->size; }
+
+    [[nodiscard]] MPTime get(unsigned int matrix, unsigned int row, unsigned int column) const;
+
+    void put(unsigned int matrix, unsigned int row, unsigned int column, MPTime value);
+
+    /**
+     * Copy square matrix \p M, of the batch's size, into position \p matrix.
+     */
+    void putMatrix(unsigned int matrix, const Matrix &M);
+
+    [[nodiscard]] Matrix getMatrix(unsigned int matrix) const;
+
+    /**
+     * mpEigenvalues ()
+     * The eigenvalues of all matrices, with the same value Matrix::mp_eigenvalue() gives for
+     * each of them. Karp's algorithm is run directly on the dense matrices, in chunks of
+     * matrices, with each step vectorized across the matrices of a chunk. Chunks are divided
+     * over up to \p nrThreads threads (0 for the number of hardware threads).
+     */
+    [[nodiscard]] std::vector<CDouble> mpEigenvalues(unsigned int nrThreads = 0) const;
+
+private:
+    [[nodiscard]] std::size_t index(unsigned int matrix, unsigned int row, unsigned int column) const;
+
+    unsigned int nrMatrices;
+    unsigned int size;
+    std::vector<CDouble, AlignedAllocator<CDouble>> table;
+};
+
+} // namespace MaxPlus
+
+#endif
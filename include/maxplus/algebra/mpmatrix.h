@@ -42,7 +42,9 @@
 #define MAXPLUS_ALGEBRA_MATRIX_H_INCLUDED
 
 #include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include "maxplus/base/memory/alignedallocator.h"
 #include "mptype.h"
+#include <cstdint>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -86,6 +88,15 @@ public:
     void negate();
     MPTime normalize();
 
+    /**
+     * normalizeAndHash ()
+     * Normalizes the vector like normalize() and computes, in the same pass, a hash of the
+     * normalized entries. Vectors that are equal after normalization get equal hashes, which
+     * makes the result suitable as key when storing normalized states.
+     * Returns the norm; the hash is written to \p hash.
+     */
+    MPTime normalizeAndHash(std::uint64_t &hash);
+
     [[nodiscard]] Vector add(MPTime increase) const;
 
     void add(MPTime increase, Vector &result) const;
@@ -124,7 +135,13 @@ public:
     MPTime minimalFiniteElement(unsigned int *itsPosition_Ptr = nullptr) const;
 
 private:
-    std::vector<MPTime> table;
+    friend class Matrix;
+
+    // storage is cache line aligned for the vectorized kernels, see mpvectorkernels.h
+    std::vector<MPTime, AlignedAllocator<MPTime>> table;
+
+    [[nodiscard]] CDouble *data();
+    [[nodiscard]] const CDouble *data() const;
 };
 
 enum class MatrixFill { MinusInfinity, Zero, Identity };
@@ -225,6 +242,26 @@ public:
 
     [[nodiscard]] Matrix mp_multiply(const Matrix &m) const;
 
+    /**
+     * residuate ()
+     * Greatest vector x such that A (x) x <= b, with x_j = min_i (b_i - a_ij), i.e. the
+     * min-minus product of the transposed matrix with b. Entries of x that are not bounded
+     * by any finite a_ij are MP_PLUS_INFINITY.
+     */
+    [[nodiscard]] Vector residuate(const Vector &b) const;
+
+    /**
+     * residuate ()
+     * Greatest matrix X such that A (x) X <= B, column-wise residuation of \p B.
+     */
+    [[nodiscard]] Matrix residuate(const Matrix &B) const;
+
+    /**
+     * isSolvable ()
+     * True if A (x) x = b has a solution, which is then residuate(b).
+     */
+    [[nodiscard]] bool isSolvable(const Vector &b) const;
+
     [[nodiscard]] Matrix mp_power(unsigned int p) const;
 
     [[nodiscard]] CDouble mp_eigenvalue() const;
@@ -248,7 +285,17 @@ public:
 
     void incrementalMaximum(const Matrix &matrix) { this->maximum(matrix, *this); }
 
-    bool operator==(const Matrix &other);
+    /**
+     * Matrices are equal if they have the same dimensions and identical entries.
+     */
+    bool operator==(const Matrix &other) const;
+
+    bool operator!=(const Matrix &other) const { return !(*this == other); }
+
+    /**
+     * 64-bit hash of the dimensions and entries, equal matrices have equal hashes.
+     */
+    [[nodiscard]] std::uint64_t hash() const;
 
     /**
      * Return the element having the largest abs() value.
@@ -0,0 +1,78 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpmatrixio.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Streaming text input and output of MaxPlus matrices
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_ALGEBRA_MATRIXIO_H_INCLUDED
+#define MAXPLUS_ALGEBRA_MATRIXIO_H_INCLUDED
+
+#include "mpmatrix.h"
+#include "mptype.h"
+#include <iosfwd>
+
+namespace MaxPlus {
+
+/**
+ * Text formats supported by the matrix reader and writer.
+ *  Plain  : rows separated by newlines, entries by spaces, -inf written as -mp_inf
+ *  Matlab : [ a b ; c d ] notation, -inf written as -Inf
+ *  CSV    : rows separated by newlines, entries by commas, -inf written as -Inf
+ */
+enum class MatrixTextFormat { Plain, Matlab, CSV };
+
+/**
+ * writeMatrix ()
+ * Writes matrix \p M to \p out in the given format. Entries are multiplied by \p scale.
+ * Finite entries are written in the shortest representation that reads back to the
+ * identical double, so that readMatrix(writeMatrix(M)) reproduces M exactly (for scale 1).
+ * Output is produced in fixed size chunks; no string is built for the whole matrix.
+ */
+void writeMatrix(std::ostream &out,
+                 const Matrix &M,
+                 MatrixTextFormat format = MatrixTextFormat::Plain,
+                 CDouble scale = 1.0);
+
+/**
+ * readMatrix ()
+ * Reads a matrix from \p in. Any of the formats produced by writeMatrix is accepted: entries
+ * may be separated by spaces, tabs or commas, rows end at a newline, ';' or ']'. Empty rows
+ * are skipped. The tokens -mp_inf, -Inf and -inf denote minus infinity.
+ * Throws an MPException on malformed entries or when rows have different lengths.
+ */
+Matrix readMatrix(std::istream &in);
+
+} // namespace MaxPlus
+
+#endif
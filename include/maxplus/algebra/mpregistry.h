@@ -0,0 +1,117 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpregistry.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Registry of unique MaxPlus matrices with memoized analysis results
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_ALGEBRA_REGISTRY_H_INCLUDED
+#define MAXPLUS_ALGEBRA_REGISTRY_H_INCLUDED
+
+#include "mpmatrix.h"
+#include "mptype.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace MaxPlus {
+
+/**
+ * MatrixRegistry, interns matrices by content.
+ * Matrices are looked up by their 64-bit hash and compared exactly, so that every distinct
+ * matrix is stored once and users of equal matrices share the same instance. Analysis
+ * results are computed once per unique matrix and kept with it.
+ * Interned matrices must not be modified while they are in the registry.
+ * The registry is not thread safe.
+ */
+class MatrixRegistry {
+public:
+    using GeneralizedEigenvectors =
+            std::pair<Matrix::EigenvectorList, Matrix::GeneralizedEigenvectorList>;
+
+    MatrixRegistry() = default;
+
+    /**
+     * intern ()
+     * Returns the registered matrix equal to \p M, registering \p M itself if there is none.
+     */
+    std::shared_ptr<Matrix> intern(const std::shared_ptr<Matrix> &M);
+
+    /**
+     * intern ()
+     * Returns the registered matrix equal to \p M, registering a copy if there is none.
+     */
+    std::shared_ptr<Matrix> intern(const Matrix &M);
+
+    /**
+     * Number of distinct matrices in the registry.
+     */
+    [[nodiscard]] std::size_t size() const { return this->entries.size(); }
+
+    void clear();
+
+    /**
+     * Memoized Matrix::mp_eigenvalue() of (the registered equivalent of) \p M.
+     */
+    CDouble eigenvalue(const Matrix &M);
+
+    /**
+     * Memoized Matrix::starClosureMatrix() of (the registered equivalent of) \p M.
+     */
+    const Matrix &starClosure(const Matrix &M, MPTime posCycleThreshold = MP_EPSILON);
+
+    /**
+     * Memoized Matrix::mp_generalized_eigenvectors() of (the registered equivalent of) \p M.
+     */
+    const GeneralizedEigenvectors &generalizedEigenvectors(const Matrix &M);
+
+private:
+    struct Entry {
+        std::shared_ptr<Matrix> matrix;
+        bool hasEigenvalue = false;
+        CDouble eigenvalue = 0.0;
+        std::map<CDouble, std::unique_ptr<Matrix>> starClosures;
+        std::unique_ptr<GeneralizedEigenvectors> generalizedEigenvectors;
+    };
+
+    Entry &find(const Matrix &M, std::uint64_t h, const std::shared_ptr<Matrix> *owner);
+
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::unordered_multimap<std::uint64_t, Entry *> index;
+};
+
+} // namespace MaxPlus
+
+#endif
@@ -99,6 +99,12 @@ public:
 
     [[nodiscard]] MPTime innerProduct(const SparseVector &v) const;
 
+    /**
+     * min-minus inner product, min_k (v_k - this_k) over the finite entries of this vector,
+     * MP_PLUS_INFINITY if there are none.
+     */
+    [[nodiscard]] MPTime residualProduct(const SparseVector &v) const;
+
     [[nodiscard]] SparseVector add(MPTime increase) const;
 
     [[nodiscard]] SparseVector maximum(const SparseVector &vecB) const;
@@ -186,6 +192,11 @@ public:
     SparseMatrix multiply(const SparseMatrix &M);
     SparseVector multiply(const SparseVector &v);
 
+    /**
+     * Greatest x such that this (x) x <= b, see Matrix::residuate.
+     */
+    SparseVector residuate(const SparseVector &b);
+
     void compress();
 
     void toString(MPString &outString, CDouble scale = 1.0) const;
@@ -117,6 +117,8 @@ inline CDouble MP_MIN(CDouble a, CDouble b) { return CDouble(MP_MIN(MPTime(a), M
 
 // the quick and dirty way of representing -infinity
 const MPTime MP_MINUS_INFINITY = MPTime(-1.0e+30);
+// top element, appears only as the result of residuation (min-minus products)
+const MPTime MP_PLUS_INFINITY = MPTime(MPTIME_MAXVAL);
 const MPTime MP_MINUS_INFINITY_THR = MPTime(-0.5e+30);
 const CDouble MPTIME_MIN_INF_VALPTHR = -0.5e+30;
 inline bool MP_IS_MINUS_INFINITY(CDouble a) { return a <= MPTIME_MIN_INF_VALPTHR; }
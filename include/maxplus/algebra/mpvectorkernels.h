@@ -0,0 +1,148 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpvectorkernels.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Vectorized element-wise and reduction kernels on max-plus vectors
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_ALGEBRA_VECTORKERNELS_H_INCLUDED
+#define MAXPLUS_ALGEBRA_VECTORKERNELS_H_INCLUDED
+
+#include "maxplus/base/basic_types.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Kernels operating on contiguous arrays of max-plus values represented as doubles.
+ * Every value at or below MPTIME_MIN_INF_VALPTHR counts as minus infinity; results that are
+ * minus infinity are always written as exactly MPTIME_MIN_INF_VAL, as MP_PLUS does.
+ * On x86-64 with GCC or Clang an AVX-512 or AVX2 implementation is selected at run time
+ * depending on the processor, otherwise portable scalar loops are used. All implementations
+ * produce bitwise identical results; a zero result of maxElement is always +0.0.
+ */
+namespace MaxPlus::VectorKernels {
+
+/**
+ * maxElement ()
+ * Maximum of x[0..n-1] and minus infinity.
+ */
+CDouble maxElement(const CDouble *x, std::size_t n);
+
+/**
+ * containsValue ()
+ * True if some x[k] is exactly equal to v.
+ */
+bool containsValue(const CDouble *x, std::size_t n, CDouble v);
+
+/**
+ * negate ()
+ * x[k] := -x[k]
+ */
+void negate(CDouble *x, std::size_t n);
+
+/**
+ * addScalar ()
+ * r[k] := x[k] (max-plus) times c, i.e. x[k] + c unless either is minus infinity.
+ * r may be equal to x.
+ */
+void addScalar(const CDouble *x, CDouble c, CDouble *r, std::size_t n);
+
+/**
+ * addScalarAndHash ()
+ * As addScalar, and returns a hash of the bit patterns of the results in the same pass.
+ * The hash does not distinguish 0.0 from -0.0.
+ */
+std::uint64_t addScalarAndHash(const CDouble *x, CDouble c, CDouble *r, std::size_t n);
+
+/**
+ * hash ()
+ * Hash of the bit patterns of x[0..n-1], the same hash addScalarAndHash computes.
+ */
+std::uint64_t hash(const CDouble *x, std::size_t n);
+
+/**
+ * add ()
+ * r[k] := a[k] (max-plus) times b[k]. r may be equal to a or b.
+ */
+void add(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n);
+
+/**
+ * maximum ()
+ * r[k] := max(a[k], b[k]). r may be equal to a or b.
+ */
+void maximum(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n);
+
+/**
+ * finiteAndClose ()
+ * True if all a[k] and b[k] are finite and |a[k] - b[k]| <= eps.
+ */
+bool finiteAndClose(const CDouble *a, const CDouble *b, std::size_t n, CDouble eps);
+
+/**
+ * minFiniteElement ()
+ * Smallest finite element and the index of its first occurrence. Returns false, leaving
+ * the outputs untouched, if all elements are minus infinity.
+ */
+bool minFiniteElement(const CDouble *x, std::size_t n, CDouble &value, std::size_t &position);
+
+/**
+ * minOfScalarMinus ()
+ * x[k] := min(x[k], b - a[k]) for every finite a[k]; entries with a[k] at minus infinity
+ * leave x[k] unchanged. Differences at or below the minus infinity threshold count as minus
+ * infinity. This is one row of a min-minus (residuation) product.
+ */
+void minOfScalarMinus(const CDouble *a, CDouble b, CDouble *x, std::size_t n);
+
+/**
+ * minOfMinusScalar ()
+ * x[k] := min(x[k], b[k] - a) for a finite a, with the same treatment of minus infinity as
+ * minOfScalarMinus.
+ */
+void minOfMinusScalar(const CDouble *b, CDouble a, CDouble *x, std::size_t n);
+
+/**
+ * maxOfSums ()
+ * d[k] := max(d[k], p[k] + a[k]) in plain floating point arithmetic, without the minus
+ * infinity normalization of MP_PLUS. One relaxation step of Karp's recurrence.
+ */
+void maxOfSums(const CDouble *p, const CDouble *a, CDouble *d, std::size_t n);
+
+/**
+ * minOfQuotients ()
+ * l[k] := min(l[k], (dn[k] - dk[k]) / q), the inner minimization of Karp's theorem.
+ */
+void minOfQuotients(const CDouble *dn, const CDouble *dk, CDouble q, CDouble *l, std::size_t n);
+
+} // namespace MaxPlus::VectorKernels
+
+#endif
@@ -45,7 +45,10 @@
 #ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCM_H_INCLUDED
 #define MAXPLUS_BASE_ANALYSIS_MCM_MCM_H_INCLUDED
 
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
 #include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include <cmath>
+#include <vector>
 
 namespace Graphs {
 
@@ -74,10 +77,12 @@ CDouble maximumCycleMeanKarpDouble(MCMgraph &g, const MCMnode **criticalNode = n
 ///		algorithm.
 /// 	Does not require that all nodes of the graph have an outgoing edge.
 /// 	Assumes that the edge weights are integer (!)
+/// 	The strongly connected components are evaluated in parallel.
 /// </summary>
 /// <param name="g">graph to analyse</param>
+/// <param name="nrThreads">number of threads, 0 for the number of hardware threads</param>
 /// <returns>The maximum cycle mean of the graph.</returns>
-CDouble maximumCycleMeanKarpGeneral(MCMgraph &g);
+CDouble maximumCycleMeanKarpGeneral(MCMgraph &g, unsigned int nrThreads = 0);
 
 /// <summary>
 ///		The function computes the maximum cycle mean of an MCMgraph using Karp's
@@ -86,9 +91,158 @@ CDouble maximumCycleMeanKarpGeneral(MCMgraph &g);
 /// </summary>
 /// <param name="g">graph to analyse</param>
 /// <param name="criticalNodeg">optional, will point to an arbitrary node on the cycle with the
-/// maximum cycle mean.</param> <returns>The maximum cycle mean of the graph and optionally a
-/// critical node.</returns>
-CDouble maximumCycleMeanKarpDoubleGeneral(MCMgraph &g, const MCMnode **criticalNode = nullptr);
+/// maximum cycle mean.</param>
+/// <param name="nrThreads">number of threads used to evaluate the strongly connected components
+/// in parallel, 0 for the number of hardware threads</param>
+/// <returns>The maximum cycle mean of the graph and optionally a critical node.</returns>
+CDouble maximumCycleMeanKarpDoubleGeneral(MCMgraph &g,
+                                          const MCMnode **criticalNode = nullptr,
+                                          unsigned int nrThreads = 0);
+
+/// <summary>
+///		The function computes the maximum cycle mean of a CompactMCMgraph using Karp's
+///		algorithm.
+/// 	Does not require that the graph is strongly connected or that all nodes of the
+/// 	graph have an outgoing edge.
+/// </summary>
+/// <param name="g">graph to analyse</param>
+/// <param name="criticalNodeg">optional, will point to a node attaining the maximum in Karp's
+/// theorem; if the graph is not strongly connected this node may lie downstream of the critical
+/// cycle.</param> <returns>The maximum cycle mean of the graph, or -INFINITY if the
+/// graph has no cycles, and optionally a critical node.</returns>
+CDouble maximumCycleMeanKarpDouble(const CompactMCMgraph &g,
+                                   const MCMnode **criticalNode = nullptr);
+
+/// <summary>
+///		The function computes the maximum cycle mean of a CompactMCMgraph using Karp's
+///		algorithm, computing every layer of the distance table in parallel.
+/// 	The result, including the critical node, is identical to that of
+/// 	maximumCycleMeanKarpDouble on the same graph.
+/// </summary>
+/// <param name="g">graph to analyse</param>
+/// <param name="criticalNodeg">optional, will point to a node attaining the maximum in Karp's
+/// theorem.</param>
+/// <param name="nrThreads">number of threads, 0 for the number of hardware threads</param>
+/// <returns>The maximum cycle mean of the graph, or -INFINITY if the graph has no
+/// cycles.</returns>
+CDouble maximumCycleMeanKarpDoubleParallel(const CompactMCMgraph &g,
+                                           const MCMnode **criticalNode = nullptr,
+                                           unsigned int nrThreads = 0);
+
+/// <summary>
+///		The function computes the maximum cycle mean of a CompactMCMgraph using Karp's
+///		algorithm in memory linear in the number of nodes, by recomputing the layers of the
+///		distance table instead of storing them. It stops early when the test of Hartmann and
+///		Orlin shows that the best cycle found so far is critical.
+/// </summary>
+/// <param name="g">graph to analyse</param>
+/// <param name="criticalNodeg">optional, will point to a node attaining the maximum in Karp's
+/// theorem, or to a node on a critical cycle if the algorithm stopped early.</param>
+/// <param name="nrLayers">optional, will be set to the number of layers computed in the first
+/// pass, which is the number of nodes unless the algorithm stopped early</param>
+/// <returns>The maximum cycle mean of the graph, or -INFINITY if the graph has no
+/// cycles.</returns>
+CDouble maximumCycleMeanKarpLean(const CompactMCMgraph &g,
+                                 const MCMnode **criticalNode = nullptr,
+                                 unsigned int *nrLayers = nullptr);
+
+/// <summary>
+///		The function computes the maximum cycle mean of component c of a decomposition of
+///		a CompactMCMgraph using Karp's algorithm, on the nodes and edges of the component in
+///		place.
+/// </summary>
+/// <param name="g">graph to analyse</param>
+/// <param name="scc">the strongly connected components of g, see decomposeComponents</param>
+/// <param name="c">the component to analyse</param>
+/// <param name="criticalNode">optional, will point to a node of the component attaining
+/// the maximum in Karp's theorem</param>
+/// <returns>The maximum cycle mean of the component, or -INFINITY if it has no
+/// edges.</returns>
+CDouble maximumCycleMeanKarpDouble(const CompactMCMgraph &g,
+                                   const ComponentDecomposition &scc,
+                                   unsigned int c,
+                                   const MCMnode **criticalNode = nullptr);
+
+/// <summary>
+///		The function computes the maximum cycle mean of a CompactMCMgraph using Karp's
+///		algorithm on each of its strongly connected components, without copying them.
+/// 	The components are analysed in parallel.
+/// </summary>
+/// <param name="g">graph to analyse</param>
+/// <param name="criticalNode">optional, will point to a node of a critical
+/// component attaining the maximum in Karp's theorem</param>
+/// <param name="nrThreads">number of threads, 0 for the number of hardware threads</param>
+/// <returns>The maximum cycle mean of the graph, or -INFINITY if the graph has no
+/// cycles.</returns>
+CDouble maximumCycleMeanKarpComponents(const CompactMCMgraph &g,
+                                       const MCMnode **criticalNode = nullptr,
+                                       unsigned int nrThreads = 0);
+
+/**
+ * The algorithms that maximumCycleMean can use.
+ */
+enum class MCMAlgorithm {
+    Automatic,
+    Karp,
+    KarpParallel,
+    KarpLean,
+    Howard,
+    YoungTarjanOrlin,
+    DasdanGupta
+};
+
+/**
+ * Options of maximumCycleMean.
+ */
+struct MCMOptions {
+    // algorithm to use, Automatic selects one from statistics of the graph
+    MCMAlgorithm algorithm = MCMAlgorithm::Automatic;
+    // number of threads for Karp's algorithms, 0 for the number of hardware threads
+    unsigned int nrThreads = 0;
+    // whether a critical cycle must be returned
+    bool criticalCycle = false;
+    // maximum number of policies evaluated by Howard's algorithm, 0 for its own limit;
+    // with Automatic, an algorithm that always terminates is used when it is exceeded
+    unsigned int maxHowardIterations = 0;
+};
+
+/**
+ * Result of maximumCycleMean.
+ */
+struct MCMResult {
+    // the maximum cycle mean, -INFINITY if the graph has no cycles
+    CDouble value = -INFINITY;
+    // a critical cycle, in the order of its edges, if requested
+    std::vector<const MCMedge *> cycle;
+    // the algorithm that computed the value
+    MCMAlgorithm algorithm = MCMAlgorithm::Automatic;
+
+    // statistics of the graph after removing the nodes that cannot reach a cycle
+    unsigned int nrNodes = 0;
+    unsigned int nrEdges = 0;
+    bool integerWeights = true;
+
+    // time in seconds spent converting the graph, computing the value and
+    // extracting the critical cycle
+    CDouble preparationTime = 0.0;
+    CDouble solveTime = 0.0;
+    CDouble cycleTime = 0.0;
+};
+
+/**
+ * maximumCycleMean ()
+ * The function computes the maximum cycle mean of the visible part of an
+ * MCMgraph. Unlike the individual algorithms it makes no assumptions about the
+ * graph: it converts the graph once to a CompactMCMgraph and removes the nodes
+ * that cannot reach a cycle, so that every remaining node has an outgoing edge.
+ * With MCMAlgorithm::Automatic, small graphs are analysed with Karp's
+ * algorithm and all others with Howard's policy iteration, falling back to the
+ * lean Karp algorithm, or to Young-Tarjan-Orlin's algorithm if a critical cycle
+ * is requested, if Howard does not converge. Critical cycles come from Howard's
+ * or Young-Tarjan-Orlin's algorithm; if the selected algorithm does not produce
+ * one, Young-Tarjan-Orlin's algorithm is run to extract it.
+ */
+MCMResult maximumCycleMean(MCMgraph &g, const MCMOptions &options = MCMOptions());
 
 /**
  * mcmGetAdjacentActors ()
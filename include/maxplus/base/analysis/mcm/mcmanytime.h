@@ -0,0 +1,98 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmanytime.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Anytime maximum cycle mean with converging bounds.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMANYTIME_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMANYTIME_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
+#include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * Bounds on the maximum cycle mean computed by anytimeMaximumCycleMean.
+ */
+struct AnytimeMCMResult {
+    // the mean of the best cycle found so far, -INFINITY if none was found
+    CDouble lower = -INFINITY;
+    // an upper bound certified by node potentials, -INFINITY if the graph has
+    // no cycles
+    CDouble upper = INFINITY;
+    // a cycle with mean lower, in the order of its edges; only in the final result
+    std::vector<const MCMedge *> cycle;
+    // number of policies of Howard's algorithm evaluated
+    unsigned int nrIterations = 0;
+    // time in seconds since the start of the analysis
+    CDouble elapsed = 0.0;
+    // whether upper - lower is within the tolerance or Howard's algorithm converged
+    bool converged = false;
+};
+
+/**
+ * Options of anytimeMaximumCycleMean.
+ */
+struct AnytimeMCMOptions {
+    // the analysis stops at the first checkpoint after the deadline
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    // the analysis stops when upper - lower is at most the tolerance
+    CDouble tolerance = 0.0;
+    // called with the bounds at every checkpoint, optional
+    std::function<void(const AnytimeMCMResult &bounds)> progress;
+};
+
+/**
+ * anytimeMaximumCycleMean ()
+ * Bounds on the maximum cycle mean of g that converge while Howard's algorithm
+ * runs. Every iteration of Howard's algorithm is a checkpoint at which the
+ * lower bound is the mean of the best cycle of the policies so far, and the
+ * upper bound is the largest w(e) + v(dst(e)) - v(src(e)) over the edges e
+ * inside a strongly connected component for the bias v of the policy. The
+ * analysis stops at the first checkpoint after the deadline, or once the gap
+ * between the bounds is at most the tolerance, and otherwise when Howard's
+ * algorithm has converged.
+ */
+AnytimeMCMResult anytimeMaximumCycleMean(const CompactMCMgraph &g,
+                                         const AnytimeMCMOptions &options);
+AnytimeMCMResult anytimeMaximumCycleMean(MCMgraph &g, const AnytimeMCMOptions &options);
+
+} // namespace Graphs
+
+#endif
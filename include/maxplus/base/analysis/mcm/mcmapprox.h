@@ -0,0 +1,99 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmapprox.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Approximate maximum cycle mean and ratio by parametric search.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMAPPROX_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMAPPROX_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
+#include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include <cmath>
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * An interval that contains the maximum cycle mean or ratio of a graph, as
+ * computed by approximateMaximumCycleMean or approximateMaximumCycleRatio.
+ */
+struct ApproximateMCMResult {
+    // the mean or ratio of the cycle, a lower bound
+    CDouble lower = -INFINITY;
+    // an upper bound, normally at most eps above lower
+    CDouble upper = -INFINITY;
+    // a cycle with mean or ratio lower, in the order of its edges
+    std::vector<const MCMedge *> cycle;
+    // number of positive cycle tests of the parametric search
+    unsigned int nrProbes = 0;
+};
+
+/**
+ * approximateMaximumCycleRatio ()
+ * An interval [lower, upper] with upper - lower <= eps that contains the
+ * maximum cycle ratio of edge weight over delay of g, with a cycle with ratio
+ * lower. The delays must be non-negative. Lawler's parametric search halves
+ * the interval with a test for a cycle of positive length under the weights
+ * w(e) - lambda * d(e). The test is a Bellman-Ford algorithm that relaxes the
+ * nodes in rounds in parallel on up to nrThreads threads (0 for the number of
+ * hardware threads), and stops as soon as the edges to the parents of the
+ * nodes form a cycle. The result does not depend on the number of threads.
+ *
+ * The test ignores gains in path length below a relative tolerance of 1e-12.
+ * The upper bound is widened by what that tolerance may hide, so it remains
+ * a bound; if this widening exceeds eps, upper - lower may exceed eps.
+ *
+ * If g has no cycle, both bounds are -INFINITY. A cycle without delay has an
+ * infinite ratio: then both bounds are +INFINITY and that cycle is returned.
+ * Throws an MPException if eps is not positive or a delay is negative.
+ */
+ApproximateMCMResult
+approximateMaximumCycleRatio(const CompactMCMgraph &g, CDouble eps, unsigned int nrThreads = 0);
+ApproximateMCMResult
+approximateMaximumCycleRatio(MCMgraph &g, CDouble eps, unsigned int nrThreads = 0);
+
+/**
+ * approximateMaximumCycleMean ()
+ * As approximateMaximumCycleRatio (), for the maximum cycle mean of g, i.e.,
+ * with every delay taken as 1.
+ */
+ApproximateMCMResult
+approximateMaximumCycleMean(const CompactMCMgraph &g, CDouble eps, unsigned int nrThreads = 0);
+ApproximateMCMResult
+approximateMaximumCycleMean(MCMgraph &g, CDouble eps, unsigned int nrThreads = 0);
+
+} // namespace Graphs
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmbatch.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Maximum cycle means of many weightings of one graph
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMBATCH_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMBATCH_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * maximumCycleMeansBatch ()
+ * The maximum cycle means of K weightings of the same graph. Weighting k is
+ * row k of the K x nrEdges() matrix weights, stored row by row, and assigns
+ * weights[k * nrEdges() + e] to edge e of g; the weights stored in g itself
+ * are not used. Result k is bit-identical to maximumCycleMeanKarpDouble on g
+ * with weighting k, -INFINITY if g has no cycle.
+ *
+ * The weightings are processed in chunks, with every step of Karp's algorithm
+ * applied to all weightings of a chunk at once, and the chunks are divided
+ * over up to nrThreads threads (0 for the number of hardware threads).
+ *
+ * If cycles is not nullptr, it receives for every weighting a cycle with the
+ * maximum cycle mean, found with Howard's algorithm warm-started from the
+ * previous weighting of the chunk.
+ */
+std::vector<CDouble>
+maximumCycleMeansBatch(const CompactMCMgraph &g,
+                       const std::vector<CDouble> &weights,
+                       std::vector<std::vector<const MCMedge *>> *cycles = nullptr,
+                       unsigned int nrThreads = 0);
+
+} // namespace Graphs
+
+#endif
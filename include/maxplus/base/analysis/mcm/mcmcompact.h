@@ -0,0 +1,216 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmcompact.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Compact, array based snapshot of an MCMgraph.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMCOMPACT_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMCOMPACT_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * CompactMCMgraph
+ * A read-only snapshot of the visible part of an MCMgraph in compressed sparse
+ * row form. Nodes are numbered densely 0..nrNodes()-1 in the order in which
+ * they appear in the MCMgraph, edges 0..nrEdges()-1 in the order of the edge
+ * list. Edge weights and delays are stored in separate arrays, and for every
+ * node the outgoing and incoming edges are stored consecutively, such that the
+ * MCM algorithms can run over the graph without chasing list pointers.
+ * The snapshot refers to the nodes and edges of the original graph, which must
+ * outlive it and must not be modified while it is in use.
+ */
+class CompactMCMgraph {
+public:
+    CompactMCMgraph() = default;
+
+    // Build the snapshot from the visible nodes and edges of g in O(n+m)
+    explicit CompactMCMgraph(MCMgraph &g);
+
+    // A snapshot of a graph that is given by its edges only, for instance as read
+    // from a file, with nodes 0 .. nrNodes - 1. Such a snapshot has no original
+    // graph: node() and edge() return nullptr, and so do the critical nodes and
+    // the edges of critical cycles that algorithms report for it.
+    static CompactMCMgraph fromEdges(unsigned int nrNodes,
+                                     std::vector<unsigned int> src,
+                                     std::vector<unsigned int> dst,
+                                     std::vector<CDouble> w,
+                                     std::vector<CDouble> d);
+
+    // The subgraph induced by the nodes v for which keep[v] is true, with the
+    // nodes and edges in the same relative order
+    [[nodiscard]] CompactMCMgraph subgraph(const std::vector<bool> &keep) const;
+
+    // The snapshot without the edges that are not Pareto maximal, see
+    // MCMgraph::pruneEdges, with the remaining edges in the same relative
+    // order. The nodes are processed in parallel on up to nrThreads threads.
+    [[nodiscard]] CompactMCMgraph pruneEdges(unsigned int nrThreads = 0) const;
+
+    [[nodiscard]] unsigned int nrNodes() const {
+        return static_cast<unsigned int>(this->nodes.size());
+    }
+    [[nodiscard]] unsigned int nrEdges() const {
+        return static_cast<unsigned int>(this->edges.size());
+    }
+
+    // outgoing edges of node v are outEdge(i) for outBegin(v) <= i < outEnd(v)
+    [[nodiscard]] unsigned int outBegin(unsigned int v) const { return this->outStart[v]; }
+    [[nodiscard]] unsigned int outEnd(unsigned int v) const { return this->outStart[v + 1]; }
+    [[nodiscard]] unsigned int outEdge(unsigned int i) const { return this->outEdges[i]; }
+
+    // incoming edges of node v are inEdge(i) for inBegin(v) <= i < inEnd(v)
+    [[nodiscard]] unsigned int inBegin(unsigned int v) const { return this->inStart[v]; }
+    [[nodiscard]] unsigned int inEnd(unsigned int v) const { return this->inStart[v + 1]; }
+    [[nodiscard]] unsigned int inEdge(unsigned int i) const { return this->inEdges[i]; }
+
+    [[nodiscard]] unsigned int source(unsigned int e) const { return this->src[e]; }
+    [[nodiscard]] unsigned int destination(unsigned int e) const { return this->dst[e]; }
+    [[nodiscard]] CDouble weight(unsigned int e) const { return this->w[e]; }
+    [[nodiscard]] CDouble delay(unsigned int e) const { return this->d[e]; }
+
+    [[nodiscard]] const std::vector<CDouble> &weights() const { return this->w; }
+    [[nodiscard]] const std::vector<CDouble> &delays() const { return this->d; }
+
+    // the nodes and edges of the original graph
+    [[nodiscard]] MCMnode *node(unsigned int v) const { return this->nodes[v]; }
+    [[nodiscard]] const MCMedge *edge(unsigned int e) const { return this->edges[e]; }
+    [[nodiscard]] std::vector<const MCMedge *>
+    originalEdges(const std::vector<unsigned int> &es) const {
+        std::vector<const MCMedge *> result;
+        result.reserve(es.size());
+        for (unsigned int e : es) {
+            result.push_back(this->edges[e]);
+        }
+        return result;
+    }
+
+private:
+    // Fill the adjacency arrays from src and dst
+    void buildAdjacency();
+
+    std::vector<unsigned int> outStart;
+    std::vector<unsigned int> outEdges;
+    std::vector<unsigned int> inStart;
+    std::vector<unsigned int> inEdges;
+    std::vector<unsigned int> src;
+    std::vector<unsigned int> dst;
+    std::vector<CDouble> w;
+    std::vector<CDouble> d;
+    std::vector<MCMnode *> nodes;
+    std::vector<const MCMedge *> edges;
+};
+
+/**
+ * nodesReachingCycles ()
+ * Marks the nodes of g from which a cycle can be reached. The subgraph of the
+ * marked nodes has the same cycles as g and every node in it has an outgoing
+ * edge.
+ */
+std::vector<bool> nodesReachingCycles(const CompactMCMgraph &g);
+
+/**
+ * findCycle ()
+ * Searches a cycle of g that uses only the edges e for which use[e] is true.
+ * Returns true and the edges of the cycle in traversal order if there is one.
+ */
+bool findCycle(const CompactMCMgraph &g,
+               const std::vector<bool> &use,
+               std::vector<unsigned int> *cycle);
+
+/**
+ * stronglyConnectedComponents ()
+ * Numbers the strongly connected components of the graph of the edges e of g
+ * for which use[e] is true in O(n+m). Node v gets component (*component)[v].
+ * The components are numbered in reverse topological order: an edge between
+ * two components goes from a higher to a lower number. Returns the number of
+ * components.
+ */
+unsigned int stronglyConnectedComponents(const CompactMCMgraph &g,
+                                         const std::vector<bool> &use,
+                                         std::vector<unsigned int> *component);
+
+/**
+ * ComponentDecomposition
+ * The strongly connected components of a compact graph and its condensation as
+ * flat index arrays. The components are numbered in reverse topological order,
+ * as by stronglyConnectedComponents. Algorithms work on a component through its
+ * ranges of nodes and edges, without building a graph for it.
+ */
+struct ComponentDecomposition {
+    unsigned int nrComponents = 0;
+
+    // the component of node v, and the position of v among the nodes of its
+    // component, so that per component data can be kept in dense arrays
+    std::vector<unsigned int> component;
+    std::vector<unsigned int> position;
+
+    // the nodes of component c are nodes[i] for nodeStart[c] <= i < nodeStart[c + 1],
+    // in increasing order
+    std::vector<unsigned int> nodeStart;
+    std::vector<unsigned int> nodes;
+
+    // the edges inside component c are edges[i] for edgeStart[c] <= i < edgeStart[c + 1],
+    // in increasing order; a component has a cycle if and only if it has an edge
+    std::vector<unsigned int> edgeStart;
+    std::vector<unsigned int> edges;
+
+    // the edges between different components
+    std::vector<unsigned int> crossEdges;
+
+    // the condensation, a DAG: component c has an edge to the components
+    // successors[i] for successorStart[c] <= i < successorStart[c + 1], each once
+    std::vector<unsigned int> successorStart;
+    std::vector<unsigned int> successors;
+
+    [[nodiscard]] unsigned int nrNodes(unsigned int c) const {
+        return this->nodeStart[c + 1] - this->nodeStart[c];
+    }
+    [[nodiscard]] unsigned int nrEdges(unsigned int c) const {
+        return this->edgeStart[c + 1] - this->edgeStart[c];
+    }
+};
+
+/**
+ * decomposeComponents ()
+ * The strongly connected components of g with their nodes, edges and the
+ * condensation, in O(n+m) without copying any part of g.
+ */
+ComponentDecomposition decomposeComponents(const CompactMCMgraph &g);
+
+} // namespace Graphs
+
+#endif
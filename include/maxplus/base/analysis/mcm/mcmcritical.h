@@ -0,0 +1,91 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmcritical.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Critical graph of the maximum cycle mean.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMCRITICAL_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMCRITICAL_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
+#include <cmath>
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * CriticalComponent
+ * A strongly connected component of the critical graph with its nodes and the
+ * critical edges between them, in the order of the graph.
+ */
+struct CriticalComponent {
+    std::vector<const MCMnode *> nodes;
+    std::vector<const MCMedge *> edges;
+};
+
+/**
+ * CriticalGraph
+ * The critical graph of a graph consists of the nodes and edges that lie on a
+ * cycle whose mean is the maximum cycle mean. Every cycle of the critical graph
+ * is critical, so its strongly connected components describe all critical
+ * cycles.
+ */
+struct CriticalGraph {
+    // the maximum cycle mean, -INFINITY if the graph has no cycle
+    CDouble mcm = -INFINITY;
+
+    // the strongly connected components, ordered by their first node
+    std::vector<CriticalComponent> components;
+};
+
+/**
+ * criticalGraph ()
+ * Computes the critical graph of g in one run of Howard's algorithm. The bias
+ * of the optimal policy is a potential under which no edge between nodes with
+ * the maximum cycle mean has a positive reduced weight w - mcm + x(dst) - x(src).
+ * The critical edges are the edges with reduced weight zero, up to a tolerance
+ * relative to the weights, that lie in a strongly connected component of those
+ * edges. Apart from Howard's algorithm, this takes O(n+m) time.
+ */
+CriticalGraph criticalGraph(const CompactMCMgraph &g);
+
+/**
+ * criticalGraph ()
+ * The critical graph of the visible part of g.
+ */
+CriticalGraph criticalGraph(MCMgraph &g);
+
+} // namespace Graphs
+
+#endif
@@ -51,6 +51,7 @@
 #ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMDG_H_INCLUDED
 #define MAXPLUS_BASE_ANALYSIS_MCM_MCMDG_H_INCLUDED
 
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
 #include "maxplus/base/analysis/mcm/mcmgraph.h"
 
 namespace Graphs {
@@ -66,6 +67,16 @@ namespace Graphs {
  */
 CDouble mcmDG(MCMgraph &mcmGraph);
 
+/**
+ * mcmDG ()
+ * The function computes the maximum cycle mean of a compact graph using
+ * Dasdan-Gupta's algorithm from a virtual source node connected to all nodes,
+ * so no decomposition into strongly connected components is needed.
+ * Edge weights need not be integer valued. Returns -INFINITY if the graph has
+ * no cycles.
+ */
+CDouble mcmDG(const CompactMCMgraph &g);
+
 } // namespace Graphs
 
 #endif
\ No newline at end of file
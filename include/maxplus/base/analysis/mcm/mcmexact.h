@@ -0,0 +1,92 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmexact.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Exact maximum cycle mean and ratio of integer weighted graphs
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMEXACT_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMEXACT_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
+#include "maxplus/base/fraction/fraction.h"
+#include <cstdint>
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * maximumCycleRatioExact ()
+ * The exact maximum cycle ratio of weights over delays of g, where edge e has
+ * weight weights[e] and delay delays[e] >= 0. The result is the reduced
+ * fraction of the weight and delay sums of a critical cycle, which is returned
+ * in cycle, in traversal order, if cycle is not nullptr.
+ *
+ * A cycle estimated by Howard's algorithm in floating point is improved until
+ * no cycle with a larger ratio p/q exists, which is decided exactly by a
+ * Bellman-Ford search for a positive cycle with the integer edge weights
+ * q * weight - p * delay. All arithmetic is on 64 and 128 bit integers; if
+ * the sums of a cycle do not fit in 64 bits or a path length does not fit
+ * in 128 bits, an MPException is thrown.
+ *
+ * If g has no cycle, the result is not a fraction and has the value -INFINITY.
+ * A cycle without delay is a deadlock: the result then has value +INFINITY and
+ * that cycle is returned.
+ */
+MaxPlus::CFraction maximumCycleRatioExact(const CompactMCMgraph &g,
+                                          const std::vector<std::int64_t> &weights,
+                                          const std::vector<std::int64_t> &delays,
+                                          std::vector<const MCMedge *> *cycle = nullptr);
+
+/**
+ * maximumCycleMeanExact ()
+ * The exact maximum cycle mean of g with edge weights weights[e], computed as
+ * the maximum cycle ratio with all delays equal to one.
+ */
+MaxPlus::CFraction maximumCycleMeanExact(const CompactMCMgraph &g,
+                                         const std::vector<std::int64_t> &weights,
+                                         std::vector<const MCMedge *> *cycle = nullptr);
+
+/**
+ * The exact maximum cycle ratio and mean of the visible part of an MCMgraph,
+ * whose weights, and for the ratio also delays, must be integers in the range
+ * of std::int64_t.
+ */
+MaxPlus::CFraction maximumCycleRatioExact(MCMgraph &g,
+                                          std::vector<const MCMedge *> *cycle = nullptr);
+MaxPlus::CFraction maximumCycleMeanExact(MCMgraph &g,
+                                         std::vector<const MCMedge *> *cycle = nullptr);
+
+} // namespace Graphs
+
+#endif
@@ -43,7 +43,9 @@
 #define MAXPLUS_BASE_ANALYSIS_MCM_MCMGRAPH_H_INCLUDED
 
 #include "maxplus/base/basic_types.h"
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <utility>
 
 namespace Graphs {
@@ -116,39 +118,21 @@ public:
         }
         return nrNodes;
     };
-    MCMnode *getNode(CId id) {
-        for (auto &node : nodes) {
-            if (node.id == id) {
-                return &node;
-            }
-        }
-        return nullptr;
-    };
+    // Lookup of a node by id in O(1) expected time. Ids that are changed
+    // directly on the node rather than with setNodeId are not found.
+    MCMnode *getNode(CId id);
 
     [[nodiscard]] unsigned int numberOfEdges() {
         return static_cast<unsigned int>(this->edges.size());
     };
     [[nodiscard]] MCMedges &getEdges() { return edges; };
 
-    MCMedge *getEdge(CId id) {
-        for (auto &edge : edges) {
-            if (edge.id == id) {
-                return &edge;
-            }
-        }
-        return nullptr;
-    };
+    // Lookup of an edge by id in O(1) expected time. Ids that are changed
+    // directly on the edge rather than with setEdgeId are not found.
+    MCMedge *getEdge(CId id);
 
-    MCMedge *getEdge(CId srcId, CId dstId) {
-        for (auto &edge : edges) {
-            if (edge.src->id == srcId) {
-                if (edge.dst->id == dstId) {
-                    return &edge;
-                }
-            }
-        }
-        return nullptr;
-    };
+    // Lookup of an edge by its end points in O(out-degree of the source).
+    MCMedge *getEdge(CId srcId, CId dstId);
 
     [[nodiscard]] uint nrVisibleEdges() const {
         uint nrEdges = 0;
@@ -163,49 +147,40 @@ public:
     // Construction
 
     // Add a node to the MCM graph
-    MCMnode *addNode(CId nId, bool nVisible = true) {
-        // Add the node to the MCM graph
-        return &this->nodes.emplace_back(nId, nVisible);
-    }
-
-    // Remove a node from the MCMgraph.
-    // Note: containers of nodes are lists, so remove is expensive!
-    void removeNode(MCMnode &n) {
-        // remove any remaining edges
-        while (!n.in.empty()) {
-            this->removeEdge(**(n.in.begin()));
-        }
-        while (!n.out.empty()) {
-            this->removeEdge(**(n.out.begin()));
-        }
-        this->nodes.remove(n);
-    }
+    MCMnode *addNode(CId nId, bool nVisible = true);
+
+    // Remove a node from the MCMgraph, in time linear in the number of edges
+    // of the node and the degrees of its neighbours.
+    void removeNode(MCMnode &n);
 
     // Add an edge to the MCMgraph.
     MCMedge *
-    addEdge(CId id, MCMnode &src, MCMnode &dst, CDouble w, CDouble d, bool visible = true) {
-        MCMedge &e = this->edges.emplace_back(id, src, dst, w, d, visible);
-        src.out.push_back(&e);
-        dst.in.push_back(&e);
-        return &e;
-    }
-
-    // Remove an edge from the MCMgraph.
-    // Note: containers of edges are lists, so remove is expensive!
-    void removeEdge(MCMedge &e) {
-        e.src->out.remove(&e);
-        e.dst->in.remove(&e);
-        this->edges.remove(e);
-    }
+    addEdge(CId id, MCMnode &src, MCMnode &dst, CDouble w, CDouble d, bool visible = true);
+
+    // Make room in the indices for nrEdges edges in total, before adding many
+    void reserveEdges(size_t nrEdges);
+
+    // Remove an edge from the MCMgraph, in time linear in the out-degree of
+    // its source and the in-degree of its destination.
+    void removeEdge(MCMedge &e);
+
+    // Change the id of a node or an edge and update the index accordingly.
+    void setNodeId(MCMnode &n, CId id);
+    void setEdgeId(MCMedge &e, CId id);
 
     void relabelNodeIds(std::map<CId, CId> *nodeIdMap = nullptr);
 
     // reduce the MCM graph by removing obviously redundant edges
     // in particular if there are multiple edges between the same pair
     // of nodes and for some edge (w1, d1) there exists a different edge
-    // (w2, d2) such that d2<=d1 and w2>=w1, then (w2, d2) is removed
+    // (w2, d2) such that d2<=d1 and w2>=w1, then (w1, d1) is removed
+    // The outgoing edges of the nodes are pruned in parallel on up to nrThreads
+    // threads (0 for the number of hardware threads).
     // Note this algorithm does currently not distinguish visible and invisible edges!
-    std::shared_ptr<MCMgraph> pruneEdges();
+    std::shared_ptr<MCMgraph> pruneEdges(unsigned int nrThreads = 0);
+
+    // as pruneEdges, but removes the redundant edges from this graph
+    void pruneEdgesInPlace(unsigned int nrThreads = 0);
 
     [[nodiscard]] CDouble calculateMaximumCycleMeanKarp();
     [[nodiscard]] CDouble
@@ -222,11 +197,27 @@ public:
     normalizedLongestPaths(CId rootNodeId, const std::map<CId, CDouble> &) const;
 
 private:
+    // The Pareto maximal outgoing edges of every node, in node order
+    std::vector<std::vector<MCMedge *>> paretoFronts(unsigned int nrThreads);
+
     // Nodes
     MCMnodes nodes;
 
     // Edges
     MCMedges edges;
+
+    // Position of every node and edge in its list, for constant time removal
+    std::unordered_map<const MCMnode *, MCMnodes::iterator> nodePositions;
+    std::unordered_map<const MCMedge *, MCMedges::iterator> edgePositions;
+
+    // Index of the nodes and edges by id, kept up to date by every function
+    // that changes ids. Removal rebuilds it if an id was changed directly, so
+    // that it never refers to a removed node or edge.
+    std::unordered_map<CId, MCMnode *> nodeIndex;
+    std::unordered_map<CId, MCMedge *> edgeIndex;
+
+    void reindexNodes();
+    void reindexEdges();
 };
 
 using MCMgraphs = std::list<std::shared_ptr<MCMgraph>>;
@@ -247,6 +238,23 @@ void stronglyConnectedMCMgraph(MCMgraph &g,
                                MCMgraphs &components,
                                bool includeComponentsWithoutEdges = false);
 
+/**
+ * maximumCycleMeanOverComponents ()
+ * The function splits the graph into its strongly connected components and
+ * evaluates mcm on each of them, with node ids relabelled to 0..n-1. The
+ * components are handed out largest first to up to nrThreads threads (0 for
+ * the number of hardware threads). A component is skipped when its largest
+ * edge weight, an upper bound on its cycle mean, is below the best value found
+ * so far. The maximum is reduced in component order with a strict comparison,
+ * so the result and the critical node do not depend on the scheduling.
+ * Returns -INFINITY if the graph has no cycles.
+ */
+CDouble maximumCycleMeanOverComponents(
+        MCMgraph &g,
+        const std::function<CDouble(MCMgraph &scc, const MCMnode **criticalNode)> &mcm,
+        MCMnode **criticalNode,
+        unsigned int nrThreads);
+
 /**
  * relabelMCMgraph ()
  * The function removes all hidden nodes and edges from the graph. All visible
@@ -260,8 +268,11 @@ void relabelMCMgraph(MCMgraph &g);
  * longest path between two nodes crossing one edge with a delay. Edges
  * with no delay are removed and edges with more than one delay element
  * are converted into a sequence of edges with one delay element.
+ * Cycles of edges without delay must not have a positive weight; an
+ * MPException is thrown otherwise. The longest paths are computed on up to
+ * nrThreads threads (0 for the number of hardware threads).
  */
-void addLongestDelayEdgesToMCMgraph(MCMgraph &g);
+void addLongestDelayEdgesToMCMgraph(MCMgraph &g, unsigned int nrThreads = 0);
 
 } // namespace Graphs
 #endif
@@ -52,7 +52,9 @@
 #ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMHOWARD_H_INCLUDED
 #define MAXPLUS_BASE_ANALYSIS_MCM_MCMHOWARD_H_INCLUDED
 
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
 #include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include <functional>
 #include <memory>
 namespace Graphs {
 /**
@@ -94,6 +96,86 @@ void Howard(const std::vector<int> &ij,
             int *nr_iterations,
             int *nr_components);
 
+/**
+ * Howard ()
+ * Howard Policy Iteration Algorithm for the maximum cycle ratio of a sparse
+ * matrix (ij, A) as above, with transit times T[k] on the arcs. The transit
+ * times must be non-negative and every cycle must have a positive transit time.
+ * chi then holds the cycle ratios.
+ */
+void Howard(const std::vector<int> &ij,
+            const std::vector<CDouble> &A,
+            const std::vector<CDouble> &T,
+            int nr_nodes,
+            int nr_arcs,
+            std::shared_ptr<std::vector<CDouble>> *chi,
+            std::shared_ptr<std::vector<CDouble>> *v,
+            std::shared_ptr<std::vector<int>> *policy,
+            int *nr_iterations,
+            int *nr_components);
+
+/**
+ * HowardState
+ * Input and result of Howard's algorithm that can be kept between runs. The
+ * sparse matrix (ij, A) describes the graph as in Howard () above; when weights
+ * change but the topology does not, only A needs to be updated. The policy of a
+ * run is the starting point of the next run, so that repeated runs on slightly
+ * changed weights converge in a few iterations. The bias v is a result only.
+ */
+struct HowardState {
+    // sparse matrix
+    std::vector<int> ij;
+    std::vector<CDouble> A;
+    int nrNodes = 0;
+
+    // result of the last run
+    std::vector<CDouble> chi;
+    std::vector<CDouble> v;
+    std::vector<int> policy;
+    int nrIterations = 0;
+    int nrComponents = 0;
+};
+
+/**
+ * convertMCMgraphToMatrix ()
+ * The function converts the visible part of a graph to the sparse matrix of
+ * a HowardState. The results in the state are kept if the topology is the
+ * same as that of the matrix already in the state.
+ */
+void convertMCMgraphToMatrix(MCMgraph &g, HowardState &state);
+
+/**
+ * Howard ()
+ * Howard Policy Iteration Algorithm on the matrix in state, starting from the
+ * policy in state if present. The results are stored in state.
+ */
+void Howard(HowardState &state);
+
+/**
+ * HowardCheckpoint
+ * Called by Howard () after the evaluation of every policy, with the cycle time
+ * vector chi, the bias v and the policy. Every chi[i] is the mean of a cycle of
+ * the graph. When it returns false, Howard () stops without an error and the
+ * state holds the policy that was evaluated last.
+ */
+using HowardCheckpoint = std::function<bool(const std::vector<CDouble> &chi,
+                                            const std::vector<CDouble> &v,
+                                            const std::vector<int> &policy)>;
+
+/**
+ * Howard ()
+ * As above, calling checkpoint after every evaluation of a policy, so that the
+ * caller can follow the progress of the iteration or stop it.
+ */
+void Howard(HowardState &state, const HowardCheckpoint &checkpoint);
+
+/**
+ * maximumCycleMeanHoward ()
+ * Howard Policy Iteration Algorithm for Max Plus Matrices, warm-started from
+ * and updating state. The visible nodes must all have an outgoing edge.
+ */
+CDouble maximumCycleMeanHoward(MCMgraph &g, HowardState &state, MCMnode **criticalNode = nullptr);
+
 /**
  * maximumCycleMeanHoward ()
  * Howard Policy Iteration Algorithm for Max Plus Matrices.
@@ -122,8 +204,80 @@ CDouble maximumCycleMeanHoward(MCMgraph &g, MCMnode **criticalNode);
  *      maximum cycle mean
  *      a node on the cycle with maximum cycle mean
  *
+ * The strongly connected components are evaluated in parallel on up to
+ * nrThreads threads (0 for the number of hardware threads).
+ */
+CDouble maximumCycleMeanHowardGeneral(MCMgraph &g,
+                                      MCMnode **criticalNode,
+                                      unsigned int nrThreads = 0);
+
+/**
+ * convertMCMgraphToMatrix ()
+ * The function converts a compact graph to a sparse matrix input for Howard's
+ * algorithm.
+ */
+void convertMCMgraphToMatrix(const CompactMCMgraph &g,
+                             std::shared_ptr<std::vector<int>> *ij,
+                             std::shared_ptr<std::vector<CDouble>> *A);
+
+/**
+ * maximumCycleMeanHoward ()
+ * Howard Policy Iteration Algorithm on a compact graph.
+ *
+ * INPUT CompactMCMgraph which must have outgoing edges from every node
+ *
+ * OUTPUT: the maximum cycle mean and, if criticalNode is not nullptr, a node
+ * on a cycle with the maximum cycle mean.
+ */
+CDouble maximumCycleMeanHoward(const CompactMCMgraph &g, const MCMnode **criticalNode);
+
+/**
+ * convertMCMgraphToMatrix ()
+ * The function converts a compact graph to the sparse matrix of a HowardState,
+ * with the edges in the order of the compact graph. The results in the state
+ * are kept if the topology is the same as that of the matrix already in the
+ * state.
+ */
+void convertMCMgraphToMatrix(const CompactMCMgraph &g, HowardState &state);
+
+/**
+ * policyCycle ()
+ * The cycle of a policy computed by Howard's algorithm on a compact graph that
+ * is reached from node start, as a list of edge indices in traversal order.
+ * Of parallel edges, the one with the largest weight in w is taken.
+ */
+std::vector<unsigned int> policyCycle(const CompactMCMgraph &g,
+                                      const std::vector<CDouble> &w,
+                                      const std::vector<int> &policy,
+                                      unsigned int start);
+
+/**
+ * maximumCycleRatioHoward ()
+ * Howard Policy Iteration Algorithm for the maximum cycle ratio of edge weight
+ * over delay of the visible part of a graph. The delays must be non-negative.
+ * The graph need not be strongly connected; if it has no cycle, -INFINITY is
+ * returned.
+ *
+ * A cycle without delay is a deadlock with an infinite ratio: then +INFINITY is
+ * returned and that cycle is the critical cycle.
+ *
+ * The critical cycle is only returned if cycle is not nullptr, as a list of
+ * edges in traversal order.
+ */
+CDouble maximumCycleRatioHoward(const CompactMCMgraph &g,
+                                std::vector<const MCMedge *> *cycle = nullptr);
+CDouble maximumCycleRatioHoward(MCMgraph &g, std::vector<const MCMedge *> *cycle = nullptr);
+
+/**
+ * minimumCycleRatioHoward ()
+ * Howard Policy Iteration Algorithm for the minimum cycle ratio of edge weight
+ * over delay, as maximumCycleRatioHoward () above. If the graph has no cycle,
+ * +INFINITY is returned. A graph with a cycle without delay has no meaningful
+ * minimum cycle ratio and is reported as deadlocked with an MPException.
  */
-CDouble maximumCycleMeanHowardGeneral(MCMgraph &g, MCMnode **criticalNode);
+CDouble minimumCycleRatioHoward(const CompactMCMgraph &g,
+                                std::vector<const MCMedge *> *cycle = nullptr);
+CDouble minimumCycleRatioHoward(MCMgraph &g, std::vector<const MCMedge *> *cycle = nullptr);
 
 } // namespace Graphs
 #endif
\ No newline at end of file
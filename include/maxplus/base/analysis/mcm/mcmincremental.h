@@ -0,0 +1,120 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmincremental.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Maintain the MCM of a growing graph.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMINCREMENTAL_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMINCREMENTAL_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * IncrementalMCM
+ * Maintains the maximum cycle mean mu of the visible part of an MCMgraph while
+ * edges are added and edge weights are increased, which can only increase mu.
+ *
+ * Next to mu, every node has a potential x such that x(src) >= w - mu + x(dst)
+ * for every edge. An update that violates this for its edge raises the
+ * potentials of the nodes that reach the source of the edge, largest raise
+ * first as in Dijkstra's algorithm. A raise stops where the slack of the edges
+ * absorbs it, so the work stays local to the affected part of the graph. If a
+ * raise gets back to the destination of the edge, the edge closes a cycle with
+ * a mean larger than mu. Only then are mu and the potentials recomputed with
+ * Howard's algorithm. Potentials are kept feasible up to a tolerance relative
+ * to the range of the weights, as in Howard's algorithm.
+ *
+ * While the structure is in use, the graph must only be changed through it.
+ */
+class IncrementalMCM {
+public:
+    // Compute the MCM of the visible part of g and maintain it from then on
+    explicit IncrementalMCM(MCMgraph &g);
+
+    // Add a node to the graph
+    MCMnode *addNode(CId id);
+
+    // Add an edge to the graph and update the MCM
+    MCMedge *addEdge(CId id, MCMnode &src, MCMnode &dst, CDouble w, CDouble d = 0.0);
+
+    // Increase the weight of edge e of the graph to w and update the MCM; a
+    // weight decrease is not supported and throws an MPException
+    void increaseWeight(MCMedge &e, CDouble w);
+
+    // The maximum cycle mean, -INFINITY if the graph has no cycle
+    [[nodiscard]] CDouble mcm() const { return this->mu; }
+
+    // The number of times the MCM was computed from scratch, including the first
+    [[nodiscard]] unsigned int nrRecomputations() const { return this->recomputations; }
+
+private:
+    // Compute mu and feasible potentials from scratch
+    void recompute();
+
+    // Restore the potentials after edge e was added or became heavier
+    void repair(const MCMedge &e);
+
+    // Whether edge e closes a cycle, by a search from its destination
+    bool closesCycle(const MCMedge &e);
+
+    // Include the weight w in the tolerance
+    void addWeight(CDouble w);
+
+    // The dense number of node n, which gets potential 0 if it is new
+    unsigned int indexOf(const MCMnode *n);
+
+    MCMgraph &g;
+    CDouble mu = -INFINITY;
+    CDouble minWeight = INFINITY;
+    CDouble maxWeight = -INFINITY;
+    CDouble epsilon = 0.0;
+    unsigned int recomputations = 0;
+
+    std::unordered_map<const MCMnode *, unsigned int> index;
+    std::vector<CDouble> x;
+
+    // scratch space of repair and closesCycle, kept between updates
+    std::vector<CDouble> raise;
+    std::vector<bool> done;
+    std::vector<unsigned int> touched;
+};
+
+} // namespace Graphs
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmio.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Read and write graphs for the MCM algorithms.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMIO_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMIO_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
+#include "maxplus/base/analysis/mcm/mcmgraph.h"
+#include <iosfwd>
+#include <string>
+
+namespace Graphs {
+
+/**
+ * readCompactMCMgraph ()
+ * Reads a graph in a DIMACS-like text format from in, one item per line:
+ *  c <text>            a comment
+ *  p <name> <n> <m>    the number of nodes and edges, optional, at most once and
+ *                      before the edges
+ *  a <u> <v> <w> [<d>] an edge from node u to node v with weight w and delay d,
+ *                      which is 0 if left out
+ * Nodes are numbered from 1, as in DIMACS files, and become nodes 0 .. n - 1 of
+ * the result. Without a p line, n is the largest node number that occurs. The
+ * input is parsed in fixed size chunks; the result has no original graph, see
+ * CompactMCMgraph::fromEdges. Throws an MPException on malformed input.
+ */
+CompactMCMgraph readCompactMCMgraph(std::istream &in);
+
+/**
+ * writeCompactMCMgraph ()
+ * Writes g to out in the format read by readCompactMCMgraph. Weights and delays
+ * are written in the shortest form that reads back to the same double.
+ */
+void writeCompactMCMgraph(std::ostream &out, const CompactMCMgraph &g);
+
+/**
+ * saveBinaryMCMgraph ()
+ * Writes g to the file fileName in a binary format: the 8 characters MPMCMG01,
+ * the numbers of nodes n and edges m as 64 bit integers, followed by the arrays
+ * of the m sources and the m destinations as 32 bit integers and the m weights
+ * and the m delays as doubles. Nodes are numbered from 0. All numbers are in
+ * the byte order of the machine.
+ */
+void saveBinaryMCMgraph(const std::string &fileName, const CompactMCMgraph &g);
+
+/**
+ * loadBinaryMCMgraph ()
+ * Reads a graph written by saveBinaryMCMgraph. The file is mapped into memory
+ * and the arrays are copied into the result in one pass; the result has no
+ * original graph, see CompactMCMgraph::fromEdges. Throws an MPException if the
+ * file cannot be read or is not in the binary format.
+ */
+CompactMCMgraph loadBinaryMCMgraph(const std::string &fileName);
+
+/**
+ * materializeMCMgraph ()
+ * An MCMgraph with the nodes and edges of g, node v with id v and edge e with
+ * id e. Together with the readers above this loads an MCMgraph from a file.
+ */
+MCMgraph materializeMCMgraph(const CompactMCMgraph &g);
+
+} // namespace Graphs
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmpaths.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Longest paths in MCM graphs.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMPATHS_H_INCLUDED
+#define MAXPLUS_BASE_ANALYSIS_MCM_MCMPATHS_H_INCLUDED
+
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
+#include <vector>
+
+namespace Graphs {
+
+/**
+ * longestPaths ()
+ * The lengths of the longest paths in g from node root to every node, indexed
+ * by node. Nodes that cannot be reached from root get -INFINITY. Uses the queue
+ * based Bellman-Ford algorithm (SPFA), which only rescans the edges of nodes
+ * whose length changed. Throws an MPException if a cycle of positive length can
+ * be reached from root.
+ */
+std::vector<CDouble> longestPaths(const CompactMCMgraph &g, unsigned int root);
+
+/**
+ * normalizedLongestPaths ()
+ * As longestPaths, with the weight of every edge e taken as w(e) - mu * d(e).
+ * The normalized weights are computed on the fly; no graph is built. For mu at
+ * least the maximum cycle ratio of g no cycle has a positive length.
+ */
+std::vector<CDouble>
+normalizedLongestPaths(const CompactMCMgraph &g, unsigned int root, CDouble mu);
+
+/**
+ * normalizedLongestPaths ()
+ * As above, with a value mu[v] for every node v: the weight of edge e is taken
+ * as w(e) - mu[src(e)] * d(e). The weights of the edges leaving a node v with an
+ * infinite mu[v] are not normalized.
+ */
+std::vector<CDouble> normalizedLongestPaths(const CompactMCMgraph &g,
+                                            unsigned int root,
+                                            const std::vector<CDouble> &mu);
+
+} // namespace Graphs
+
+#endif
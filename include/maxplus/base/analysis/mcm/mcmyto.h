@@ -48,6 +48,7 @@
 #ifndef MAXPLUS_BASE_ANALYSIS_MCM_MCMYTO_H_INCLUDED
 #define MAXPLUS_BASE_ANALYSIS_MCM_MCMYTO_H_INCLUDED
 
+#include "maxplus/base/analysis/mcm/mcmcompact.h"
 #include "maxplus/base/analysis/mcm/mcmgraph.h"
 #include <cstdint>
 #include <memory>
@@ -99,6 +100,33 @@ using graph = struct Graph {
     node *vs; // additional node with zero cost outgoing edges
 };
 
+/**
+ * YTOHeap
+ * Heap in which Young-Tarjan-Orlin's algorithm keeps the vertex keys. The
+ * d-ary heaps are cheap to insert into; the pairing heap removes arcs in
+ * amortized logarithmic time, which pays off when the algorithm moves large
+ * subtrees. All heaps lead to the same cycle mean or ratio. Keys are compared
+ * with a tolerance, so among keys that tie the heaps may pop different vertices
+ * and return different, equally good critical cycles.
+ */
+enum class YTOHeap { BinaryHeap, FourAryHeap, EightAryHeap, PairingHeap };
+
+/**
+ * YTOWorkspace
+ * Storage for Young-Tarjan-Orlin's algorithm that can be kept between runs.
+ * The nodes, arcs and heap keep their capacity, so that repeated runs on
+ * graphs of similar size do not allocate memory.
+ */
+struct YTOWorkspace {
+    YTOHeap heap = YTOHeap::FourAryHeap;
+
+    graph gr;
+    std::vector<arc *> heapItems;
+    std::vector<std::int32_t> heapLinks;
+    std::vector<std::int32_t> heapScratch;
+    std::vector<const arc *> cycle;
+};
+
 /**
  * mcmYoungTarjanOrlin ()
  * The function computes the maximum cycle mean of edge weight per edge of
@@ -176,6 +204,46 @@ void convertMCMgraphToYTOgraph(MCMgraph &g,
                                CDouble (*costFunction)(const MCMedge &e),
                                CDouble (*transit_timeFunction)(const MCMedge &e));
 
+/**
+ * convertMCMgraphToYTOgraph ()
+ * The function converts a compact graph to graph input for Young-Tarjan-Orlin's
+ * algorithm. The arrays cost and transit_time are indexed by edge; a nullptr
+ * stands for a unit cost or transit time on every edge.
+ */
+void convertMCMgraphToYTOgraph(const CompactMCMgraph &g,
+                               graph &gr,
+                               const std::vector<CDouble> *cost,
+                               const std::vector<CDouble> *transit_time);
+
+/**
+ * Young-Tarjan-Orlin's algorithm on a compact graph. The functions behave as
+ * their MCMgraph counterparts above, but they take only the visible part of the
+ * graph into account and make no assumptions on the node ids. The maximum cycle
+ * mean also allows weights that are zero or negative.
+ */
+CDouble maxCycleMeanYoungTarjanOrlin(const CompactMCMgraph &g);
+CDouble maxCycleMeanAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                     std::vector<const MCMedge *> *cycle);
+CDouble maxCycleRatioYoungTarjanOrlin(const CompactMCMgraph &g);
+CDouble maxCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle);
+CDouble minCycleRatioYoungTarjanOrlin(const CompactMCMgraph &g);
+CDouble minCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle);
+
+/**
+ * As above, reusing the storage and using the heap of the workspace ws.
+ */
+CDouble maxCycleMeanAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                     std::vector<const MCMedge *> *cycle,
+                                                     YTOWorkspace &ws);
+CDouble maxCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle,
+                                                      YTOWorkspace &ws);
+CDouble minCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle,
+                                                      YTOWorkspace &ws);
+
 /**
  * mmcycle ()
  *
@@ -52,7 +52,8 @@ namespace MaxPlus {
 class CFraction {
 public:
     // Constructor
-    explicit CFraction(const int num = 0, const int den = 1) : num(num), den(den) {
+    explicit CFraction(const std::int64_t num = 0, const std::int64_t den = 1) :
+        num(num), den(den) {
         if (den != 0) {
             this->val = static_cast<CDouble>(num) / static_cast<CDouble>(den);
         } else {
@@ -62,7 +63,7 @@ public:
 
     CFraction(const CFraction &f) = default;
 
-    explicit CFraction(const CDouble v) : num(0), den(0), val(0.0) {
+    explicit CFraction(const CDouble v) : val(0.0), num(0), den(0) {
         CDoubleToFraction(v, INFINITY);
     };
 
@@ -0,0 +1,88 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   alignedallocator.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Allocator for over-aligned storage
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_MEMORY_ALIGNEDALLOCATOR_H_INCLUDED
+#define MAXPLUS_BASE_MEMORY_ALIGNEDALLOCATOR_H_INCLUDED
+
+#include <cstddef>
+#include <new>
+
+namespace MaxPlus {
+
+// alignment of a cache line and of the widest vector registers (AVX-512)
+constexpr std::size_t CACHE_LINE_ALIGNMENT = 64;
+
+/**
+ * AlignedAllocator
+ * Standard allocator that places all storage on an \p Alignment byte boundary, so that
+ * containers using it can be processed with aligned vector loads and never straddle
+ * cache lines at their start.
+ */
+template <class T, std::size_t Alignment = CACHE_LINE_ALIGNMENT> class AlignedAllocator {
+public:
+    static_assert(Alignment >= alignof(T), "Alignment must be at least that of the type");
+
+    using value_type = T;
+
+    template <class U> struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <class U> explicit AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T *p, std::size_t /*n*/) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <class U> bool operator==(const AlignedAllocator<U, Alignment> &) const noexcept {
+        return true;
+    }
+
+    template <class U> bool operator!=(const AlignedAllocator<U, Alignment> &) const noexcept {
+        return false;
+    }
+};
+
+} // namespace MaxPlus
+
+#endif
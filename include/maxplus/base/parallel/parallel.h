@@ -0,0 +1,100 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   parallel.h
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Simple thread parallelism for the analysis algorithms
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#ifndef MAXPLUS_BASE_PARALLEL_PARALLEL_H_INCLUDED
+#define MAXPLUS_BASE_PARALLEL_PARALLEL_H_INCLUDED
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+namespace MaxPlus {
+
+/**
+ * defaultThreadCount ()
+ * Number of threads used when a thread count of 0 is requested, i.e. the number of hardware
+ * threads, or 1 if that cannot be determined.
+ */
+unsigned int defaultThreadCount();
+
+/**
+ * parallelFor ()
+ * Calls body(i) for every i in [begin, end), using up to nrThreads threads (0 for
+ * defaultThreadCount()). Indices are handed out one at a time, so tasks of unequal size are
+ * balanced. The calling thread takes part in the work. If a call of body throws, the
+ * remaining indices are skipped and the first exception is rethrown after all threads
+ * have finished.
+ */
+void parallelFor(std::size_t begin,
+                 std::size_t end,
+                 const std::function<void(std::size_t)> &body,
+                 unsigned int nrThreads = 0);
+
+/**
+ * parallelRun ()
+ * Calls body(t, nrThreads) once for every t in [0, nrThreads), each on its own thread (0 for
+ * defaultThreadCount() threads); the calling thread runs t = 0. Intended for phased algorithms
+ * that keep their threads for the whole computation and synchronize them with a Barrier.
+ * The first exception thrown by a call of body is rethrown after all threads have finished.
+ * A body that throws must not leave the other threads waiting at a barrier.
+ */
+void parallelRun(const std::function<void(unsigned int, unsigned int)> &body,
+                 unsigned int nrThreads = 0);
+
+/**
+ * Barrier
+ * A reusable barrier for a fixed number of threads.
+ */
+class Barrier {
+public:
+    explicit Barrier(unsigned int count) : count(count) {}
+
+    // Block until all threads have arrived.
+    void arriveAndWait();
+
+private:
+    std::mutex mutex;
+    std::condition_variable allArrived;
+    const unsigned int count;
+    unsigned int waiting = 0;
+    unsigned int generation = 0;
+};
+
+} // namespace MaxPlus
+
+#endif
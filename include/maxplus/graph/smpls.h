@@ -43,6 +43,7 @@
 #define MAXPLUS_GRAPH_SMPLS_H
 
 #include "maxplus/algebra/mpmatrix.h"
+#include "maxplus/algebra/mpregistry.h"
 #include "maxplus/base/fsm/fsm.h"
 #include "maxplus/base/fsm/iofsm.h"
 #include "maxplus/graph/mpautomaton.h"
@@ -70,10 +71,16 @@ public:
     // the mode matrices
     ModeMatrices mm;
 
+    // the distinct mode matrices, with memoized analysis results
+    MatrixRegistry registry;
+
     [[nodiscard]] std::shared_ptr<MaxPlusAutomaton> convertToMaxPlusAutomaton() const;
 
-    // transposes all matrices of the SMPLS
+    // transposes all matrices of the SMPLS, modes sharing a matrix keep sharing its transpose
     void transposeMatrices();
+
+    // lets all modes with equal matrices share a single instance from the registry
+    void shareModeMatrices();
 };
 
 using ListOfMatrices = std::list<std::shared_ptr<Matrix>>;
@@ -0,0 +1,178 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpbatch.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Batches of equally sized MaxPlus matrices
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "algebra/mpbatch.h"
+#include "algebra/mpvectorkernels.h"
+#include "base/exception/exception.h"
+#include "base/parallel/parallel.h"
+#include <algorithm>
+#include <cfloat>
+
+namespace MaxPlus {
+
+namespace {
+
+// the Karp tables of a chunk, (N + 1) * N * chunk doubles, should stay within this size
+constexpr std::size_t KARP_CHUNK_BUDGET = 64 * 1024;
+constexpr unsigned int MIN_CHUNK = 8;
+constexpr unsigned int MAX_CHUNK = 256;
+
+unsigned int chunkSize(unsigned int N) {
+    std::size_t c = KARP_CHUNK_BUDGET / (static_cast<std::size_t>(N + 1) * N);
+    c = std::min<std::size_t>(std::max<std::size_t>(c, MIN_CHUNK), MAX_CHUNK);
+    return static_cast<unsigned int>(c - c % MIN_CHUNK);
+}
+
+/**
+ * Karp's algorithm on the complete precedence graphs of matrices m0 .. m0 + C - 1, exactly
+ * as maximumCycleMeanKarpDouble computes it for the graph built by Matrix::mp_eigenvalue,
+ * but with every step applied to all C matrices at once.
+ */
+void karpChunk(const CDouble *A,
+               std::size_t K,
+               unsigned int N,
+               std::size_t m0,
+               std::size_t C,
+               CDouble *result) {
+    std::vector<CDouble, AlignedAllocator<CDouble>> d((N + 1) * static_cast<std::size_t>(N) * C);
+    auto D = [&](unsigned int k, unsigned int v) {
+        return d.data() + (static_cast<std::size_t>(k) * N + v) * C;
+    };
+
+    std::fill(D(0, 0), D(1, 0), 0.0);
+    std::fill(D(1, 0), d.data() + d.size(), -DBL_MAX);
+    for (unsigned int k = 1; k < N + 1; k++) {
+        for (unsigned int v = 0; v < N; v++) {
+            // the edge from u to v carries the weight of entry (v, u)
+            const CDouble *row = A + static_cast<std::size_t>(v) * N * K + m0;
+            for (unsigned int u = 0; u < N; u++) {
+                VectorKernels::maxOfSums(D(k - 1, u), row + u * K, D(k, v), C);
+            }
+        }
+    }
+
+    std::vector<CDouble, AlignedAllocator<CDouble>> l(C, -DBL_MAX);
+    std::vector<CDouble, AlignedAllocator<CDouble>> ld(C);
+    for (unsigned int v = 0; v < N; v++) {
+        std::fill(ld.begin(), ld.end(), DBL_MAX);
+        for (unsigned int k = 0; k < N; k++) {
+            VectorKernels::minOfQuotients(
+                    D(N, v), D(k, v), static_cast<CDouble>(N - k), ld.data(), C);
+        }
+        VectorKernels::maximum(ld.data(), l.data(), l.data(), C);
+    }
+    std::copy(l.begin(), l.end(), result + m0);
+}
+
+} // namespace
+
+MatrixBatch::MatrixBatch(unsigned int nrMatrices, unsigned int size, MPTime value) :
+    nrMatrices(nrMatrices),
+    size(size),
+    table(static_cast<std::size_t>(nrMatrices) * size * size, static_cast<CDouble>(value)) {}
+
+MatrixBatch::MatrixBatch(unsigned int nrMatrices, unsigned int size, const CDouble *packed) :
+    MatrixBatch(nrMatrices, size) {
+    std::size_t N2 = static_cast<std::size_t>(size) * size;
+    for (std::size_t m = 0; m < nrMatrices; m++) {
+        for (std::size_t e = 0; e < N2; e++) {
+            this->table[e * nrMatrices + m] = packed[m * N2 + e];
+        }
+    }
+}
+
+std::size_t MatrixBatch::index(unsigned int matrix, unsigned int row, unsigned int column) const {
+    if (matrix >= this->nrMatrices || row >= this->size || column >= this->size) {
+        throw MPException("Index out of bounds in MatrixBatch");
+    }
+    return (static_cast<std::size_t>(row) * this->size + column) * this->nrMatrices + matrix;
+}
+
+MPTime MatrixBatch::get(unsigned int matrix, unsigned int row, unsigned int column) const {
+    return MPTime(this->table[this->index(matrix, row, column)]);
+}
+
+void MatrixBatch::put(unsigned int matrix, unsigned int row, unsigned int column, MPTime value) {
+    this->table[this->index(matrix, row, column)] = static_cast<CDouble>(value);
+}
+
+void MatrixBatch::putMatrix(unsigned int matrix, const Matrix &M) {
+    if (M.getRows() != this->size || M.getCols() != this->size) {
+        throw MPException("Matrix of wrong size in MatrixBatch::putMatrix");
+    }
+    for (unsigned int i = 0; i < this->size; i++) {
+        for (unsigned int j = 0; j < this->size; j++) {
+            this->put(matrix, i, j, M.get(i, j));
+        }
+    }
+}
+
+Matrix MatrixBatch::getMatrix(unsigned int matrix) const {
+    Matrix M(this->size, this->size);
+    for (unsigned int i = 0; i < this->size; i++) {
+        for (unsigned int j = 0; j < this->size; j++) {
+            M.put(i, j, this->get(matrix, i, j));
+        }
+    }
+    return M;
+}
+
+std::vector<CDouble> MatrixBatch::mpEigenvalues(unsigned int nrThreads) const {
+    std::vector<CDouble> result(this->nrMatrices, -DBL_MAX);
+    if (this->nrMatrices == 0 || this->size == 0) {
+        return result;
+    }
+    std::size_t C = chunkSize(this->size);
+    std::size_t nrChunks = (this->nrMatrices + C - 1) / C;
+    parallelFor(
+            0,
+            nrChunks,
+            [&](std::size_t c) {
+                std::size_t m0 = c * C;
+                std::size_t len = std::min<std::size_t>(C, this->nrMatrices - m0);
+                karpChunk(this->table.data(),
+                          this->nrMatrices,
+                          this->size,
+                          m0,
+                          len,
+                          result.data());
+            },
+            nrThreads);
+    return result;
+}
+
+} // namespace MaxPlus
@@ -40,12 +40,15 @@
 
 #include "algebra/mpmatrix.h"
 #include "algebra/mptype.h"
+#include "algebra/mpvectorkernels.h"
 #include "base/analysis/mcm/mcmgraph.h"
+#include "base/analysis/mcm/mcmpaths.h"
 #include "base/analysis/mcm/mcmyto.h"
 #include "base/exception/exception.h"
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <type_traits>
 
 using namespace Graphs;
 
@@ -53,6 +56,10 @@ constexpr double DEFAULT_SCALE = 1.0e-06;
 
 namespace MaxPlus {
 
+// the vector kernels operate on the underlying doubles of the MPTime entries
+static_assert(sizeof(MPTime) == sizeof(CDouble), "MPTime must be a plain double");
+static_assert(std::is_standard_layout<MPTime>::value, "MPTime must be a plain double");
+
 /**
  * Construct a max-plus vector of size
  */
@@ -100,28 +107,31 @@ Vector &Vector::operator=(const Vector &other) {
     return *this;
 }
 
+/**
+ * raw access to the entries for the vector kernels
+ */
+CDouble *Vector::data() { return reinterpret_cast<CDouble *>(this->table.data()); }
+
+const CDouble *Vector::data() const {
+    return reinterpret_cast<const CDouble *>(this->table.data());
+}
+
 /**
  * vector negate
  */
 void Vector::negate() {
-    for (unsigned int row = 0; row < this->getSize(); row++) {
-        if (this->get(row) == MP_MINUS_INFINITY) {
-            throw MPException("Cannot negate vectors with MP_MINUS_INFINITY elements in"
-                              "Vector::negate");
-        }
-        this->put(row, -this->get(row));
+    if (VectorKernels::containsValue(this->data(), this->table.size(), MPTIME_MIN_INF_VAL)) {
+        throw MPException("Cannot negate vectors with MP_MINUS_INFINITY elements in"
+                          "Vector::negate");
     }
+    VectorKernels::negate(this->data(), this->table.size());
 }
 
 /**
  * calculate vector norm
  */
 MPTime Vector::norm() const {
-    MPTime maxEl = MP_MINUS_INFINITY;
-    for (unsigned int row = 0; row < this->getSize(); row++) {
-        maxEl = MP_MAX(maxEl, this->get(row));
-    }
-    return maxEl;
+    return MPTime(VectorKernels::maxElement(this->data(), this->table.size()));
 }
 
 /**
@@ -134,11 +144,25 @@ MPTime Vector::normalize() {
         throw MPException("Cannot normalize vector with norm MP_MINUS_INFINITY"
                           "Vector::normalize");
     }
-    for (unsigned int row = 0; row < this->getSize(); row++) {
-        MPTime x_i = this->get(row); // MPTime handles -INF correctly
-        x_i = x_i - maxEl;           // overloaded using MP_PLUS
-        this->put(row, x_i);
+    // x_i - maxEl, with -INF entries remaining -INF
+    VectorKernels::addScalar(
+            this->data(), -static_cast<CDouble>(maxEl), this->data(), this->table.size());
+
+    return maxEl;
+}
+
+/**
+ * normalize vector and hash the normalized entries
+ */
+MPTime Vector::normalizeAndHash(std::uint64_t &hash) {
+    MPTime maxEl = this->norm();
+
+    if (maxEl == MP_MINUS_INFINITY) {
+        throw MPException("Cannot normalize vector with norm MP_MINUS_INFINITY"
+                          "Vector::normalizeAndHash");
     }
+    hash = VectorKernels::addScalarAndHash(
+            this->data(), -static_cast<CDouble>(maxEl), this->data(), this->table.size());
 
     return maxEl;
 }
@@ -160,9 +184,7 @@ void Vector::add(MPTime increase, Vector &result) const {
     unsigned int M = this->getSize();
     assert(result.getSize() == M);
 
-    for (unsigned int pos = 0; pos < M; pos++) {
-        result.put(pos, this->get(pos) + increase); // uses MP_PLUS()
-    }
+    VectorKernels::addScalar(this->data(), static_cast<CDouble>(increase), result.data(), M);
 }
 
 /**
@@ -173,9 +195,7 @@ void Vector::maximum(const Vector &vecB, Vector &result) const {
     assert(vecB.getSize() == M);
     assert(result.getSize() == M);
 
-    for (unsigned int pos = 0; pos < M; pos++) {
-        result.put(pos, MP_MAX(this->get(pos), vecB.get(pos)));
-    }
+    VectorKernels::maximum(this->data(), vecB.data(), result.data(), M);
 }
 
 /**
@@ -210,9 +230,7 @@ void Vector::toString(MPString &outString, CDouble scale) const {
 void Vector::add(const Vector &vecB, Vector &res) const {
     assert(this->getSize() == vecB.getSize());
     assert(this->getSize() == res.getSize());
-    for (unsigned int row = 0; row < this->getSize(); row++) {
-        res.put(row, this->get(row) + vecB.get(row));
-    }
+    VectorKernels::add(this->data(), vecB.data(), res.data(), this->getSize());
 }
 
 /**
@@ -242,20 +260,12 @@ MPTime Vector::minimalFiniteElement(unsigned int *itsPosition_Ptr) const {
     }
     *itsPosition = this->getSize() + 1; // arbitrary value, invalid
 
-    MPTime minEl = MP_MINUS_INFINITY;
-    bool minEl_initialized = false;
-    for (unsigned int row = 0; row < this->getSize(); row++) {
-        MPTime val = this->get(row);
-        if (val.isMinusInfinity()) {
-            continue;
-        }
-        if (!minEl_initialized || (val < minEl)) {
-            minEl = val;
-            minEl_initialized = true;
-            *itsPosition = row;
-        }
+    CDouble minEl = MPTIME_MIN_INF_VAL;
+    std::size_t position = 0;
+    if (VectorKernels::minFiniteElement(this->data(), this->table.size(), minEl, position)) {
+        *itsPosition = static_cast<unsigned int>(position);
     }
-    return minEl;
+    return MPTime(minEl);
 }
 
 /**
@@ -265,13 +275,9 @@ bool Vector::compare(const Vector &v) const {
     if (this->getSize() != v.getSize()) {
         return false;
     }
-    for (unsigned int k = 0; k < this->getSize(); k++) {
-        if (fabs(static_cast<CDouble>(this->get(k) - v.get(k)))
-            > static_cast<CDouble>(MP_EPSILON)) {
-            return false;
-        }
-    }
-    return true;
+    // entries at minus infinity never compare as equal, as with MP_PLUS based differences
+    return VectorKernels::finiteAndClose(
+            this->data(), v.data(), this->table.size(), static_cast<CDouble>(MP_EPSILON));
 }
 
 Matrix::Matrix(unsigned int nr_rows, unsigned int nr_cols, MatrixFill fill) :
@@ -502,6 +508,80 @@ Matrix Matrix::mp_multiply(const Matrix &m) const {
     return res;
 }
 
+/**
+ * residuate()
+ * Greatest solution of A (x) x <= b. The matrix is streamed row by row, each row updating
+ * all entries of x.
+ */
+Vector Matrix::residuate(const Vector &b) const {
+    if (this->getRows() != b.getSize()) {
+        throw MPException("Matrix and vector are of unequal size in "
+                          "Matrix::residuate");
+    }
+
+    unsigned int NC = this->getCols();
+    Vector x(NC, MP_PLUS_INFINITY);
+    const auto *a = reinterpret_cast<const CDouble *>(this->table.data());
+    for (unsigned int i = 0; i < this->getRows(); i++) {
+        VectorKernels::minOfScalarMinus(a + static_cast<std::size_t>(i) * NC,
+                                        static_cast<CDouble>(b.get(i)),
+                                        x.data(),
+                                        NC);
+    }
+    return x;
+}
+
+/**
+ * residuate()
+ * Greatest solution of A (x) X <= B. For every finite a_ij, row i of B minus a_ij bounds
+ * row j of X.
+ */
+Matrix Matrix::residuate(const Matrix &B) const {
+    if (this->getRows() != B.getRows()) {
+        throw MPException("Matrices are of incompatible size in"
+                          "Matrix::residuate(Matrix)");
+    }
+
+    unsigned int NC = this->getCols();
+    unsigned int P = B.getCols();
+    Matrix X(NC, P);
+    std::fill(X.table.begin(), X.table.end(), MP_PLUS_INFINITY);
+    const auto *b = reinterpret_cast<const CDouble *>(B.table.data());
+    auto *x = reinterpret_cast<CDouble *>(X.table.data());
+    for (unsigned int i = 0; i < this->getRows(); i++) {
+        for (unsigned int j = 0; j < NC; j++) {
+            MPTime a_ij = this->get(i, j);
+            if (!a_ij.isMinusInfinity()) {
+                VectorKernels::minOfMinusScalar(b + static_cast<std::size_t>(i) * P,
+                                                static_cast<CDouble>(a_ij),
+                                                x + static_cast<std::size_t>(j) * P,
+                                                P);
+            }
+        }
+    }
+    return X;
+}
+
+/**
+ * isSolvable()
+ * A (x) x = b is solvable iff the greatest subsolution is a solution.
+ */
+bool Matrix::isSolvable(const Vector &b) const {
+    Vector y = this->mp_multiply(this->residuate(b));
+    for (unsigned int i = 0; i < b.getSize(); i++) {
+        CDouble bi = static_cast<CDouble>(b.get(i));
+        CDouble yi = static_cast<CDouble>(y.get(i));
+        if (MP_IS_MINUS_INFINITY(bi) || MP_IS_MINUS_INFINITY(yi)) {
+            if (MP_IS_MINUS_INFINITY(bi) != MP_IS_MINUS_INFINITY(yi)) {
+                return false;
+            }
+        } else if (fabs(bi - yi) > static_cast<CDouble>(MP_EPSILON) * (1.0 + fabs(bi))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * mp_sub()
  * Matrix-matrix subtraction.
@@ -825,6 +905,25 @@ void Matrix::toLaTeXString(MPString &outString, CDouble scale) const {
     outString += "\\end{bmatrix}\n";
 }
 
+/**
+ * Matrix equality
+ */
+bool Matrix::operator==(const Matrix &other) const {
+    return this->szRows == other.szRows && this->szCols == other.szCols
+           && this->table == other.table;
+}
+
+/**
+ * Matrix hash
+ */
+std::uint64_t Matrix::hash() const {
+    std::uint64_t h = VectorKernels::hash(reinterpret_cast<const CDouble *>(this->table.data()),
+                                          this->table.size());
+    // mix in the shape, so that e.g. 2x3 and 3x2 matrices with the same entries differ
+    std::uint64_t shape = (static_cast<std::uint64_t>(this->szRows) << 32U) + this->szCols;
+    return (h ^ shape) * 0x9e3779b97f4a7c15ULL;
+}
+
 /**
  * Matrix return largest element.
  */
@@ -1064,10 +1163,10 @@ CDouble Matrix::mp_eigenvalue() const {
     }
 
     // prune the graph
-    std::shared_ptr<MCMgraph> pruned = mcmGraph->pruneEdges();
+    mcmGraph->pruneEdgesInPlace();
 
     // compute MCM
-    CDouble res = pruned->calculateMaximumCycleMeanKarpDouble();
+    CDouble res = mcmGraph->calculateMaximumCycleMeanKarpDouble();
     return res;
 }
 
@@ -1197,6 +1296,9 @@ Matrix::mp_generalized_eigenvectors() const {
         }
     }
 
+    // the longest paths are computed on a compact form of the precedence graph
+    const CompactMCMgraph compactPrecGraph(precGraph);
+
     // compute the eigenvectors
     Matrix::EigenvectorList eigenVectors;
     Matrix::GeneralizedEigenvectorList genEigenVectors;
@@ -1227,25 +1329,24 @@ Matrix::mp_generalized_eigenvectors() const {
                 }
             }
 
-            // compute normalization map replace MP_MINUS_INFINITY by -DBL_MAX
-            std::map<CId, CDouble> muMap;
+            // compute normalization, replace MP_MINUS_INFINITY by -INFINITY
+            std::vector<CDouble> mu(trCycleMeans.size());
             for (unsigned int n = 0; n < trCycleMeans.size(); n++) {
-                muMap[n] = (MPTime(trCycleMeans[n]).isMinusInfinity())
-                                   ? -DBL_MAX
-                                   : static_cast<CDouble>(trCycleMeans[n]);
+                mu[n] = (MPTime(trCycleMeans[n]).isMinusInfinity())
+                                ? -INFINITY
+                                : static_cast<CDouble>(trCycleMeans[n]);
             }
 
-            // compute normalized longest paths
-            std::map<CId, CDouble> lengths =
-                    precGraph.normalizedLongestPaths(criticalNodes[k]->id, muMap);
+            // compute normalized longest paths, node n of the precedence graph
+            // is node n of its compact form
+            std::vector<CDouble> lengths =
+                    normalizedLongestPaths(compactPrecGraph, criticalNodes[k]->id, mu);
             // make an eigenvector
             Vector v(this->getCols());
-            for (auto length : lengths) {
-                CId n = length.first;
-                MPTime value =
-                        ((MPTime(length.second)) <= MP_MINUS_INFINITY ? MP_MINUS_INFINITY
-                                                                      : MPTime(length.second));
-                v.put(static_cast<unsigned int>(n), value);
+            for (unsigned int n = 0; n < lengths.size(); n++) {
+                MPTime value = ((MPTime(lengths[n])) <= MP_MINUS_INFINITY ? MP_MINUS_INFINITY
+                                                                           : MPTime(lengths[n]));
+                v.put(n, value);
             }
 
             // check if it is a generalized eigenvalue
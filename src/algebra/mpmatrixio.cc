@@ -0,0 +1,261 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpmatrixio.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Streaming text input and output of MaxPlus matrices
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "algebra/mpmatrixio.h"
+#include "base/exception/exception.h"
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace MaxPlus {
+
+namespace {
+
+// size of the chunks in which text is written and read
+constexpr std::size_t MATRIX_IO_CHUNK = 64 * 1024;
+
+// upper bound on the length of a single formatted entry
+constexpr std::size_t MATRIX_IO_MAX_ENTRY = 64;
+
+/**
+ * ChunkWriter
+ * Collects output in a fixed buffer and passes it to the stream when full.
+ */
+class ChunkWriter {
+public:
+    explicit ChunkWriter(std::ostream &out) : out(out) {}
+
+    ~ChunkWriter() = default;
+    ChunkWriter(const ChunkWriter &) = delete;
+    ChunkWriter &operator=(const ChunkWriter &) = delete;
+    ChunkWriter(ChunkWriter &&) = delete;
+    ChunkWriter &operator=(ChunkWriter &&) = delete;
+
+    void put(char c) {
+        reserve(1);
+        this->buffer[this->pos++] = c;
+    }
+
+    void put(const char *s) {
+        std::size_t len = std::strlen(s);
+        reserve(len);
+        std::memcpy(&this->buffer[this->pos], s, len);
+        this->pos += len;
+    }
+
+    void put(CDouble value) {
+        reserve(MATRIX_IO_MAX_ENTRY);
+        char *begin = &this->buffer[this->pos];
+        auto result = std::to_chars(begin, begin + MATRIX_IO_MAX_ENTRY, value);
+        this->pos += static_cast<std::size_t>(result.ptr - begin);
+    }
+
+    void flush() {
+        if (this->pos > 0) {
+            this->out.write(this->buffer.data(), static_cast<std::streamsize>(this->pos));
+            this->pos = 0;
+        }
+    }
+
+private:
+    void reserve(std::size_t len) {
+        if (this->pos + len > this->buffer.size()) {
+            flush();
+        }
+    }
+
+    std::ostream &out;
+    std::array<char, MATRIX_IO_CHUNK> buffer{};
+    std::size_t pos = 0;
+};
+
+void writeEntry(ChunkWriter &writer, MPTime value, MatrixTextFormat format) {
+    if (format == MatrixTextFormat::Plain) {
+        // like timeToString, only the pure minus infinity gets its symbolic name
+        if (static_cast<CDouble>(value) == MPTIME_MIN_INF_VAL) {
+            writer.put("-mp_inf");
+            return;
+        }
+    } else if (value.isMinusInfinity()) {
+        writer.put("-Inf");
+        return;
+    }
+    writer.put(static_cast<CDouble>(value));
+}
+
+bool isEntrySeparator(char c) { return c == ' ' || c == '\t' || c == ',' || c == '\r' || c == '['; }
+
+bool isRowSeparator(char c) { return c == '\n' || c == ';' || c == ']'; }
+
+/**
+ * ChunkParser
+ * Tokenizes the input and collects the entries of the matrix row by row.
+ */
+class ChunkParser {
+public:
+    void consume(const char *data, std::size_t len) {
+        for (std::size_t i = 0; i < len; i++) {
+            char c = data[i];
+            if (isEntrySeparator(c)) {
+                endToken();
+            } else if (isRowSeparator(c)) {
+                endToken();
+                endRow();
+            } else {
+                if (this->token.size() >= MATRIX_IO_MAX_ENTRY) {
+                    throw MPException("Matrix entry too long in readMatrix.");
+                }
+                this->token.push_back(c);
+            }
+        }
+    }
+
+    Matrix finish() {
+        endToken();
+        endRow();
+        Matrix M(this->nrRows, this->nrCols);
+        std::size_t k = 0;
+        for (unsigned int r = 0; r < this->nrRows; r++) {
+            for (unsigned int c = 0; c < this->nrCols; c++) {
+                M.put(r, c, MPTime(this->values[k++]));
+            }
+        }
+        return M;
+    }
+
+private:
+    void endToken() {
+        if (this->token.empty()) {
+            return;
+        }
+        this->values.push_back(parseEntry());
+        this->token.clear();
+        this->rowLength++;
+    }
+
+    void endRow() {
+        if (this->rowLength == 0) {
+            return;
+        }
+        if (this->nrRows == 0) {
+            this->nrCols = this->rowLength;
+        } else if (this->rowLength != this->nrCols) {
+            throw MPException("Rows of different length in readMatrix.");
+        }
+        this->nrRows++;
+        this->rowLength = 0;
+    }
+
+    CDouble parseEntry() const {
+        if (this->token == "-mp_inf") {
+            return MPTIME_MIN_INF_VAL;
+        }
+        const char *begin = this->token.data();
+        const char *end = begin + this->token.size();
+        CDouble value = 0.0;
+        auto result = std::from_chars(begin, end, value);
+        if (result.ec != std::errc() || result.ptr != end || std::isnan(value)) {
+            MPString message("Cannot parse matrix entry '");
+            message += MPString(this->token);
+            message += "' in readMatrix.";
+            throw MPException(message);
+        }
+        if (std::isinf(value)) {
+            if (value > 0.0) {
+                throw MPException("Plus infinity is not a max-plus value in readMatrix.");
+            }
+            return MPTIME_MIN_INF_VAL;
+        }
+        return value;
+    }
+
+    std::string token;
+    std::vector<CDouble> values;
+    unsigned int rowLength = 0;
+    unsigned int nrRows = 0;
+    unsigned int nrCols = 0;
+};
+
+} // namespace
+
+void writeMatrix(std::ostream &out, const Matrix &M, MatrixTextFormat format, CDouble scale) {
+    ChunkWriter writer(out);
+    const char separator = format == MatrixTextFormat::CSV ? ',' : ' ';
+    unsigned int MR = M.getRows();
+    unsigned int MC = M.getCols();
+    if (format == MatrixTextFormat::Matlab) {
+        writer.put("[\n");
+    }
+    for (unsigned int i = 0; i < MR; i++) {
+        for (unsigned int j = 0; j < MC; j++) {
+            if (j > 0) {
+                writer.put(separator);
+            }
+            MPTime value = M.get(i, j);
+            writeEntry(writer, scale == 1.0 ? value : value * scale, format);
+        }
+        if (format == MatrixTextFormat::Matlab && i + 1 < MR) {
+            writer.put(';');
+        }
+        writer.put('\n');
+    }
+    if (format == MatrixTextFormat::Matlab) {
+        writer.put("]\n");
+    }
+    writer.flush();
+}
+
+Matrix readMatrix(std::istream &in) {
+    ChunkParser parser;
+    std::vector<char> buffer(MATRIX_IO_CHUNK);
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        auto n = static_cast<std::size_t>(in.gcount());
+        if (n == 0) {
+            break;
+        }
+        parser.consume(buffer.data(), n);
+    }
+    return parser.finish();
+}
+
+} // namespace MaxPlus
@@ -0,0 +1,103 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpregistry.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Registry of unique MaxPlus matrices with memoized analysis results
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "algebra/mpregistry.h"
+
+namespace MaxPlus {
+
+/**
+ * Find the entry of a matrix equal to M, create one if it does not exist. The new entry
+ * shares *owner if it is given and holds a copy of M otherwise.
+ */
+MatrixRegistry::Entry &
+MatrixRegistry::find(const Matrix &M, std::uint64_t h, const std::shared_ptr<Matrix> *owner) {
+    auto range = this->index.equal_range(h);
+    for (auto it = range.first; it != range.second; it++) {
+        if (*(it->second->matrix) == M) {
+            return *(it->second);
+        }
+    }
+    auto entry = std::make_unique<Entry>();
+    entry->matrix = owner != nullptr ? *owner : std::make_shared<Matrix>(M);
+    Entry &result = *entry;
+    this->entries.push_back(std::move(entry));
+    this->index.emplace(h, &result);
+    return result;
+}
+
+std::shared_ptr<Matrix> MatrixRegistry::intern(const std::shared_ptr<Matrix> &M) {
+    return this->find(*M, M->hash(), &M).matrix;
+}
+
+std::shared_ptr<Matrix> MatrixRegistry::intern(const Matrix &M) {
+    return this->find(M, M.hash(), nullptr).matrix;
+}
+
+void MatrixRegistry::clear() {
+    this->index.clear();
+    this->entries.clear();
+}
+
+CDouble MatrixRegistry::eigenvalue(const Matrix &M) {
+    Entry &e = this->find(M, M.hash(), nullptr);
+    if (!e.hasEigenvalue) {
+        e.eigenvalue = e.matrix->mp_eigenvalue();
+        e.hasEigenvalue = true;
+    }
+    return e.eigenvalue;
+}
+
+const Matrix &MatrixRegistry::starClosure(const Matrix &M, MPTime posCycleThreshold) {
+    Entry &e = this->find(M, M.hash(), nullptr);
+    auto &closure = e.starClosures[static_cast<CDouble>(posCycleThreshold)];
+    if (!closure) {
+        closure = std::make_unique<Matrix>(e.matrix->starClosureMatrix(posCycleThreshold));
+    }
+    return *closure;
+}
+
+const MatrixRegistry::GeneralizedEigenvectors &
+MatrixRegistry::generalizedEigenvectors(const Matrix &M) {
+    Entry &e = this->find(M, M.hash(), nullptr);
+    if (!e.generalizedEigenvectors) {
+        e.generalizedEigenvectors = std::make_unique<GeneralizedEigenvectors>(
+                e.matrix->mp_generalized_eigenvectors());
+    }
+    return *(e.generalizedEigenvectors);
+}
+
+} // namespace MaxPlus
@@ -529,6 +529,47 @@ MPTime SparseVector::innerProduct(const SparseVector &v) const {
     return result;
 }
 
+MPTime SparseVector::residualProduct(const SparseVector &v) const {
+    assert(v.getSize() == this->getSize());
+    MPTime result = MP_PLUS_INFINITY;
+
+    unsigned int k1 = 0;
+    unsigned int k2 = 0;
+    unsigned int m1 = 0;
+    unsigned int m2 = 0;
+
+    // same merge of the intervals of both vectors as in innerProduct
+    if (k1 < this->table.size()) {
+        m1 = this->table[k1].first;
+    }
+    if (k2 < v.table.size()) {
+        m2 = v.table[k2].first;
+    }
+    while (k1 < this->table.size()) {
+        unsigned int m = (m1 < m2) ? m1 : m2;
+        MPTime a = this->table[k1].second;
+        if (!a.isMinusInfinity()) {
+            MPTime b = v.table[k2].second;
+            result = MP_MIN(result, b.isMinusInfinity() ? MP_MINUS_INFINITY : b - a);
+        }
+        m1 -= m;
+        m2 -= m;
+        if (m1 == 0) {
+            k1++;
+            if (k1 < this->table.size()) {
+                m1 = this->table[k1].first;
+            }
+        }
+        if (m2 == 0) {
+            k2++;
+            if (k2 < v.table.size()) {
+                m2 = v.table[k2].first;
+            }
+        }
+    }
+    return result;
+}
+
 bool SparseVector::operator==(const SparseVector &v) const {
     return this->forall(v, [](MPTime a, MPTime b) { return a == b; });
 }
@@ -857,6 +898,22 @@ SparseVector SparseMatrix::multiply(const SparseVector &v) {
     return result;
 }
 
+SparseVector SparseMatrix::residuate(const SparseVector &b) {
+    assert(b.getSize() == this->getRowSize());
+
+    // residuation works on the columns, i.e. the non-transposed representation
+    if (this->isTransposed) {
+        this->doTranspose();
+    }
+    SparseVector result(this->getColumnSize());
+    unsigned int j = 0;
+    for (const auto &e : this->table) {
+        result.putAll(j, j + e.first, e.second.residualProduct(b));
+        j += e.first;
+    }
+    return result;
+}
+
 SparseMatrix SparseMatrix::multiply(const SparseMatrix &M) {
     assert(M.getRowSize() == this->getColumnSize());
 
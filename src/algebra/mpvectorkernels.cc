@@ -0,0 +1,689 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mpvectorkernels.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Vectorized element-wise and reduction kernels on max-plus vectors
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "algebra/mpvectorkernels.h"
+#include "algebra/mptype.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MAXPLUS_VECTOR_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace MaxPlus::VectorKernels {
+
+namespace {
+
+constexpr CDouble MIN_INF = MPTIME_MIN_INF_VAL;
+const CDouble MIN_INF_THR = MPTIME_MIN_INF_VALPTHR;
+constexpr CDouble PLUS_INF = std::numeric_limits<CDouble>::infinity();
+
+// number of elements processed per block in the fused kernels, keeps the block in L1
+constexpr std::size_t FUSED_BLOCK = 64;
+
+//==============================
+// portable scalar kernels
+//==============================
+
+CDouble maxElementPortable(const CDouble *x, std::size_t n) {
+    CDouble m = MIN_INF;
+    for (std::size_t k = 0; k < n; k++) {
+        m = m > x[k] ? m : x[k];
+    }
+    return m;
+}
+
+bool containsValuePortable(const CDouble *x, std::size_t n, CDouble v) {
+    bool found = false;
+    for (std::size_t k = 0; k < n; k++) {
+        found |= (x[k] == v);
+    }
+    return found;
+}
+
+void negatePortable(CDouble *x, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        x[k] = -x[k];
+    }
+}
+
+void addScalarPortable(const CDouble *x, CDouble c, CDouble *r, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        r[k] = x[k] <= MIN_INF_THR ? MIN_INF : x[k] + c;
+    }
+}
+
+void addPortable(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        r[k] = (a[k] <= MIN_INF_THR || b[k] <= MIN_INF_THR) ? MIN_INF : a[k] + b[k];
+    }
+}
+
+void maximumPortable(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        r[k] = a[k] > b[k] ? a[k] : b[k];
+    }
+}
+
+bool finiteAndClosePortable(const CDouble *a, const CDouble *b, std::size_t n, CDouble eps) {
+    for (std::size_t k = 0; k < n; k++) {
+        if (a[k] <= MIN_INF_THR || b[k] <= MIN_INF_THR || std::fabs(a[k] - b[k]) > eps) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CDouble minFinitePortable(const CDouble *x, std::size_t n) {
+    CDouble m = PLUS_INF;
+    for (std::size_t k = 0; k < n; k++) {
+        CDouble v = x[k] <= MIN_INF_THR ? PLUS_INF : x[k];
+        m = m < v ? m : v;
+    }
+    return m;
+}
+
+void minOfScalarMinusPortable(const CDouble *a, CDouble b, CDouble *x, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        CDouble t = b - a[k];
+        t = t <= MIN_INF_THR ? MIN_INF : t;
+        x[k] = (a[k] <= MIN_INF_THR || x[k] < t) ? x[k] : t;
+    }
+}
+
+void minOfMinusScalarPortable(const CDouble *b, CDouble a, CDouble *x, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        CDouble t = b[k] - a;
+        t = t <= MIN_INF_THR ? MIN_INF : t;
+        x[k] = x[k] < t ? x[k] : t;
+    }
+}
+
+void maxOfSumsPortable(const CDouble *p, const CDouble *a, CDouble *d, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        CDouble t = p[k] + a[k];
+        d[k] = d[k] > t ? d[k] : t;
+    }
+}
+
+void minOfQuotientsPortable(
+        const CDouble *dn, const CDouble *dk, CDouble q, CDouble *l, std::size_t n) {
+    for (std::size_t k = 0; k < n; k++) {
+        CDouble t = (dn[k] - dk[k]) / q;
+        l[k] = t < l[k] ? t : l[k];
+    }
+}
+
+//==============================
+// AVX2 kernels
+//==============================
+
+#ifdef MAXPLUS_VECTOR_KERNELS_X86
+
+__attribute__((target("avx2"))) CDouble maxElementAVX2(const CDouble *x, std::size_t n) {
+    __m256d m = _mm256_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        m = _mm256_max_pd(m, _mm256_loadu_pd(x + k));
+    }
+    alignas(32) CDouble lanes[4];
+    _mm256_store_pd(lanes, m);
+    CDouble r = maxElementPortable(lanes, 4);
+    CDouble t = maxElementPortable(x + k, n - k);
+    return r > t ? r : t;
+}
+
+__attribute__((target("avx2"))) bool
+containsValueAVX2(const CDouble *x, std::size_t n, CDouble v) {
+    const __m256d vv = _mm256_set1_pd(v);
+    __m256d acc = _mm256_setzero_pd();
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        acc = _mm256_or_pd(acc, _mm256_cmp_pd(_mm256_loadu_pd(x + k), vv, _CMP_EQ_OQ));
+    }
+    return _mm256_movemask_pd(acc) != 0 || containsValuePortable(x + k, n - k, v);
+}
+
+__attribute__((target("avx2"))) void negateAVX2(CDouble *x, std::size_t n) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        _mm256_storeu_pd(x + k, _mm256_xor_pd(_mm256_loadu_pd(x + k), sign));
+    }
+    negatePortable(x + k, n - k);
+}
+
+__attribute__((target("avx2"))) void
+addScalarAVX2(const CDouble *x, CDouble c, CDouble *r, std::size_t n) {
+    const __m256d cc = _mm256_set1_pd(c);
+    const __m256d thr = _mm256_set1_pd(MIN_INF_THR);
+    const __m256d minf = _mm256_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d v = _mm256_loadu_pd(x + k);
+        __m256d isInf = _mm256_cmp_pd(v, thr, _CMP_LE_OQ);
+        _mm256_storeu_pd(r + k, _mm256_blendv_pd(_mm256_add_pd(v, cc), minf, isInf));
+    }
+    addScalarPortable(x + k, c, r + k, n - k);
+}
+
+__attribute__((target("avx2"))) void
+addAVX2(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    const __m256d thr = _mm256_set1_pd(MIN_INF_THR);
+    const __m256d minf = _mm256_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d va = _mm256_loadu_pd(a + k);
+        __m256d vb = _mm256_loadu_pd(b + k);
+        __m256d isInf = _mm256_or_pd(_mm256_cmp_pd(va, thr, _CMP_LE_OQ),
+                                     _mm256_cmp_pd(vb, thr, _CMP_LE_OQ));
+        _mm256_storeu_pd(r + k, _mm256_blendv_pd(_mm256_add_pd(va, vb), minf, isInf));
+    }
+    addPortable(a + k, b + k, r + k, n - k);
+}
+
+__attribute__((target("avx2"))) void
+maximumAVX2(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        _mm256_storeu_pd(r + k, _mm256_max_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k)));
+    }
+    maximumPortable(a + k, b + k, r + k, n - k);
+}
+
+__attribute__((target("avx2"))) bool
+finiteAndCloseAVX2(const CDouble *a, const CDouble *b, std::size_t n, CDouble eps) {
+    const __m256d thr = _mm256_set1_pd(MIN_INF_THR);
+    const __m256d ee = _mm256_set1_pd(eps);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d va = _mm256_loadu_pd(a + k);
+        __m256d vb = _mm256_loadu_pd(b + k);
+        __m256d diff = _mm256_andnot_pd(sign, _mm256_sub_pd(va, vb));
+        __m256d bad = _mm256_or_pd(_mm256_or_pd(_mm256_cmp_pd(va, thr, _CMP_LE_OQ),
+                                                _mm256_cmp_pd(vb, thr, _CMP_LE_OQ)),
+                                   _mm256_cmp_pd(diff, ee, _CMP_GT_OQ));
+        if (_mm256_movemask_pd(bad) != 0) {
+            return false;
+        }
+    }
+    return finiteAndClosePortable(a + k, b + k, n - k, eps);
+}
+
+__attribute__((target("avx2"))) CDouble minFiniteAVX2(const CDouble *x, std::size_t n) {
+    const __m256d thr = _mm256_set1_pd(MIN_INF_THR);
+    const __m256d pinf = _mm256_set1_pd(PLUS_INF);
+    __m256d m = pinf;
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d v = _mm256_loadu_pd(x + k);
+        v = _mm256_blendv_pd(v, pinf, _mm256_cmp_pd(v, thr, _CMP_LE_OQ));
+        m = _mm256_min_pd(m, v);
+    }
+    alignas(32) CDouble lanes[4];
+    _mm256_store_pd(lanes, m);
+    CDouble r = minFinitePortable(lanes, 4);
+    CDouble t = minFinitePortable(x + k, n - k);
+    return r < t ? r : t;
+}
+
+__attribute__((target("avx2"))) void
+minOfScalarMinusAVX2(const CDouble *a, CDouble b, CDouble *x, std::size_t n) {
+    const __m256d bb = _mm256_set1_pd(b);
+    const __m256d thr = _mm256_set1_pd(MIN_INF_THR);
+    const __m256d minf = _mm256_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d va = _mm256_loadu_pd(a + k);
+        __m256d vx = _mm256_loadu_pd(x + k);
+        __m256d t = _mm256_sub_pd(bb, va);
+        t = _mm256_blendv_pd(t, minf, _mm256_cmp_pd(t, thr, _CMP_LE_OQ));
+        t = _mm256_min_pd(vx, t);
+        _mm256_storeu_pd(x + k, _mm256_blendv_pd(t, vx, _mm256_cmp_pd(va, thr, _CMP_LE_OQ)));
+    }
+    minOfScalarMinusPortable(a + k, b, x + k, n - k);
+}
+
+__attribute__((target("avx2"))) void
+minOfMinusScalarAVX2(const CDouble *b, CDouble a, CDouble *x, std::size_t n) {
+    const __m256d aa = _mm256_set1_pd(a);
+    const __m256d thr = _mm256_set1_pd(MIN_INF_THR);
+    const __m256d minf = _mm256_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d t = _mm256_sub_pd(_mm256_loadu_pd(b + k), aa);
+        t = _mm256_blendv_pd(t, minf, _mm256_cmp_pd(t, thr, _CMP_LE_OQ));
+        _mm256_storeu_pd(x + k, _mm256_min_pd(_mm256_loadu_pd(x + k), t));
+    }
+    minOfMinusScalarPortable(b + k, a, x + k, n - k);
+}
+
+__attribute__((target("avx2"))) void
+maxOfSumsAVX2(const CDouble *p, const CDouble *a, CDouble *d, std::size_t n) {
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d t = _mm256_add_pd(_mm256_loadu_pd(p + k), _mm256_loadu_pd(a + k));
+        _mm256_storeu_pd(d + k, _mm256_max_pd(_mm256_loadu_pd(d + k), t));
+    }
+    maxOfSumsPortable(p + k, a + k, d + k, n - k);
+}
+
+__attribute__((target("avx2"))) void
+minOfQuotientsAVX2(const CDouble *dn, const CDouble *dk, CDouble q, CDouble *l, std::size_t n) {
+    const __m256d qq = _mm256_set1_pd(q);
+    std::size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d t = _mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(dn + k), _mm256_loadu_pd(dk + k)),
+                                  qq);
+        _mm256_storeu_pd(l + k, _mm256_min_pd(t, _mm256_loadu_pd(l + k)));
+    }
+    minOfQuotientsPortable(dn + k, dk + k, q, l + k, n - k);
+}
+
+//==============================
+// AVX-512 kernels
+//==============================
+
+// GCC 12 warns that _mm512_max_pd and _mm512_min_pd use an uninitialized value: they pass
+// _mm512_undefined_pd() as the source of their masked builtins, with a mask that selects no
+// element of it
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f"))) CDouble maxElementAVX512(const CDouble *x, std::size_t n) {
+    __m512d m = _mm512_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        m = _mm512_max_pd(m, _mm512_loadu_pd(x + k));
+    }
+    alignas(64) CDouble lanes[8];
+    _mm512_store_pd(lanes, m);
+    CDouble r = maxElementPortable(lanes, 8);
+    CDouble t = maxElementPortable(x + k, n - k);
+    return r > t ? r : t;
+}
+
+__attribute__((target("avx512f"))) bool
+containsValueAVX512(const CDouble *x, std::size_t n, CDouble v) {
+    const __m512d vv = _mm512_set1_pd(v);
+    __mmask8 acc = 0;
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        acc |= _mm512_cmp_pd_mask(_mm512_loadu_pd(x + k), vv, _CMP_EQ_OQ);
+    }
+    return acc != 0 || containsValuePortable(x + k, n - k, v);
+}
+
+__attribute__((target("avx512f"))) void negateAVX512(CDouble *x, std::size_t n) {
+    const __m512i sign = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ULL));
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512i v = _mm512_castpd_si512(_mm512_loadu_pd(x + k));
+        _mm512_storeu_pd(x + k, _mm512_castsi512_pd(_mm512_xor_si512(v, sign)));
+    }
+    negatePortable(x + k, n - k);
+}
+
+__attribute__((target("avx512f"))) void
+addScalarAVX512(const CDouble *x, CDouble c, CDouble *r, std::size_t n) {
+    const __m512d cc = _mm512_set1_pd(c);
+    const __m512d thr = _mm512_set1_pd(MIN_INF_THR);
+    const __m512d minf = _mm512_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d v = _mm512_loadu_pd(x + k);
+        __mmask8 isInf = _mm512_cmp_pd_mask(v, thr, _CMP_LE_OQ);
+        _mm512_storeu_pd(r + k, _mm512_mask_blend_pd(isInf, _mm512_add_pd(v, cc), minf));
+    }
+    addScalarPortable(x + k, c, r + k, n - k);
+}
+
+__attribute__((target("avx512f"))) void
+addAVX512(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    const __m512d thr = _mm512_set1_pd(MIN_INF_THR);
+    const __m512d minf = _mm512_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d va = _mm512_loadu_pd(a + k);
+        __m512d vb = _mm512_loadu_pd(b + k);
+        __mmask8 isInf = _mm512_cmp_pd_mask(va, thr, _CMP_LE_OQ)
+                         | _mm512_cmp_pd_mask(vb, thr, _CMP_LE_OQ);
+        _mm512_storeu_pd(r + k, _mm512_mask_blend_pd(isInf, _mm512_add_pd(va, vb), minf));
+    }
+    addPortable(a + k, b + k, r + k, n - k);
+}
+
+__attribute__((target("avx512f"))) void
+maximumAVX512(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        _mm512_storeu_pd(r + k, _mm512_max_pd(_mm512_loadu_pd(a + k), _mm512_loadu_pd(b + k)));
+    }
+    maximumPortable(a + k, b + k, r + k, n - k);
+}
+
+__attribute__((target("avx512f"))) bool
+finiteAndCloseAVX512(const CDouble *a, const CDouble *b, std::size_t n, CDouble eps) {
+    const __m512d thr = _mm512_set1_pd(MIN_INF_THR);
+    const __m512d ee = _mm512_set1_pd(eps);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d va = _mm512_loadu_pd(a + k);
+        __m512d vb = _mm512_loadu_pd(b + k);
+        __m512d diff = _mm512_abs_pd(_mm512_sub_pd(va, vb));
+        __mmask8 bad = _mm512_cmp_pd_mask(va, thr, _CMP_LE_OQ)
+                       | _mm512_cmp_pd_mask(vb, thr, _CMP_LE_OQ)
+                       | _mm512_cmp_pd_mask(diff, ee, _CMP_GT_OQ);
+        if (bad != 0) {
+            return false;
+        }
+    }
+    return finiteAndClosePortable(a + k, b + k, n - k, eps);
+}
+
+__attribute__((target("avx512f"))) CDouble minFiniteAVX512(const CDouble *x, std::size_t n) {
+    const __m512d thr = _mm512_set1_pd(MIN_INF_THR);
+    const __m512d pinf = _mm512_set1_pd(PLUS_INF);
+    __m512d m = pinf;
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d v = _mm512_loadu_pd(x + k);
+        v = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, thr, _CMP_LE_OQ), v, pinf);
+        m = _mm512_min_pd(m, v);
+    }
+    alignas(64) CDouble lanes[8];
+    _mm512_store_pd(lanes, m);
+    CDouble r = minFinitePortable(lanes, 8);
+    CDouble t = minFinitePortable(x + k, n - k);
+    return r < t ? r : t;
+}
+
+__attribute__((target("avx512f"))) void
+minOfScalarMinusAVX512(const CDouble *a, CDouble b, CDouble *x, std::size_t n) {
+    const __m512d bb = _mm512_set1_pd(b);
+    const __m512d thr = _mm512_set1_pd(MIN_INF_THR);
+    const __m512d minf = _mm512_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d va = _mm512_loadu_pd(a + k);
+        __m512d vx = _mm512_loadu_pd(x + k);
+        __m512d t = _mm512_sub_pd(bb, va);
+        t = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(t, thr, _CMP_LE_OQ), t, minf);
+        t = _mm512_min_pd(vx, t);
+        _mm512_storeu_pd(x + k,
+                         _mm512_mask_blend_pd(_mm512_cmp_pd_mask(va, thr, _CMP_LE_OQ), t, vx));
+    }
+    minOfScalarMinusPortable(a + k, b, x + k, n - k);
+}
+
+__attribute__((target("avx512f"))) void
+minOfMinusScalarAVX512(const CDouble *b, CDouble a, CDouble *x, std::size_t n) {
+    const __m512d aa = _mm512_set1_pd(a);
+    const __m512d thr = _mm512_set1_pd(MIN_INF_THR);
+    const __m512d minf = _mm512_set1_pd(MIN_INF);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d t = _mm512_sub_pd(_mm512_loadu_pd(b + k), aa);
+        t = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(t, thr, _CMP_LE_OQ), t, minf);
+        _mm512_storeu_pd(x + k, _mm512_min_pd(_mm512_loadu_pd(x + k), t));
+    }
+    minOfMinusScalarPortable(b + k, a, x + k, n - k);
+}
+
+__attribute__((target("avx512f"))) void
+maxOfSumsAVX512(const CDouble *p, const CDouble *a, CDouble *d, std::size_t n) {
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d t = _mm512_add_pd(_mm512_loadu_pd(p + k), _mm512_loadu_pd(a + k));
+        _mm512_storeu_pd(d + k, _mm512_max_pd(_mm512_loadu_pd(d + k), t));
+    }
+    maxOfSumsPortable(p + k, a + k, d + k, n - k);
+}
+
+__attribute__((target("avx512f"))) void
+minOfQuotientsAVX512(const CDouble *dn, const CDouble *dk, CDouble q, CDouble *l, std::size_t n) {
+    const __m512d qq = _mm512_set1_pd(q);
+    std::size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m512d t = _mm512_div_pd(_mm512_sub_pd(_mm512_loadu_pd(dn + k), _mm512_loadu_pd(dk + k)),
+                                  qq);
+        _mm512_storeu_pd(l + k, _mm512_min_pd(t, _mm512_loadu_pd(l + k)));
+    }
+    minOfQuotientsPortable(dn + k, dk + k, q, l + k, n - k);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+//==============================
+// run-time selection
+//==============================
+
+struct KernelTable {
+    CDouble (*maxElement)(const CDouble *, std::size_t);
+    bool (*containsValue)(const CDouble *, std::size_t, CDouble);
+    void (*negate)(CDouble *, std::size_t);
+    void (*addScalar)(const CDouble *, CDouble, CDouble *, std::size_t);
+    void (*add)(const CDouble *, const CDouble *, CDouble *, std::size_t);
+    void (*maximum)(const CDouble *, const CDouble *, CDouble *, std::size_t);
+    bool (*finiteAndClose)(const CDouble *, const CDouble *, std::size_t, CDouble);
+    CDouble (*minFinite)(const CDouble *, std::size_t);
+    void (*minOfScalarMinus)(const CDouble *, CDouble, CDouble *, std::size_t);
+    void (*minOfMinusScalar)(const CDouble *, CDouble, CDouble *, std::size_t);
+    void (*maxOfSums)(const CDouble *, const CDouble *, CDouble *, std::size_t);
+    void (*minOfQuotients)(const CDouble *, const CDouble *, CDouble, CDouble *, std::size_t);
+};
+
+KernelTable selectKernels() {
+#ifdef MAXPLUS_VECTOR_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {maxElementAVX512,
+                containsValueAVX512,
+                negateAVX512,
+                addScalarAVX512,
+                addAVX512,
+                maximumAVX512,
+                finiteAndCloseAVX512,
+                minFiniteAVX512,
+                minOfScalarMinusAVX512,
+                minOfMinusScalarAVX512,
+                maxOfSumsAVX512,
+                minOfQuotientsAVX512};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {maxElementAVX2,
+                containsValueAVX2,
+                negateAVX2,
+                addScalarAVX2,
+                addAVX2,
+                maximumAVX2,
+                finiteAndCloseAVX2,
+                minFiniteAVX2,
+                minOfScalarMinusAVX2,
+                minOfMinusScalarAVX2,
+                maxOfSumsAVX2,
+                minOfQuotientsAVX2};
+    }
+#endif
+    return {maxElementPortable,
+            containsValuePortable,
+            negatePortable,
+            addScalarPortable,
+            addPortable,
+            maximumPortable,
+            finiteAndClosePortable,
+            minFinitePortable,
+            minOfScalarMinusPortable,
+            minOfMinusScalarPortable,
+            maxOfSumsPortable,
+            minOfQuotientsPortable};
+}
+
+const KernelTable &kernels() {
+    static const KernelTable table = selectKernels();
+    return table;
+}
+
+//==============================
+// hashing
+//==============================
+
+constexpr std::uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+constexpr std::uint64_t MIX_MULTIPLIER = 0xbf58476d1ce4e5b9ULL;
+
+/**
+ * Four interleaved FNV-1a streams over the 64-bit patterns of the values, so that the
+ * multiplications of consecutive elements do not depend on each other.
+ */
+class BlockHash {
+public:
+    void add(const CDouble *x, std::size_t n) {
+        for (std::size_t k = 0; k < n; k++) {
+            // adding 0.0 maps -0.0 to 0.0 and leaves all other values unchanged
+            CDouble v = x[k] + 0.0;
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &v, sizeof(bits));
+            std::uint64_t &h = this->lanes[this->count++ & 3U];
+            h = (h ^ bits) * FNV_PRIME;
+        }
+    }
+
+    [[nodiscard]] std::uint64_t value() const {
+        std::uint64_t r = this->count;
+        for (std::uint64_t h : this->lanes) {
+            r = (r ^ h ^ (h >> 29U)) * MIX_MULTIPLIER;
+        }
+        return r ^ (r >> 32U);
+    }
+
+private:
+    std::uint64_t lanes[4] = {FNV_OFFSET, FNV_OFFSET ^ 1U, FNV_OFFSET ^ 2U, FNV_OFFSET ^ 3U};
+    std::uint64_t count = 0;
+};
+
+} // namespace
+
+CDouble maxElement(const CDouble *x, std::size_t n) {
+    // the vector kernels combine their lanes in a different order than the scalar loop, which
+    // only shows in the sign of a zero maximum; adding zero turns -0.0 into 0.0 everywhere
+    return kernels().maxElement(x, n) + 0.0;
+}
+
+bool containsValue(const CDouble *x, std::size_t n, CDouble v) {
+    return kernels().containsValue(x, n, v);
+}
+
+void negate(CDouble *x, std::size_t n) { kernels().negate(x, n); }
+
+void addScalar(const CDouble *x, CDouble c, CDouble *r, std::size_t n) {
+    if (c <= MIN_INF_THR) {
+        for (std::size_t k = 0; k < n; k++) {
+            r[k] = MIN_INF;
+        }
+        return;
+    }
+    kernels().addScalar(x, c, r, n);
+}
+
+std::uint64_t hash(const CDouble *x, std::size_t n) {
+    BlockHash h;
+    h.add(x, n);
+    return h.value();
+}
+
+std::uint64_t addScalarAndHash(const CDouble *x, CDouble c, CDouble *r, std::size_t n) {
+    BlockHash hash;
+    for (std::size_t k = 0; k < n; k += FUSED_BLOCK) {
+        std::size_t len = n - k < FUSED_BLOCK ? n - k : FUSED_BLOCK;
+        addScalar(x + k, c, r + k, len);
+        hash.add(r + k, len);
+    }
+    return hash.value();
+}
+
+void add(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    kernels().add(a, b, r, n);
+}
+
+void maximum(const CDouble *a, const CDouble *b, CDouble *r, std::size_t n) {
+    kernels().maximum(a, b, r, n);
+}
+
+bool finiteAndClose(const CDouble *a, const CDouble *b, std::size_t n, CDouble eps) {
+    return kernels().finiteAndClose(a, b, n, eps);
+}
+
+bool minFiniteElement(const CDouble *x, std::size_t n, CDouble &value, std::size_t &position) {
+    CDouble m = kernels().minFinite(x, n);
+    for (std::size_t k = 0; k < n; k++) {
+        if (x[k] > MIN_INF_THR && x[k] == m) {
+            // take the element itself, m may have the other sign if it is zero
+            value = x[k];
+            position = k;
+            return true;
+        }
+    }
+    return false;
+}
+
+void minOfScalarMinus(const CDouble *a, CDouble b, CDouble *x, std::size_t n) {
+    kernels().minOfScalarMinus(a, b, x, n);
+}
+
+void minOfMinusScalar(const CDouble *b, CDouble a, CDouble *x, std::size_t n) {
+    kernels().minOfMinusScalar(b, a, x, n);
+}
+
+void maxOfSums(const CDouble *p, const CDouble *a, CDouble *d, std::size_t n) {
+    kernels().maxOfSums(p, a, d, n);
+}
+
+void minOfQuotients(const CDouble *dn, const CDouble *dk, CDouble q, CDouble *l, std::size_t n) {
+    kernels().minOfQuotients(dn, dk, q, l, n);
+}
+
+} // namespace MaxPlus::VectorKernels
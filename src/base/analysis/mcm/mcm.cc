@@ -39,6 +39,12 @@
  */
 
 #include "base/analysis/mcm/mcm.h"
+#include "base/analysis/mcm/mcmdg.h"
+#include "base/analysis/mcm/mcmhoward.h"
+#include "base/analysis/mcm/mcmyto.h"
+#include "base/exception/exception.h"
+#include <chrono>
+#include <memory>
 
 namespace Graphs {
 // #define __CALC_MCM_PER_CYCLE__
@@ -71,4 +77,149 @@ v_uint mcmGetAdjacentActors(uint a,
 #else // __CALC_MCM_PER_CYCLE__
 
 #endif // __CALC_MCM_PER_CYCLE__
+
+/**
+ * Graphs for which the product of the number of nodes and edges, the work of
+ * Karp's algorithm, is at most this value are analysed with Karp's algorithm
+ * when the algorithm is selected automatically.
+ */
+constexpr CDouble MAX_KARP_WORK = 1e5;
+
+/**
+ * secondsSince ()
+ * The time in seconds elapsed since start.
+ */
+static CDouble secondsSince(const std::chrono::steady_clock::time_point &start) {
+    return std::chrono::duration<CDouble>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * maximumCycleMeanHowardWithCycle ()
+ * Howard's algorithm on a compact graph in which every node has an outgoing
+ * edge. The critical cycle is found by following the policy from a node with
+ * the maximum cycle mean. Throws an MPException if Howard's algorithm does not
+ * converge within maxIterations policy evaluations, if maxIterations is not 0.
+ */
+static CDouble maximumCycleMeanHowardWithCycle(const CompactMCMgraph &g,
+                                               std::vector<const MCMedge *> *cycle,
+                                               unsigned int maxIterations) {
+    HowardState state;
+    convertMCMgraphToMatrix(g, state);
+    if (maxIterations == 0) {
+        Howard(state);
+    } else {
+        unsigned int evaluations = 0;
+        bool converged = true;
+        Howard(state,
+               [&](const std::vector<CDouble> &, const std::vector<CDouble> &,
+                   const std::vector<int> &) {
+                   converged = ++evaluations <= maxIterations;
+                   return converged;
+               });
+        if (!converged) {
+            throw MaxPlus::MPException("Howard: exceeded maximum number of iterations.");
+        }
+    }
+
+    unsigned int critical = 0;
+    for (unsigned int i = 1; i < g.nrNodes(); i++) {
+        if (state.chi[i] > state.chi[critical]) {
+            critical = i;
+        }
+    }
+
+    *cycle = g.originalEdges(policyCycle(g, g.weights(), state.policy, critical));
+    return state.chi[critical];
+}
+
+/**
+ * maximumCycleMean ()
+ * The function computes the maximum cycle mean of the visible part of an
+ * MCMgraph with an algorithm selected by the options or by statistics of the
+ * graph.
+ */
+MCMResult maximumCycleMean(MCMgraph &g, const MCMOptions &options) {
+    MCMResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    // convert the graph and remove the nodes that do not reach a cycle
+    const CompactMCMgraph full(g);
+    const CompactMCMgraph c = full.subgraph(nodesReachingCycles(full));
+    result.nrNodes = c.nrNodes();
+    result.nrEdges = c.nrEdges();
+    for (CDouble w : c.weights()) {
+        if (w != std::floor(w)) {
+            result.integerWeights = false;
+            break;
+        }
+    }
+    result.preparationTime = secondsSince(start);
+    if (c.nrNodes() == 0) {
+        return result;
+    }
+
+    // select an algorithm
+    MCMAlgorithm algorithm = options.algorithm;
+    if (algorithm == MCMAlgorithm::Automatic) {
+        const CDouble work = static_cast<CDouble>(c.nrNodes()) * c.nrEdges();
+        algorithm = (work <= MAX_KARP_WORK && !options.criticalCycle) ? MCMAlgorithm::Karp
+                                                                       : MCMAlgorithm::Howard;
+    }
+
+    start = std::chrono::steady_clock::now();
+    bool haveCycle = false;
+    switch (algorithm) {
+    case MCMAlgorithm::Karp:
+        result.value = maximumCycleMeanKarpComponents(c, nullptr, options.nrThreads);
+        break;
+    case MCMAlgorithm::KarpParallel:
+        result.value = maximumCycleMeanKarpDoubleParallel(c, nullptr, options.nrThreads);
+        break;
+    case MCMAlgorithm::KarpLean:
+        result.value = maximumCycleMeanKarpLean(c);
+        break;
+    case MCMAlgorithm::YoungTarjanOrlin:
+        result.value = maxCycleMeanAndCriticalCycleYoungTarjanOrlin(
+                c, options.criticalCycle ? &result.cycle : nullptr);
+        haveCycle = options.criticalCycle;
+        break;
+    case MCMAlgorithm::DasdanGupta:
+        result.value = mcmDG(c);
+        break;
+    case MCMAlgorithm::Howard:
+    case MCMAlgorithm::Automatic:
+        try {
+            result.value =
+                    maximumCycleMeanHowardWithCycle(c, &result.cycle, options.maxHowardIterations);
+            haveCycle = true;
+        } catch (const MaxPlus::MPException &) {
+            if (options.algorithm != MCMAlgorithm::Automatic) {
+                throw;
+            }
+            // Howard did not converge, fall back to an algorithm that always does
+            result.cycle.clear();
+            if (options.criticalCycle) {
+                algorithm = MCMAlgorithm::YoungTarjanOrlin;
+                result.value = maxCycleMeanAndCriticalCycleYoungTarjanOrlin(c, &result.cycle);
+                haveCycle = true;
+            } else {
+                algorithm = MCMAlgorithm::KarpLean;
+                result.value = maximumCycleMeanKarpLean(c);
+            }
+        }
+        break;
+    }
+    result.algorithm = algorithm;
+    result.solveTime = secondsSince(start);
+
+    if (!options.criticalCycle) {
+        result.cycle.clear();
+    } else if (!haveCycle || result.cycle.empty()) {
+        // Young-Tarjan-Orlin's algorithm always terminates with a critical cycle
+        start = std::chrono::steady_clock::now();
+        maxCycleMeanAndCriticalCycleYoungTarjanOrlin(c, &result.cycle);
+        result.cycleTime = secondsSince(start);
+    }
+    return result;
+}
 } // namespace Graphs
@@ -0,0 +1,148 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmanytime.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Anytime maximum cycle mean with converging bounds.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmanytime.h"
+#include "base/analysis/mcm/mcmhoward.h"
+#include "base/exception/exception.h"
+#include <algorithm>
+
+namespace Graphs {
+
+namespace {
+
+/**
+ * potentialBound ()
+ * The largest w(e) + v(dst(e)) - v(src(e)) over the edges e inside a strongly
+ * connected component. Every cycle lies inside a component and its mean is the
+ * mean of these values along the cycle, so this is an upper bound on the
+ * maximum cycle mean for any potentials v.
+ */
+CDouble potentialBound(const CompactMCMgraph &g,
+                       const ComponentDecomposition &scc,
+                       const std::vector<CDouble> &v) {
+    auto bound = static_cast<CDouble>(-INFINITY);
+    for (unsigned int e : scc.edges) {
+        bound = std::max(bound, g.weight(e) + v[g.destination(e)] - v[g.source(e)]);
+    }
+    return bound;
+}
+
+CDouble secondsSince(const std::chrono::steady_clock::time_point &start) {
+    return std::chrono::duration<CDouble>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+/**
+ * anytimeMaximumCycleMean ()
+ * The function runs Howard's algorithm on the nodes of g that reach a cycle and
+ * updates the bounds at every checkpoint. Before the first iteration the upper
+ * bound is the largest weight of an edge inside a component.
+ */
+AnytimeMCMResult anytimeMaximumCycleMean(const CompactMCMgraph &g,
+                                         const AnytimeMCMOptions &options) {
+    const auto start = std::chrono::steady_clock::now();
+    AnytimeMCMResult result;
+    const CompactMCMgraph core = g.subgraph(nodesReachingCycles(g));
+    const ComponentDecomposition scc = decomposeComponents(core);
+    if (scc.edges.empty()) {
+        result.lower = result.upper = -INFINITY;
+        result.converged = true;
+        result.elapsed = secondsSince(start);
+        return result;
+    }
+    result.upper = -INFINITY;
+    for (unsigned int e : scc.edges) {
+        result.upper = std::max(result.upper, core.weight(e));
+    }
+
+    // report and decide whether to stop
+    const auto checkpoint = [&]() {
+        result.elapsed = secondsSince(start);
+        result.converged = result.upper - result.lower <= options.tolerance;
+        if (options.progress) {
+            options.progress(result);
+        }
+        return !result.converged && std::chrono::steady_clock::now() < options.deadline;
+    };
+
+    std::vector<int> bestPolicy;
+    unsigned int bestNode = 0;
+    if (checkpoint()) {
+        HowardState state;
+        convertMCMgraphToMatrix(core, state);
+        bool stopped = false;
+        try {
+            Howard(state,
+                   [&](const std::vector<CDouble> &chi,
+                       const std::vector<CDouble> &v,
+                       const std::vector<int> &policy) {
+                       result.nrIterations++;
+                       const auto best = static_cast<unsigned int>(
+                               std::max_element(chi.begin(), chi.end()) - chi.begin());
+                       if (chi[best] > result.lower) {
+                           result.lower = chi[best];
+                           bestPolicy = policy;
+                           bestNode = best;
+                       }
+                       result.upper = std::min(result.upper, potentialBound(core, scc, v));
+                       stopped = !checkpoint();
+                       return !stopped;
+                   });
+        } catch (const MaxPlus::MPException &) {
+            // Howard's algorithm did not converge; the bounds found so far remain valid
+            stopped = true;
+        }
+        if (!stopped) {
+            // Howard's algorithm converged: the best cycle is optimal, the upper
+            // bound may still exceed it by the tolerance of the algorithm
+            result.converged = true;
+        }
+    }
+
+    if (!bestPolicy.empty()) {
+        result.cycle = core.originalEdges(policyCycle(core, core.weights(), bestPolicy, bestNode));
+    }
+    result.elapsed = secondsSince(start);
+    return result;
+}
+
+AnytimeMCMResult anytimeMaximumCycleMean(MCMgraph &g, const AnytimeMCMOptions &options) {
+    return anytimeMaximumCycleMean(CompactMCMgraph(g), options);
+}
+
+} // namespace Graphs
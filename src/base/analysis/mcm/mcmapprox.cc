@@ -0,0 +1,419 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmapprox.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Approximate maximum cycle mean and ratio by parametric search.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmapprox.h"
+#include "base/exception/exception.h"
+#include "base/parallel/parallel.h"
+#include <algorithm>
+#include <climits>
+
+namespace Graphs {
+
+namespace {
+
+// relative amount by which a path must be longer to replace the current one,
+// so that rounding errors on cycles of length zero do not look like progress
+constexpr CDouble ORACLE_EPSILON = 1e-12;
+
+// graphs with fewer edges than this are tested on the calling thread, as the
+// synchronization per round would cost more than it saves
+constexpr unsigned int MIN_EDGES_FOR_PARALLEL_ORACLE = 4096;
+
+constexpr unsigned int NO_EDGE = UINT_MAX;
+
+/**
+ * PositiveCycleOracle
+ * Tests for a cycle of positive length under the weights w(e) - lambda * d(e)
+ * with longest paths from a virtual source that has an edge of length 0 to
+ * every node. In every round all nodes are relaxed over their incoming edges
+ * from the lengths of the previous round, so the nodes can be divided over
+ * threads. If the lengths stop changing, there is no positive cycle and they
+ * are kept: for a smaller lambda paths only get longer, so they are a valid
+ * start of the next test. As long as the lengths keep changing, the edges by
+ * which the nodes got their lengths are checked for a cycle after every round;
+ * such a cycle has a positive length.
+ */
+class PositiveCycleOracle {
+public:
+    PositiveCycleOracle(const CompactMCMgraph &g, bool unitDelays, unsigned int nrThreads) :
+        g(g),
+        unitDelays(unitDelays),
+        feasible(g.nrNodes(), 0.0),
+        dist(g.nrNodes()),
+        next(g.nrNodes()),
+        parent(g.nrNodes()),
+        stamp(g.nrNodes()),
+        inSource(g.nrEdges()),
+        inLength(g.nrEdges()) {
+        const unsigned int n = g.nrNodes();
+        for (unsigned int i = 0; i < g.nrEdges(); i++) {
+            this->inSource[i] = g.source(g.inEdge(i));
+        }
+        if (nrThreads == 0) {
+            nrThreads = MaxPlus::defaultThreadCount();
+        }
+        if (nrThreads > n) {
+            nrThreads = n;
+        }
+        if (g.nrEdges() < MIN_EDGES_FOR_PARALLEL_ORACLE) {
+            nrThreads = 1;
+        }
+
+        // split the nodes into ranges of about equal in-degree, one per thread
+        this->rangeStart.assign(nrThreads + 1, n);
+        this->rangeStart[0] = 0;
+        const size_t totalWork = static_cast<size_t>(g.nrEdges()) + n;
+        unsigned int t = 1;
+        for (unsigned int v = 0; v < n && t < nrThreads; v++) {
+            const size_t work = static_cast<size_t>(g.inBegin(v)) + v;
+            if (work * nrThreads >= totalWork * t) {
+                this->rangeStart[t++] = v;
+            }
+        }
+        this->changed.assign(nrThreads, 0);
+    }
+
+    [[nodiscard]] CDouble delay(unsigned int e) const {
+        return this->unitDelays ? 1.0 : this->g.delay(e);
+    }
+
+    /**
+     * positiveCycle ()
+     * Returns true, with the edges of a cycle of positive length in traversal
+     * order, if there is one for the given lambda.
+     */
+    bool positiveCycle(CDouble lambda, std::vector<unsigned int> *cycle) {
+        const auto nrThreads = static_cast<unsigned int>(this->changed.size());
+        const unsigned int maxRounds = 2 * this->g.nrNodes() + 2;
+        for (unsigned int i = 0; i < this->g.nrEdges(); i++) {
+            const unsigned int e = this->g.inEdge(i);
+            this->inLength[i] = this->g.weight(e) - lambda * this->delay(e);
+        }
+        this->dist = this->feasible;
+        std::fill(this->parent.begin(), this->parent.end(), NO_EDGE);
+        unsigned int round = 0;
+        bool done = false;
+        bool found = false;
+        bool failed = false;
+
+        // called on one thread after every round
+        const auto decide = [&]() {
+            std::swap(this->dist, this->next);
+            round++;
+            if (std::none_of(this->changed.begin(), this->changed.end(), [](char c) {
+                    return c != 0;
+                })) {
+                this->feasible = this->dist;
+                return true;
+            }
+            if (this->parentCycle(lambda, cycle)) {
+                found = true;
+                return true;
+            }
+            if (round == maxRounds) {
+                failed = true;
+                return true;
+            }
+            return false;
+        };
+
+        if (nrThreads == 1) {
+            while (!done) {
+                this->changed[0] = this->relax(0, this->g.nrNodes()) ? 1 : 0;
+                done = decide();
+            }
+        } else {
+            MaxPlus::Barrier roundDone(nrThreads);
+            MaxPlus::parallelRun(
+                    [&](unsigned int thread, unsigned int /*nrThreads*/) {
+                        const unsigned int vBegin = this->rangeStart[thread];
+                        const unsigned int vEnd = this->rangeStart[thread + 1];
+                        while (true) {
+                            this->changed[thread] = this->relax(vBegin, vEnd) ? 1 : 0;
+                            roundDone.arriveAndWait();
+                            if (thread == 0) {
+                                done = decide();
+                            }
+                            roundDone.arriveAndWait();
+                            if (done) {
+                                break;
+                            }
+                        }
+                    },
+                    nrThreads);
+        }
+        if (failed) {
+            throw MaxPlus::MPException(
+                    "Positive cycle test did not converge in approximateMaximumCycleRatio.");
+        }
+        return found;
+    }
+
+    /**
+     * slack ()
+     * After a test without a positive cycle, the largest amount by which an
+     * edge is longer than the difference of the kept lengths of its end
+     * points. The relaxations ignore gains below their tolerance, so this is
+     * not always zero. A cycle of k edges is then at most k times the slack
+     * long under the lambda of that test.
+     */
+    [[nodiscard]] CDouble slack() const {
+        CDouble s = 0.0;
+        for (unsigned int v = 0; v < this->g.nrNodes(); v++) {
+            for (unsigned int i = this->g.inBegin(v); i < this->g.inEnd(v); i++) {
+                s = std::max(s,
+                             this->feasible[this->inSource[i]] + this->inLength[i]
+                                     - this->feasible[v]);
+            }
+        }
+        return s;
+    }
+
+private:
+    // One round of relaxations of the nodes in [vBegin, vEnd), from dist into
+    // next; returns whether a length changed. The incoming edges are read from
+    // arrays in the order of the in-adjacency, so only the lengths of the
+    // sources are accessed at random.
+    bool relax(unsigned int vBegin, unsigned int vEnd) {
+        bool anyChange = false;
+        for (unsigned int v = vBegin; v < vEnd; v++) {
+            CDouble best = this->dist[v];
+            const CDouble threshold = best + ORACLE_EPSILON * (1.0 + std::fabs(best));
+            for (unsigned int i = this->g.inBegin(v); i < this->g.inEnd(v); i++) {
+                const CDouble length = this->dist[this->inSource[i]] + this->inLength[i];
+                if (length > threshold && length > best) {
+                    best = length;
+                    this->parent[v] = this->g.inEdge(i);
+                    anyChange = true;
+                }
+            }
+            this->next[v] = best;
+        }
+        return anyChange;
+    }
+
+    // Searches a cycle of positive length among the edges to the parents of the
+    // nodes. Every node has at most one parent edge, so walking from each node
+    // to its ancestors finds every cycle in O(n).
+    bool parentCycle(CDouble lambda, std::vector<unsigned int> *cycle) {
+        const unsigned int n = this->g.nrNodes();
+        std::fill(this->stamp.begin(), this->stamp.end(), n);
+        for (unsigned int start = 0; start < n; start++) {
+            unsigned int v = start;
+            while (this->stamp[v] == n && this->parent[v] != NO_EDGE) {
+                this->stamp[v] = start;
+                v = this->g.source(this->parent[v]);
+            }
+            if (this->stamp[v] != start) {
+                continue;
+            }
+            // v lies on a cycle of parent edges, collect it against the edge direction
+            cycle->clear();
+            CDouble length = 0.0;
+            unsigned int u = v;
+            do {
+                const unsigned int e = this->parent[u];
+                cycle->push_back(e);
+                length += this->g.weight(e) - lambda * this->delay(e);
+                u = this->g.source(e);
+            } while (u != v);
+            std::reverse(cycle->begin(), cycle->end());
+            // rounding may make a cycle of length about zero look positive
+            if (length > 0.0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const CompactMCMgraph &g;
+    const bool unitDelays;
+    std::vector<CDouble> feasible;
+    std::vector<CDouble> dist;
+    std::vector<CDouble> next;
+    std::vector<unsigned int> parent;
+    std::vector<unsigned int> stamp;
+    std::vector<unsigned int> rangeStart;
+    std::vector<char> changed;
+    // source and length under the current lambda of every incoming edge, in
+    // the order of the in-adjacency
+    std::vector<unsigned int> inSource;
+    std::vector<CDouble> inLength;
+};
+
+/**
+ * approximateCycleRatio ()
+ * Lawler's parametric search on the nodes of g that reach a cycle. A first
+ * cycle gives the lower bound; the upper bound is found by doubling the
+ * distance to it until the oracle finds no positive cycle. Every positive
+ * cycle found raises the lower bound to its ratio, which may be well above
+ * the value tested.
+ */
+ApproximateMCMResult approximateCycleRatio(const CompactMCMgraph &g,
+                                           CDouble eps,
+                                           bool unitDelays,
+                                           unsigned int nrThreads) {
+    if (!(eps > 0.0)) {
+        throw MaxPlus::MPException(
+                "The accuracy of approximateMaximumCycleRatio must be positive.");
+    }
+    ApproximateMCMResult result;
+    const CompactMCMgraph core = g.subgraph(nodesReachingCycles(g));
+    std::vector<unsigned int> cycle;
+    if (core.nrEdges() == 0) {
+        return result;
+    }
+    if (!unitDelays) {
+        std::vector<bool> noDelay(core.nrEdges());
+        for (unsigned int e = 0; e < core.nrEdges(); e++) {
+            if (core.delay(e) < 0.0) {
+                throw MaxPlus::MPException("Negative delay in approximateMaximumCycleRatio.");
+            }
+            noDelay[e] = core.delay(e) == 0.0;
+        }
+        if (findCycle(core, noDelay, &cycle)) {
+            result.lower = result.upper = INFINITY;
+            result.cycle = core.originalEdges(cycle);
+            return result;
+        }
+    }
+
+    PositiveCycleOracle oracle(core, unitDelays, nrThreads);
+    const auto ratio = [&](const std::vector<unsigned int> &c) {
+        CDouble w = 0.0;
+        CDouble d = 0.0;
+        for (unsigned int e : c) {
+            w += core.weight(e);
+            d += oracle.delay(e);
+        }
+        return w / d;
+    };
+
+    // a cycle has at most n edges and, as it has no cycle without delay, a
+    // delay of at least the smallest positive one
+    CDouble minDelay = 1.0;
+    if (!unitDelays) {
+        minDelay = INFINITY;
+        for (unsigned int e = 0; e < core.nrEdges(); e++) {
+            if (core.delay(e) > 0.0) {
+                minDelay = std::min(minDelay, core.delay(e));
+            }
+        }
+    }
+    const CDouble slackFactor = unitDelays ? 1.0 : core.nrNodes() / minDelay;
+    // the upper bound certified by a test without a positive cycle at lambda
+    const auto certified = [&](CDouble lambda) {
+        return lambda + slackFactor * oracle.slack();
+    };
+
+    findCycle(core, std::vector<bool>(core.nrEdges(), true), &cycle);
+    std::vector<unsigned int> best = cycle;
+    CDouble lower = ratio(cycle);
+    CDouble step = std::max(1.0, std::fabs(lower));
+    CDouble upper = lower + step;
+    const auto probe = [&](CDouble lambda) {
+        result.nrProbes++;
+        if (!oracle.positiveCycle(lambda, &cycle)) {
+            return false;
+        }
+        const CDouble r = ratio(cycle);
+        if (r > lower) {
+            lower = r;
+            best = cycle;
+        }
+        return true;
+    };
+
+    while (probe(upper)) {
+        step *= 2.0;
+        upper = lower + step;
+    }
+    upper = certified(upper);
+    // After the lower bound has been raised, its cycle is often optimal, so the
+    // next test is just eps above it. Such tests alternate with halving steps
+    // to keep the logarithmic number of tests.
+    bool raised = true;
+    bool previousTight = false;
+    while (upper - lower > eps) {
+        const bool tight = raised && !previousTight;
+        const CDouble lambda = tight ? lower + eps : lower + (upper - lower) / 2.0;
+        if (lambda <= lower || lambda >= upper) {
+            // eps is below the resolution of doubles at this value
+            break;
+        }
+        const CDouble before = lower;
+        if (!probe(lambda)) {
+            const CDouble bound = certified(lambda);
+            if (bound >= upper) {
+                // the tolerance of the test is above the remaining gap
+                break;
+            }
+            upper = bound;
+        }
+        raised = lower > before;
+        previousTight = tight;
+    }
+
+    result.lower = lower;
+    result.upper = std::max(lower, upper);
+    result.cycle = core.originalEdges(best);
+    return result;
+}
+
+} // namespace
+
+ApproximateMCMResult
+approximateMaximumCycleRatio(const CompactMCMgraph &g, CDouble eps, unsigned int nrThreads) {
+    return approximateCycleRatio(g, eps, false, nrThreads);
+}
+
+ApproximateMCMResult
+approximateMaximumCycleRatio(MCMgraph &g, CDouble eps, unsigned int nrThreads) {
+    return approximateCycleRatio(CompactMCMgraph(g), eps, false, nrThreads);
+}
+
+ApproximateMCMResult
+approximateMaximumCycleMean(const CompactMCMgraph &g, CDouble eps, unsigned int nrThreads) {
+    return approximateCycleRatio(g, eps, true, nrThreads);
+}
+
+ApproximateMCMResult
+approximateMaximumCycleMean(MCMgraph &g, CDouble eps, unsigned int nrThreads) {
+    return approximateCycleRatio(CompactMCMgraph(g), eps, true, nrThreads);
+}
+
+} // namespace Graphs
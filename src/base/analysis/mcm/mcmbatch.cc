@@ -0,0 +1,226 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmbatch.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Maximum cycle means of many weightings of one graph
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmbatch.h"
+#include "algebra/mpvectorkernels.h"
+#include "base/analysis/mcm/mcmhoward.h"
+#include "base/exception/exception.h"
+#include "base/memory/alignedallocator.h"
+#include "base/parallel/parallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Graphs {
+
+namespace {
+
+using Lanes = std::vector<CDouble, MaxPlus::AlignedAllocator<CDouble>>;
+
+// the tables of a chunk, (4 * nrNodes + nrEdges) * chunk doubles, should stay within this size
+constexpr std::size_t KARP_CHUNK_BUDGET = 256 * 1024;
+constexpr unsigned int MIN_CHUNK = 8;
+constexpr unsigned int MAX_CHUNK = 256;
+
+unsigned int chunkSize(const CompactMCMgraph &g) {
+    std::size_t c = KARP_CHUNK_BUDGET / (4 * static_cast<std::size_t>(g.nrNodes()) + g.nrEdges());
+    c = std::min<std::size_t>(std::max<std::size_t>(c, MIN_CHUNK), MAX_CHUNK);
+    return static_cast<unsigned int>(c - c % MIN_CHUNK);
+}
+
+// Compute the next layer cur of the distances from prev for all nodes and all C lanes.
+void relaxLayer(
+        const CompactMCMgraph &g, const Lanes &w, const Lanes &prev, Lanes &cur, std::size_t C) {
+    std::fill(cur.begin(), cur.end(), -INFINITY);
+    for (unsigned int v = 0; v < g.nrNodes(); v++) {
+        CDouble *dv = cur.data() + v * C;
+        for (unsigned int i = g.inBegin(v); i < g.inEnd(v); i++) {
+            const unsigned int e = g.inEdge(i);
+            MaxPlus::VectorKernels::maxOfSums(
+                    prev.data() + g.source(e) * C, w.data() + e * C, dv, C);
+        }
+    }
+}
+
+/**
+ * Karp's algorithm for weightings k0 .. k0 + C - 1, in the two passes of the
+ * lean version with O(n) memory per weighting. The tables are stored with the C
+ * weightings of a node or edge side by side. Unreached entries are -infinity
+ * instead of -DBL_MAX, such that the relaxation and Karp's quotients need no
+ * tests: -infinity plus a weight remains -infinity, a quotient with an
+ * unreached d_k is +infinity, and one with an unreached d_n is -infinity or not
+ * a number, neither of which affects the minimum or the maximum over the nodes.
+ */
+void karpChunk(const CompactMCMgraph &g,
+               const std::vector<CDouble> &weights,
+               std::size_t k0,
+               std::size_t C,
+               CDouble *result) {
+    const unsigned int n = g.nrNodes();
+    const unsigned int m = g.nrEdges();
+
+    Lanes w(static_cast<std::size_t>(m) * C);
+    for (std::size_t k = 0; k < C; k++) {
+        const CDouble *row = weights.data() + (k0 + k) * m;
+        for (unsigned int e = 0; e < m; e++) {
+            w[e * C + k] = row[e];
+        }
+    }
+
+    // first pass, computing layer n
+    Lanes prev(static_cast<std::size_t>(n) * C, 0.0);
+    Lanes cur(static_cast<std::size_t>(n) * C);
+    for (unsigned int k = 1; k < n + 1; k++) {
+        relaxLayer(g, w, prev, cur, C);
+        prev.swap(cur);
+    }
+    const Lanes dn(prev);
+
+    // second pass, applying Karp's theorem layer by layer
+    Lanes ld(static_cast<std::size_t>(n) * C, INFINITY);
+    std::fill(prev.begin(), prev.end(), 0.0);
+    for (unsigned int k = 0; k < n; k++) {
+        if (k > 0) {
+            relaxLayer(g, w, prev, cur, C);
+            prev.swap(cur);
+        }
+        for (unsigned int u = 0; u < n; u++) {
+            MaxPlus::VectorKernels::minOfQuotients(dn.data() + u * C,
+                                                   prev.data() + u * C,
+                                                   static_cast<CDouble>(n - k),
+                                                   ld.data() + u * C,
+                                                   C);
+        }
+    }
+
+    Lanes l(C, -INFINITY);
+    for (unsigned int u = 0; u < n; u++) {
+        MaxPlus::VectorKernels::maximum(ld.data() + u * C, l.data(), l.data(), C);
+    }
+    std::copy(l.begin(), l.end(), result + k0);
+}
+
+/**
+ * Critical cycles for weightings k0 .. k0 + C - 1 with Howard's algorithm on
+ * core, the part of the graph that reaches a cycle, whose edge e is edge
+ * edgeMap[e] of the full graph. Each run starts from the policy of the previous
+ * weighting.
+ */
+void cyclesChunk(const CompactMCMgraph &core,
+                 const std::vector<unsigned int> &edgeMap,
+                 const std::vector<CDouble> &weights,
+                 unsigned int m,
+                 std::size_t k0,
+                 std::size_t C,
+                 std::vector<std::vector<const MCMedge *>> *cycles) {
+    HowardState state;
+    convertMCMgraphToMatrix(core, state);
+    for (std::size_t k = k0; k < k0 + C; k++) {
+        const CDouble *row = weights.data() + k * m;
+        for (unsigned int e = 0; e < core.nrEdges(); e++) {
+            state.A[e] = row[edgeMap[e]];
+        }
+        Howard(state);
+
+        unsigned int critical = 0;
+        for (unsigned int v = 1; v < core.nrNodes(); v++) {
+            if (state.chi[v] > state.chi[critical]) {
+                critical = v;
+            }
+        }
+        (*cycles)[k] = core.originalEdges(policyCycle(core, state.A, state.policy, critical));
+    }
+}
+
+} // namespace
+
+std::vector<CDouble> maximumCycleMeansBatch(const CompactMCMgraph &g,
+                                            const std::vector<CDouble> &weights,
+                                            std::vector<std::vector<const MCMedge *>> *cycles,
+                                            unsigned int nrThreads) {
+    const unsigned int m = g.nrEdges();
+    if (m == 0 ? !weights.empty() : weights.size() % m != 0) {
+        throw MaxPlus::MPException("Number of weights is not a multiple of the number of edges "
+                                   "in maximumCycleMeansBatch");
+    }
+    const std::size_t K = m == 0 ? 0 : weights.size() / m;
+    std::vector<CDouble> result(K, -INFINITY);
+    if (cycles != nullptr) {
+        cycles->assign(K, std::vector<const MCMedge *>());
+    }
+    if (K == 0) {
+        return result;
+    }
+
+    const std::size_t C = chunkSize(g);
+    const std::size_t nrChunks = (K + C - 1) / C;
+    MaxPlus::parallelFor(
+            0,
+            nrChunks,
+            [&](std::size_t c) {
+                const std::size_t k0 = c * C;
+                karpChunk(g, weights, k0, std::min(C, K - k0), result.data());
+            },
+            nrThreads);
+
+    if (cycles == nullptr) {
+        return result;
+    }
+    const std::vector<bool> keep = nodesReachingCycles(g);
+    const CompactMCMgraph core = g.subgraph(keep);
+    if (core.nrNodes() == 0) {
+        return result;
+    }
+    // the subgraph keeps the edges between kept nodes in their original order
+    std::vector<unsigned int> edgeMap;
+    edgeMap.reserve(core.nrEdges());
+    for (unsigned int e = 0; e < m; e++) {
+        if (keep[g.source(e)] && keep[g.destination(e)]) {
+            edgeMap.push_back(e);
+        }
+    }
+    MaxPlus::parallelFor(
+            0,
+            nrChunks,
+            [&](std::size_t c) {
+                const std::size_t k0 = c * C;
+                cyclesChunk(core, edgeMap, weights, m, k0, std::min(C, K - k0), cycles);
+            },
+            nrThreads);
+    return result;
+}
+
+} // namespace Graphs
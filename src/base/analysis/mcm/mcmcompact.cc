@@ -0,0 +1,435 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmcompact.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Compact, array based snapshot of an MCMgraph.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmcompact.h"
+#include "base/exception/exception.h"
+#include "base/parallel/parallel.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace Graphs {
+
+CompactMCMgraph::CompactMCMgraph(MCMgraph &g) {
+    // number the visible nodes densely
+    std::unordered_map<const MCMnode *, unsigned int> index;
+    index.reserve(g.getNodes().size());
+    for (auto &n : g.getNodes()) {
+        if (n.visible) {
+            index.emplace(&n, static_cast<unsigned int>(this->nodes.size()));
+            this->nodes.push_back(&n);
+        }
+    }
+
+    // collect the visible edges between visible nodes
+    for (const auto &e : g.getEdges()) {
+        if (!e.visible || !e.src->visible || !e.dst->visible) {
+            continue;
+        }
+        this->src.push_back(index[e.src]);
+        this->dst.push_back(index[e.dst]);
+        this->w.push_back(e.w);
+        this->d.push_back(e.d);
+        this->edges.push_back(&e);
+    }
+    this->buildAdjacency();
+}
+
+CompactMCMgraph CompactMCMgraph::fromEdges(unsigned int nrNodes,
+                                           std::vector<unsigned int> src,
+                                           std::vector<unsigned int> dst,
+                                           std::vector<CDouble> w,
+                                           std::vector<CDouble> d) {
+    const size_t m = src.size();
+    if (dst.size() != m || w.size() != m || d.size() != m) {
+        throw MaxPlus::MPException("Edge arrays of different length in CompactMCMgraph.");
+    }
+    for (size_t e = 0; e < m; e++) {
+        if (src[e] >= nrNodes || dst[e] >= nrNodes) {
+            throw MaxPlus::MPException("Edge with an unknown node in CompactMCMgraph.");
+        }
+    }
+
+    CompactMCMgraph result;
+    result.nodes.assign(nrNodes, nullptr);
+    result.edges.assign(m, nullptr);
+    result.src = std::move(src);
+    result.dst = std::move(dst);
+    result.w = std::move(w);
+    result.d = std::move(d);
+    result.buildAdjacency();
+    return result;
+}
+
+CompactMCMgraph CompactMCMgraph::subgraph(const std::vector<bool> &keep) const {
+    CompactMCMgraph result;
+    const unsigned int n = this->nrNodes();
+    std::vector<unsigned int> index(n, n);
+    for (unsigned int v = 0; v < n; v++) {
+        if (keep[v]) {
+            index[v] = static_cast<unsigned int>(result.nodes.size());
+            result.nodes.push_back(this->nodes[v]);
+        }
+    }
+    for (unsigned int e = 0; e < this->nrEdges(); e++) {
+        if (!keep[this->src[e]] || !keep[this->dst[e]]) {
+            continue;
+        }
+        result.src.push_back(index[this->src[e]]);
+        result.dst.push_back(index[this->dst[e]]);
+        result.w.push_back(this->w[e]);
+        result.d.push_back(this->d[e]);
+        result.edges.push_back(this->edges[e]);
+    }
+    result.buildAdjacency();
+    return result;
+}
+
+/**
+ * Graphs with fewer edges than this are pruned on the calling thread.
+ */
+constexpr unsigned int MIN_EDGES_FOR_PARALLEL_PRUNING = 4096;
+
+CompactMCMgraph CompactMCMgraph::pruneEdges(unsigned int nrThreads) const {
+    const unsigned int n = this->nrNodes();
+    const unsigned int m = this->nrEdges();
+
+    // sort the outgoing edges of every node on destination, delay and
+    // decreasing weight, an edge is Pareto maximal if and only if it is
+    // heavier than the last edge kept for its destination
+    std::vector<unsigned char> keep(m, 0);
+    auto front = [&](size_t v) {
+        std::vector<unsigned int> out(this->outEdges.begin() + this->outStart[v],
+                                      this->outEdges.begin() + this->outStart[v + 1]);
+        std::stable_sort(out.begin(), out.end(), [this](unsigned int a, unsigned int b) {
+            if (this->dst[a] != this->dst[b]) {
+                return this->dst[a] < this->dst[b];
+            }
+            if (this->d[a] != this->d[b]) {
+                return this->d[a] < this->d[b];
+            }
+            return this->w[a] > this->w[b];
+        });
+        unsigned int last = m;
+        for (unsigned int e : out) {
+            if (last == m || this->dst[e] != this->dst[last] || this->w[e] > this->w[last]) {
+                keep[e] = 1;
+                last = e;
+            }
+        }
+    };
+    if (m < MIN_EDGES_FOR_PARALLEL_PRUNING) {
+        nrThreads = 1;
+    }
+    MaxPlus::parallelFor(0, n, front, nrThreads);
+
+    CompactMCMgraph result;
+    result.nodes = this->nodes;
+    for (unsigned int e = 0; e < m; e++) {
+        if (keep[e] == 0) {
+            continue;
+        }
+        result.src.push_back(this->src[e]);
+        result.dst.push_back(this->dst[e]);
+        result.w.push_back(this->w[e]);
+        result.d.push_back(this->d[e]);
+        result.edges.push_back(this->edges[e]);
+    }
+    result.buildAdjacency();
+    return result;
+}
+
+void CompactMCMgraph::buildAdjacency() {
+    const auto n = static_cast<unsigned int>(this->nodes.size());
+    const auto m = static_cast<unsigned int>(this->edges.size());
+    this->outStart.assign(n + 1, 0);
+    this->inStart.assign(n + 1, 0);
+    for (unsigned int e = 0; e < m; e++) {
+        this->outStart[this->src[e] + 1]++;
+        this->inStart[this->dst[e] + 1]++;
+    }
+
+    // counting sort of the edges on source and on destination, which keeps
+    // the edges of a node in the order of the edge list
+    for (unsigned int v = 0; v < n; v++) {
+        this->outStart[v + 1] += this->outStart[v];
+        this->inStart[v + 1] += this->inStart[v];
+    }
+    this->outEdges.resize(m);
+    this->inEdges.resize(m);
+    std::vector<unsigned int> outPos(this->outStart.begin(), this->outStart.end() - 1);
+    std::vector<unsigned int> inPos(this->inStart.begin(), this->inStart.end() - 1);
+    for (unsigned int e = 0; e < m; e++) {
+        this->outEdges[outPos[this->src[e]]++] = e;
+        this->inEdges[inPos[this->dst[e]]++] = e;
+    }
+}
+
+/**
+ * nodesReachingCycles ()
+ * The function marks the nodes of g from which a cycle can be reached, by
+ * repeatedly removing nodes without outgoing edges.
+ */
+std::vector<bool> nodesReachingCycles(const CompactMCMgraph &g) {
+    const unsigned int n = g.nrNodes();
+    std::vector<bool> keep(n, true);
+    std::vector<unsigned int> outDegree(n);
+    std::vector<unsigned int> sinks;
+    for (unsigned int v = 0; v < n; v++) {
+        outDegree[v] = g.outEnd(v) - g.outBegin(v);
+        if (outDegree[v] == 0) {
+            sinks.push_back(v);
+        }
+    }
+    while (!sinks.empty()) {
+        unsigned int v = sinks.back();
+        sinks.pop_back();
+        keep[v] = false;
+        for (unsigned int i = g.inBegin(v); i < g.inEnd(v); i++) {
+            unsigned int u = g.source(g.inEdge(i));
+            if (--outDegree[u] == 0) {
+                sinks.push_back(u);
+            }
+        }
+    }
+    return keep;
+}
+
+/**
+ * findCycle ()
+ * The function searches a cycle of edges e with use[e] by a depth-first search
+ * over those edges.
+ */
+bool findCycle(const CompactMCMgraph &g,
+               const std::vector<bool> &use,
+               std::vector<unsigned int> *cycle) {
+    const unsigned int n = g.nrNodes();
+    // 0: not visited, 1: on the current path, 2: done
+    std::vector<unsigned char> state(n, 0);
+    std::vector<unsigned int> path;
+    std::vector<unsigned int> pathEdges;
+    std::vector<unsigned int> next;
+    for (unsigned int root = 0; root < n; root++) {
+        if (state[root] != 0) {
+            continue;
+        }
+        path.push_back(root);
+        next.push_back(g.outBegin(root));
+        state[root] = 1;
+        while (!path.empty()) {
+            const unsigned int u = path.back();
+            if (next.back() == g.outEnd(u)) {
+                state[u] = 2;
+                path.pop_back();
+                next.pop_back();
+                if (!pathEdges.empty()) {
+                    pathEdges.pop_back();
+                }
+                continue;
+            }
+            const unsigned int e = g.outEdge(next.back()++);
+            if (!use[e]) {
+                continue;
+            }
+            const unsigned int v = g.destination(e);
+            if (state[v] == 1) {
+                // the path from v to u closed by e
+                const auto pos = static_cast<size_t>(std::find(path.begin(), path.end(), v)
+                                                     - path.begin());
+                cycle->clear();
+                for (size_t i = pos; i < pathEdges.size(); i++) {
+                    cycle->push_back(pathEdges[i]);
+                }
+                cycle->push_back(e);
+                return true;
+            }
+            if (state[v] == 0) {
+                state[v] = 1;
+                path.push_back(v);
+                next.push_back(g.outBegin(v));
+                pathEdges.push_back(e);
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * stronglyConnectedComponents ()
+ * The function numbers the strongly connected components of the graph of the
+ * edges e with use[e] with Tarjan's algorithm. The depth-first search keeps
+ * its own stack, so that long paths do not exhaust the call stack.
+ */
+unsigned int stronglyConnectedComponents(const CompactMCMgraph &g,
+                                         const std::vector<bool> &use,
+                                         std::vector<unsigned int> *component) {
+    const unsigned int n = g.nrNodes();
+    const unsigned int unvisited = n;
+    std::vector<unsigned int> index(n, unvisited);
+    std::vector<unsigned int> low(n);
+    std::vector<bool> onStack(n, false);
+    std::vector<unsigned int> stack;
+    // the nodes on the current path with the position of their next outgoing edge
+    std::vector<std::pair<unsigned int, unsigned int>> path;
+    component->assign(n, 0);
+
+    unsigned int counter = 0;
+    unsigned int nrComponents = 0;
+    for (unsigned int root = 0; root < n; root++) {
+        if (index[root] != unvisited) {
+            continue;
+        }
+        index[root] = low[root] = counter++;
+        stack.push_back(root);
+        onStack[root] = true;
+        path.emplace_back(root, g.outBegin(root));
+        while (!path.empty()) {
+            const unsigned int u = path.back().first;
+            if (path.back().second < g.outEnd(u)) {
+                const unsigned int e = g.outEdge(path.back().second++);
+                if (!use[e]) {
+                    continue;
+                }
+                const unsigned int v = g.destination(e);
+                if (index[v] == unvisited) {
+                    index[v] = low[v] = counter++;
+                    stack.push_back(v);
+                    onStack[v] = true;
+                    path.emplace_back(v, g.outBegin(v));
+                } else if (onStack[v]) {
+                    low[u] = std::min(low[u], index[v]);
+                }
+                continue;
+            }
+
+            // all successors of u are done, u is the root of a component if it
+            // cannot reach a node higher up on the stack
+            if (low[u] == index[u]) {
+                unsigned int v = 0;
+                do {
+                    v = stack.back();
+                    stack.pop_back();
+                    onStack[v] = false;
+                    (*component)[v] = nrComponents;
+                } while (v != u);
+                nrComponents++;
+            }
+            path.pop_back();
+            if (!path.empty()) {
+                const unsigned int p = path.back().first;
+                low[p] = std::min(low[p], low[u]);
+            }
+        }
+    }
+    return nrComponents;
+}
+
+/**
+ * decomposeComponents ()
+ * The function numbers the components with Tarjan's algorithm and groups the
+ * nodes and the edges by component with counting sorts, which keeps them in
+ * increasing order within each component.
+ */
+ComponentDecomposition decomposeComponents(const CompactMCMgraph &g) {
+    const unsigned int n = g.nrNodes();
+    const unsigned int m = g.nrEdges();
+    ComponentDecomposition result;
+    result.nrComponents =
+            stronglyConnectedComponents(g, std::vector<bool>(m, true), &result.component);
+    const unsigned int nrComponents = result.nrComponents;
+
+    // nodes by component
+    result.nodeStart.assign(nrComponents + 1, 0);
+    for (unsigned int v = 0; v < n; v++) {
+        result.nodeStart[result.component[v] + 1]++;
+    }
+    for (unsigned int c = 0; c < nrComponents; c++) {
+        result.nodeStart[c + 1] += result.nodeStart[c];
+    }
+    result.nodes.resize(n);
+    result.position.resize(n);
+    std::vector<unsigned int> next(result.nodeStart.begin(), result.nodeStart.end() - 1);
+    for (unsigned int v = 0; v < n; v++) {
+        const unsigned int c = result.component[v];
+        result.position[v] = next[c] - result.nodeStart[c];
+        result.nodes[next[c]++] = v;
+    }
+
+    // edges inside a component by component, the others in the cross edges
+    result.edgeStart.assign(nrComponents + 1, 0);
+    for (unsigned int e = 0; e < m; e++) {
+        const unsigned int c = result.component[g.source(e)];
+        if (c == result.component[g.destination(e)]) {
+            result.edgeStart[c + 1]++;
+        } else {
+            result.crossEdges.push_back(e);
+        }
+    }
+    for (unsigned int c = 0; c < nrComponents; c++) {
+        result.edgeStart[c + 1] += result.edgeStart[c];
+    }
+    result.edges.resize(result.edgeStart[nrComponents]);
+    next.assign(result.edgeStart.begin(), result.edgeStart.end() - 1);
+    for (unsigned int e = 0; e < m; e++) {
+        const unsigned int c = result.component[g.source(e)];
+        if (c == result.component[g.destination(e)]) {
+            result.edges[next[c]++] = e;
+        }
+    }
+
+    // the condensation, from the out-edges of the nodes of every component;
+    // lastSeen removes the duplicates
+    const unsigned int none = nrComponents;
+    std::vector<unsigned int> lastSeen(nrComponents, none);
+    result.successorStart.assign(nrComponents + 1, 0);
+    for (unsigned int c = 0; c < nrComponents; c++) {
+        for (unsigned int i = result.nodeStart[c]; i < result.nodeStart[c + 1]; i++) {
+            const unsigned int u = result.nodes[i];
+            for (unsigned int j = g.outBegin(u); j < g.outEnd(u); j++) {
+                const unsigned int d = result.component[g.destination(g.outEdge(j))];
+                if (d != c && lastSeen[d] != c) {
+                    lastSeen[d] = c;
+                    result.successors.push_back(d);
+                }
+            }
+        }
+        result.successorStart[c + 1] = static_cast<unsigned int>(result.successors.size());
+    }
+    return result;
+}
+
+} // namespace Graphs
@@ -0,0 +1,129 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmcritical.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Critical graph of the maximum cycle mean.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmcritical.h"
+#include "base/analysis/mcm/mcmhoward.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Graphs {
+
+namespace {
+
+// Reduced weights are taken as zero up to this fraction of the weight range,
+// which matches the termination test of Howard's algorithm.
+constexpr CDouble CRITICAL_EPSILON_FACTOR = 1e-9;
+
+} // namespace
+
+/**
+ * criticalGraph ()
+ * Howard's algorithm runs on the nodes that can reach a cycle. Its optimal
+ * policy gives every node the maximum cycle mean chi reachable from it and a
+ * bias v. For an edge (u, v) between nodes with the maximum chi, the bias
+ * satisfies v(u) >= w - chi + v(v) up to the termination tolerance, with
+ * equality on the edges of critical cycles.
+ */
+CriticalGraph criticalGraph(const CompactMCMgraph &g) {
+    CriticalGraph result;
+
+    const CompactMCMgraph core = g.subgraph(nodesReachingCycles(g));
+    if (core.nrNodes() == 0) {
+        return result;
+    }
+
+    HowardState state;
+    convertMCMgraphToMatrix(core, state);
+    Howard(state);
+
+    const unsigned int n = core.nrNodes();
+    const unsigned int m = core.nrEdges();
+    const CDouble mcm = *std::max_element(state.chi.begin(), state.chi.end());
+    const auto [minW, maxW] = std::minmax_element(core.weights().begin(), core.weights().end());
+    const CDouble epsilon =
+            CRITICAL_EPSILON_FACTOR * std::max({*maxW - *minW, std::fabs(*maxW), std::fabs(*minW)});
+    result.mcm = mcm;
+
+    // the tight edges between nodes with the maximum cycle mean
+    std::vector<bool> critical(n);
+    for (unsigned int v = 0; v < n; v++) {
+        critical[v] = state.chi[v] >= mcm - epsilon;
+    }
+    std::vector<bool> tight(m);
+    for (unsigned int e = 0; e < m; e++) {
+        const unsigned int u = core.source(e);
+        const unsigned int v = core.destination(e);
+        tight[e] = critical[u] && critical[v]
+                   && std::fabs(core.weight(e) - mcm + state.v[v] - state.v[u]) <= epsilon;
+    }
+
+    // every cycle of tight edges is critical, the tight edges inside a strongly
+    // connected component of tight edges are the critical edges
+    std::vector<unsigned int> component;
+    const unsigned int nrComponents = stronglyConnectedComponents(core, tight, &component);
+    std::vector<bool> hasCriticalEdge(nrComponents, false);
+    for (unsigned int e = 0; e < m; e++) {
+        tight[e] = tight[e] && component[core.source(e)] == component[core.destination(e)];
+        if (tight[e]) {
+            hasCriticalEdge[component[core.source(e)]] = true;
+        }
+    }
+
+    // number the components with a critical edge in the order of their first node
+    std::vector<unsigned int> position(nrComponents, nrComponents);
+    for (unsigned int v = 0; v < n; v++) {
+        const unsigned int c = component[v];
+        if (!hasCriticalEdge[c]) {
+            continue;
+        }
+        if (position[c] == nrComponents) {
+            position[c] = static_cast<unsigned int>(result.components.size());
+            result.components.emplace_back();
+        }
+        result.components[position[c]].nodes.push_back(core.node(v));
+    }
+    for (unsigned int e = 0; e < m; e++) {
+        if (tight[e]) {
+            result.components[position[component[core.source(e)]]].edges.push_back(core.edge(e));
+        }
+    }
+    return result;
+}
+
+CriticalGraph criticalGraph(MCMgraph &g) { return criticalGraph(CompactMCMgraph(g)); }
+
+} // namespace Graphs
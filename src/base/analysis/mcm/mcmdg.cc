@@ -48,8 +48,10 @@
  *  SOFTWARE.
  */
 
+#include "base/analysis/mcm/mcmcompact.h"
 #include "base/analysis/mcm/mcmgraph.h"
 #include "base/math/cmath.h"
+#include <cfloat>
 #include <climits>
 #include <cmath>
 #include <memory>
@@ -145,4 +147,78 @@ CDouble mcmDG(MCMgraph &mcmGraph) {
     return mcm;
 }
 
-} // namespace Graphs
\ No newline at end of file
+/**
+ * mcmDG ()
+ * The function computes the maximum cycle mean of a compact graph using
+ * Dasdan-Gupta's algorithm. Instead of analysing every strongly connected
+ * component separately, the graph is extended with a virtual source node n
+ * that has an edge of weight 0 to every node, so that one breadth-first
+ * unfolding from this source covers the whole graph. Distances are kept as
+ * doubles, hence the edge weights need not be integer valued. If the graph
+ * has no cycles, -INFINITY is returned.
+ */
+CDouble mcmDG(const CompactMCMgraph &g) {
+
+    // nodes 0..n-1 of the graph plus the virtual source n, unfolded to depth N
+    const unsigned int n = g.nrNodes();
+    const unsigned int N = n + 1;
+    const auto stride = static_cast<size_t>(N);
+    std::vector<int> level(N, -1);
+    std::vector<int> pi((N + 1) * stride);
+    std::vector<CDouble> d((N + 1) * stride);
+
+    // Initialize
+    d[n] = 0.0;
+    pi[n] = -1;
+    level[n] = 0;
+    std::vector<std::pair<unsigned int, unsigned int>> Q;
+    Q.emplace_back(0, n);
+
+    // Compute the distances
+    for (size_t head = 0; head < Q.size(); head++) {
+        const unsigned int k = Q[head].first;
+        const unsigned int u = Q[head].second;
+        if (k >= N) {
+            break;
+        }
+        const CDouble du = d[k * stride + u];
+        const auto relax = [&](unsigned int v, CDouble w) {
+            const size_t kv = (k + 1) * stride + v;
+            if (level[v] < static_cast<int>(k + 1)) {
+                Q.emplace_back(k + 1, v);
+                pi[kv] = level[v];
+                level[v] = static_cast<int>(k + 1);
+                d[kv] = -DBL_MAX;
+            }
+            d[kv] = MAX(d[kv], du + w);
+        };
+        if (u == n) {
+            for (unsigned int v = 0; v < n; v++) {
+                relax(v, 0.0);
+            }
+        } else {
+            for (unsigned int i = g.outBegin(u); i < g.outEnd(u); i++) {
+                const unsigned int e = g.outEdge(i);
+                relax(g.destination(e), g.weight(e));
+            }
+        }
+    }
+
+    // Compute lambda using Karp's theorem
+    auto l = static_cast<CDouble>(-INFINITY);
+    for (unsigned int u = 0; u < n; u++) {
+        if (level[u] == static_cast<int>(N)) {
+            CDouble ld = DBL_MAX;
+            int k = pi[N * stride + u];
+            while (k > -1) {
+                ld = MIN(ld, (d[N * stride + u] - d[k * stride + u]) / (CDouble)(N - k));
+                k = pi[k * stride + u];
+            }
+            l = MAX(l, ld);
+        }
+    }
+
+    return l;
+}
+
+} // namespace Graphs
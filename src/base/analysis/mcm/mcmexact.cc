@@ -0,0 +1,311 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmexact.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Exact maximum cycle mean and ratio of integer weighted graphs
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmexact.h"
+#include "base/analysis/mcm/mcmhoward.h"
+#include "base/exception/exception.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+
+using namespace MaxPlus;
+
+namespace Graphs {
+
+namespace {
+
+__extension__ using Int128 = __int128;
+
+constexpr std::int64_t INT64_MAXIMUM = std::numeric_limits<std::int64_t>::max();
+constexpr std::int64_t INT64_MINIMUM = std::numeric_limits<std::int64_t>::min();
+
+Int128 checkedAdd(Int128 a, Int128 b) {
+    Int128 r = 0;
+    if (__builtin_add_overflow(a, b, &r)) {
+        throw MPException("Overflow in the exact cycle ratio computation.");
+    }
+    return r;
+}
+
+std::int64_t toInt64(Int128 a) {
+    if (a > INT64_MAXIMUM || a < INT64_MINIMUM) {
+        throw MPException("Overflow in the exact cycle ratio computation.");
+    }
+    return static_cast<std::int64_t>(a);
+}
+
+std::int64_t toInt64(CDouble x) {
+    // 2^63 is the smallest double above the range of std::int64_t
+    if (x != std::floor(x) || x >= 9223372036854775808.0 || x < -9223372036854775808.0) {
+        throw MPException("Exact cycle ratios require integer weights and delays.");
+    }
+    return static_cast<std::int64_t>(x);
+}
+
+/**
+ * A cycle with the largest ratio as estimated by Howard's algorithm, or just
+ * any cycle if Howard's algorithm does not converge. Every node of g must have
+ * an outgoing edge and every cycle a positive delay.
+ */
+std::vector<unsigned int> initialCycle(const CompactMCMgraph &g,
+                                       const std::vector<std::int64_t> &w,
+                                       const std::vector<std::int64_t> &d) {
+    const unsigned int m = g.nrEdges();
+    std::vector<int> ij(2 * static_cast<size_t>(m));
+    std::vector<CDouble> A(m);
+    std::vector<CDouble> T(m);
+    for (unsigned int e = 0; e < m; e++) {
+        ij[2 * static_cast<size_t>(e)] = static_cast<int>(g.source(e));
+        ij[2 * static_cast<size_t>(e) + 1] = static_cast<int>(g.destination(e));
+        A[e] = static_cast<CDouble>(w[e]);
+        T[e] = static_cast<CDouble>(d[e]);
+    }
+
+    std::shared_ptr<std::vector<CDouble>> chi = nullptr;
+    std::shared_ptr<std::vector<CDouble>> v = nullptr;
+    std::shared_ptr<std::vector<int>> policy = nullptr;
+    int nr_iterations = 0;
+    int nr_components = 0;
+    try {
+        Howard(ij,
+               A,
+               T,
+               static_cast<int>(g.nrNodes()),
+               static_cast<int>(m),
+               &chi,
+               &v,
+               &policy,
+               &nr_iterations,
+               &nr_components);
+    } catch (const MPException &) {
+        std::vector<unsigned int> cycle;
+        findCycle(g, std::vector<bool>(m, true), &cycle);
+        return cycle;
+    }
+
+    unsigned int critical = 0;
+    for (unsigned int i = 1; i < g.nrNodes(); i++) {
+        if ((*chi)[i] > (*chi)[critical]) {
+            critical = i;
+        }
+    }
+    for (unsigned int e = 0; e < m; e++) {
+        A[e] -= (*chi)[critical] * T[e];
+    }
+    return policyCycle(g, A, *policy, critical);
+}
+
+/**
+ * Find a cycle in the graph of the parent edges of a Bellman-Ford search.
+ */
+bool parentCycle(const CompactMCMgraph &g,
+                 const std::vector<unsigned int> &parent,
+                 std::vector<unsigned int> *cycle) {
+    const unsigned int n = g.nrNodes();
+    const unsigned int none = g.nrEdges();
+    std::vector<unsigned int> mark(n, n);
+    for (unsigned int s = 0; s < n; s++) {
+        unsigned int v = s;
+        while (mark[v] == n && parent[v] != none) {
+            mark[v] = s;
+            v = g.source(parent[v]);
+        }
+        if (mark[v] != s || parent[v] == none) {
+            continue;
+        }
+        // v is on a cycle of parent edges, collect it backwards
+        cycle->clear();
+        unsigned int u = v;
+        do {
+            cycle->push_back(parent[u]);
+            u = g.source(parent[u]);
+        } while (u != v);
+        std::reverse(cycle->begin(), cycle->end());
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Search a cycle with a ratio larger than p/q, i.e., a positive cycle for the
+ * edge weights q * w - p * d, with a Bellman-Ford search for longest paths.
+ * The graph of parent edges is checked for a cycle after rounds 1, 2, 4, ...
+ * and after round n; every cycle in it is positive.
+ */
+bool betterCycle(const CompactMCMgraph &g,
+                 const std::vector<std::int64_t> &w,
+                 const std::vector<std::int64_t> &d,
+                 std::int64_t p,
+                 std::int64_t q,
+                 std::vector<unsigned int> *cycle) {
+    const unsigned int n = g.nrNodes();
+    const unsigned int m = g.nrEdges();
+    // |q * w - p * d| < 2^127, these do not overflow
+    std::vector<Int128> r(m);
+    for (unsigned int e = 0; e < m; e++) {
+        r[e] = static_cast<Int128>(q) * w[e] - static_cast<Int128>(p) * d[e];
+    }
+
+    std::vector<Int128> dist(n, 0);
+    std::vector<unsigned int> parent(n, m);
+    unsigned int nextCheck = 1;
+    for (unsigned int round = 1; round <= n; round++) {
+        bool changed = false;
+        for (unsigned int e = 0; e < m; e++) {
+            const Int128 l = checkedAdd(dist[g.source(e)], r[e]);
+            if (l > dist[g.destination(e)]) {
+                dist[g.destination(e)] = l;
+                parent[g.destination(e)] = e;
+                changed = true;
+            }
+        }
+        if (!changed) {
+            return false;
+        }
+        if (round == nextCheck || round == n) {
+            nextCheck *= 2;
+            if (parentCycle(g, parent, cycle)) {
+                return true;
+            }
+        }
+    }
+    throw MPException("Positive cycle not found in the exact cycle ratio computation.");
+}
+
+CFraction cycleRatioExact(const CompactMCMgraph &g,
+                          const std::vector<std::int64_t> &weights,
+                          const std::vector<std::int64_t> &delays,
+                          std::vector<const MCMedge *> *cycle) {
+    const unsigned int m = g.nrEdges();
+    if (weights.size() != m || delays.size() != m) {
+        throw MPException("Number of weights or delays differs from the number of edges.");
+    }
+    std::vector<bool> zeroDelay(m);
+    for (unsigned int e = 0; e < m; e++) {
+        if (delays[e] < 0) {
+            throw MPException("Exact cycle ratios require non-negative delays.");
+        }
+        zeroDelay[e] = delays[e] == 0;
+    }
+    std::vector<unsigned int> best;
+    if (findCycle(g, zeroDelay, &best)) {
+        if (cycle != nullptr) {
+            *cycle = g.originalEdges(best);
+        }
+        return CFraction(static_cast<CDouble>(INFINITY));
+    }
+
+    // restrict the graph to the nodes that reach a cycle
+    const std::vector<bool> keep = nodesReachingCycles(g);
+    const CompactMCMgraph core = g.subgraph(keep);
+    if (core.nrNodes() == 0) {
+        if (cycle != nullptr) {
+            cycle->clear();
+        }
+        return CFraction(static_cast<CDouble>(-INFINITY));
+    }
+    std::vector<std::int64_t> w;
+    std::vector<std::int64_t> d;
+    for (unsigned int e = 0; e < m; e++) {
+        if (keep[g.source(e)] && keep[g.destination(e)]) {
+            w.push_back(weights[e]);
+            d.push_back(delays[e]);
+        }
+    }
+
+    // improve the cycle until it is optimal
+    best = initialCycle(core, w, d);
+    std::int64_t p = 0;
+    std::int64_t q = 1;
+    do {
+        Int128 sumW = 0;
+        Int128 sumD = 0;
+        for (unsigned int e : best) {
+            sumW += w[e];
+            sumD += d[e];
+        }
+        p = toInt64(sumW);
+        q = toInt64(sumD);
+    } while (betterCycle(core, w, d, p, q, &best));
+
+    if (cycle != nullptr) {
+        *cycle = core.originalEdges(best);
+    }
+    const auto divisor = static_cast<std::int64_t>(
+            std::gcd(p < 0 ? 0 - static_cast<std::uint64_t>(p) : static_cast<std::uint64_t>(p),
+                     static_cast<std::uint64_t>(q)));
+    return CFraction(p / divisor, q / divisor);
+}
+
+} // namespace
+
+CFraction maximumCycleRatioExact(const CompactMCMgraph &g,
+                                 const std::vector<std::int64_t> &weights,
+                                 const std::vector<std::int64_t> &delays,
+                                 std::vector<const MCMedge *> *cycle) {
+    return cycleRatioExact(g, weights, delays, cycle);
+}
+
+CFraction maximumCycleMeanExact(const CompactMCMgraph &g,
+                                const std::vector<std::int64_t> &weights,
+                                std::vector<const MCMedge *> *cycle) {
+    return cycleRatioExact(g, weights, std::vector<std::int64_t>(g.nrEdges(), 1), cycle);
+}
+
+CFraction maximumCycleRatioExact(MCMgraph &g, std::vector<const MCMedge *> *cycle) {
+    const CompactMCMgraph c(g);
+    std::vector<std::int64_t> weights(c.nrEdges());
+    std::vector<std::int64_t> delays(c.nrEdges());
+    for (unsigned int e = 0; e < c.nrEdges(); e++) {
+        weights[e] = toInt64(c.weight(e));
+        delays[e] = toInt64(c.delay(e));
+    }
+    return cycleRatioExact(c, weights, delays, cycle);
+}
+
+CFraction maximumCycleMeanExact(MCMgraph &g, std::vector<const MCMedge *> *cycle) {
+    const CompactMCMgraph c(g);
+    std::vector<std::int64_t> weights(c.nrEdges());
+    for (unsigned int e = 0; e < c.nrEdges(); e++) {
+        weights[e] = toInt64(c.weight(e));
+    }
+    return maximumCycleMeanExact(c, weights, cycle);
+}
+
+} // namespace Graphs
@@ -42,10 +42,18 @@
 #include "base/analysis/mcm/mcmgraph.h"
 #include "base/analysis/mcm/mcm.h"
 #include "base/analysis/mcm/mcmyto.h"
+#include "base/exception/exception.h"
+#include "base/parallel/parallel.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <deque>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 namespace Graphs {
@@ -100,6 +108,173 @@ MCMedge::MCMedge(CId eId, MCMnode &src, MCMnode &dst, CDouble w, CDouble d, bool
  */
 MCMnode::MCMnode(CId nId, bool nVisible) : id(nId), visible(nVisible) {}
 
+/**
+ * addNode ()
+ * Add a node to the graph and to its indices.
+ */
+MCMnode *MCMgraph::addNode(CId nId, bool nVisible) {
+    MCMnode &n = this->nodes.emplace_back(nId, nVisible);
+    this->nodePositions.emplace(&n, std::prev(this->nodes.end()));
+    this->nodeIndex.emplace(nId, &n);
+    return &n;
+}
+
+/**
+ * removeNode ()
+ * Remove a node and its remaining edges from the graph.
+ */
+void MCMgraph::removeNode(MCMnode &n) {
+    // remove any remaining edges
+    while (!n.in.empty()) {
+        this->removeEdge(**(n.in.begin()));
+    }
+    while (!n.out.empty()) {
+        this->removeEdge(**(n.out.begin()));
+    }
+    auto pos = this->nodePositions.find(&n);
+    assert(pos != this->nodePositions.end());
+    auto it = pos->second;
+    this->nodePositions.erase(pos);
+
+    // if the id has changed since the node was indexed, the index may still
+    // refer to it under its old id and it is rebuilt without the node
+    auto idx = this->nodeIndex.find(n.id);
+    if (idx != this->nodeIndex.end() && idx->second == &n) {
+        this->nodeIndex.erase(idx);
+        this->nodes.erase(it);
+    } else {
+        this->nodes.erase(it);
+        this->reindexNodes();
+    }
+}
+
+/**
+ * addEdge ()
+ * Add an edge to the graph and to its indices.
+ */
+MCMedge *
+MCMgraph::addEdge(CId id, MCMnode &src, MCMnode &dst, CDouble w, CDouble d, bool visible) {
+    MCMedge &e = this->edges.emplace_back(id, src, dst, w, d, visible);
+    src.out.push_back(&e);
+    dst.in.push_back(&e);
+    this->edgePositions.emplace(&e, std::prev(this->edges.end()));
+    this->edgeIndex.emplace(id, &e);
+    return &e;
+}
+
+/**
+ * removeEdge ()
+ * Remove an edge from the graph.
+ */
+void MCMgraph::removeEdge(MCMedge &e) {
+    e.src->out.remove(&e);
+    e.dst->in.remove(&e);
+    auto pos = this->edgePositions.find(&e);
+    assert(pos != this->edgePositions.end());
+    auto it = pos->second;
+    this->edgePositions.erase(pos);
+
+    // if the id has changed since the edge was indexed, the index may still
+    // refer to it under its old id and it is rebuilt without the edge
+    auto idx = this->edgeIndex.find(e.id);
+    if (idx != this->edgeIndex.end() && idx->second == &e) {
+        this->edgeIndex.erase(idx);
+        this->edges.erase(it);
+    } else {
+        this->edges.erase(it);
+        this->reindexEdges();
+    }
+}
+
+/**
+ * getNode ()
+ * Lookup a node by id in the index.
+ */
+MCMnode *MCMgraph::getNode(CId id) {
+    auto idx = this->nodeIndex.find(id);
+    if (idx == this->nodeIndex.end()) {
+        return nullptr;
+    }
+    assert(idx->second->id == id);
+    return idx->second;
+}
+
+/**
+ * getEdge ()
+ * Lookup an edge by id in the index.
+ */
+MCMedge *MCMgraph::getEdge(CId id) {
+    auto idx = this->edgeIndex.find(id);
+    if (idx == this->edgeIndex.end()) {
+        return nullptr;
+    }
+    assert(idx->second->id == id);
+    return idx->second;
+}
+
+/**
+ * setNodeId ()
+ * Change the id of a node. The node replaces any node indexed under the new id,
+ * so that a sequence of changes that renumbers all nodes leaves a valid index.
+ */
+void MCMgraph::setNodeId(MCMnode &n, CId id) {
+    auto idx = this->nodeIndex.find(n.id);
+    if (idx != this->nodeIndex.end() && idx->second == &n) {
+        this->nodeIndex.erase(idx);
+    }
+    n.id = id;
+    this->nodeIndex[id] = &n;
+}
+
+/**
+ * setEdgeId ()
+ * Change the id of an edge, as setNodeId.
+ */
+void MCMgraph::setEdgeId(MCMedge &e, CId id) {
+    auto idx = this->edgeIndex.find(e.id);
+    if (idx != this->edgeIndex.end() && idx->second == &e) {
+        this->edgeIndex.erase(idx);
+    }
+    e.id = id;
+    this->edgeIndex[id] = &e;
+}
+
+/**
+ * getEdge ()
+ * Lookup an edge by the ids of its source and destination nodes.
+ */
+MCMedge *MCMgraph::getEdge(CId srcId, CId dstId) {
+    MCMnode *src = this->getNode(srcId);
+    if (src == nullptr) {
+        return nullptr;
+    }
+    for (auto *edge : src->out) {
+        if (edge->dst->id == dstId) {
+            return edge;
+        }
+    }
+    return nullptr;
+}
+
+void MCMgraph::reindexNodes() {
+    this->nodeIndex.clear();
+    for (auto &node : this->nodes) {
+        this->nodeIndex.emplace(node.id, &node);
+    }
+}
+
+void MCMgraph::reserveEdges(size_t nrEdges) {
+    this->edgePositions.reserve(nrEdges);
+    this->edgeIndex.reserve(nrEdges);
+}
+
+void MCMgraph::reindexEdges() {
+    this->edgeIndex.clear();
+    for (auto &edge : this->edges) {
+        this->edgeIndex.emplace(edge.id, &edge);
+    }
+}
+
 /**
  * splitMCMedgeToSequence ()
  * The function converts an MCM edge with more than one delay
@@ -114,20 +289,13 @@ static void splitMCMedgeToSequence(MCMgraph &g, MCMedge &e) {
     // dummy node.
     MCMedge *eN = g.addEdge(static_cast<CId>(g.getEdges().size()), *e.src, *n, 0, e.d - 1);
 
-    // Remove e from the set of edges its source node is connected to
-    // and add eN to this list
-    for (auto iter = e.src->out.begin(); iter != e.src->out.end(); iter++) {
-        if ((*iter)->id == e.id) {
-            e.src->out.erase(iter);
-            break;
-        }
-    }
-    e.src->out.push_back(eN);
+    // Remove e from the set of edges its source node is connected to,
+    // addEdge has already added eN to it and to the in-edges of n
+    e.src->out.remove(&e);
 
     // Connect e to node n
     e.src = n;
     n->out.push_back(&e);
-    n->in.push_back(eN);
 
     // One delay left on e
     e.d = 1;
@@ -139,105 +307,46 @@ static void splitMCMedgeToSequence(MCMgraph &g, MCMedge &e) {
 }
 
 /**
- * addLongestDelayEdgeForNode ()
- * The function add an additional edge between the node n and any node
- * reachable over e which only uses edges with no initial delays (except
- * for the initial edge e). The weight of the new edge is the longest
- * path from the node n to the destination node.
- * The function uses an adapted version of Dijkstra's shortest path
- * algorithm.
- * Note: algorithm assumes that edge weights are integer values !
+ * The longest paths from the different nodes are computed on the calling
+ * thread if the number of nodes times the number of sources is below this.
  */
-static void addLongestDelayEdgeForNode(MCMgraph &g, MCMnode &n, MCMedge &e) {
-    std::vector<int> d(g.getNodes().size());
-    std::vector<const MCMnode *> pi(g.getNodes().size());
-    MCMnodeRefs S;
-    MCMnodeRefs Q = g.getNodeRefs();
-
-    // Initialize single source
-    for (uint v = 0; v < g.getNodes().size(); v++) {
-        d[v] = -1;
-        pi[v] = nullptr;
-    }
-    d[n.id] = 0;
-
-    // Initialize the node connected via the edge e to n
-    d[e.dst->id] = static_cast<int>(e.w);
-
-    // Remove node n from Q and add it to S (only when edge e is no
-    // self-edge)
-    if (e.dst->id != n.id) {
-        for (auto iter = Q.begin(); iter != Q.end(); iter++) {
-            if ((*iter)->id == n.id) {
-                // Is edge e
-                Q.erase(iter);
-                break;
-            }
-        }
-        S.push_back(&n);
-    }
-
-    // Find all longest paths till Q is empty or all reachable paths seen
-    while (!Q.empty()) {
-        MCMnode *u = nullptr;
-
-        // Find node u in Q with largest distance
-        int dMax = -1;
-        for (auto &iter : Q) {
-            if (d[iter->id] > dMax) {
-                u = iter;
-                dMax = d[u->id];
-            }
-        }
-
-        // Found no node with a non-negative distance ?
-        if (dMax < 0) {
-            break;
-        }
-
-        // Remove node u from Q and add it to S
-        for (auto iter = Q.begin(); iter != Q.end(); iter++) {
-            if ((*iter)->id == u->id) {
-                Q.erase(iter);
-                break;
-            }
-        }
-        S.push_back(u);
+constexpr size_t MIN_WORK_FOR_PARALLEL_PATHS = 65536;
 
-        // Relax all nodes v adjacent to u (connected via edges with no tokens)
-        for (auto iter = u->out.begin(); iter != u->out.end(); iter++) {
-            const MCMedge *e = *iter;
-            MCMnode *v = e->dst;
+/**
+ * Longest paths over edges without delay, from one node to every node that is
+ * reachable from it. The nodes are indices into the node list of the graph.
+ */
+struct ZeroDelayPaths {
+    std::vector<unsigned int> nodes;
+    std::vector<CDouble> lengths;
+};
 
-            if (e->d == 0 && d[v->id] < d[u->id] + e->w) {
-                if (d[v->id] != -1) {
-                    // Found a longer path to v, add it to list of
-                    // nodes to be checked (again).
-                    Q.push_back(v);
+/**
+ * hasPositiveCycle ()
+ * Whether the graph with n nodes and the edges from u to dst[i] with weight
+ * w[i] for start[u] <= i < start[u + 1] has a cycle of positive weight, by
+ * Bellman-Ford rounds from all nodes at once.
+ */
+static bool hasPositiveCycle(unsigned int n,
+                             const std::vector<unsigned int> &start,
+                             const std::vector<unsigned int> &dst,
+                             const std::vector<CDouble> &w) {
+    std::vector<CDouble> dist(n, 0.0);
+    for (unsigned int round = 0; round < n; round++) {
+        bool changed = false;
+        for (unsigned int u = 0; u < n; u++) {
+            for (unsigned int i = start[u]; i < start[u + 1]; i++) {
+                if (dist[u] + w[i] > dist[dst[i]]) {
+                    dist[dst[i]] = dist[u] + w[i];
+                    changed = true;
                 }
-
-                d[v->id] = d[u->id] + static_cast<int>(e->w);
-                pi[v->id] = u;
             }
         }
-    }
-
-    // Add an edge between the node n and any node m reachable from n
-    // with a weight equal to the longest path from n to m
-    for (auto &m : S) {
-        // Node m reachable from n and not connected directly to n via e?
-        if (d[m->id] > 0 && e.dst->id != m->id) {
-            // Create an edge between n and m
-            MCMedge *eN = g.addEdge(static_cast<CId>(g.getEdges().size()),
-                                    n,
-                                    *m,
-                                    d[m->id],
-                                    e.d,
-                                    false); // e.d should always be 1
-            n.out.push_back(eN);
-            m->in.push_back(eN);
+        if (!changed) {
+            return false;
         }
     }
+    return true;
 }
 
 /**
@@ -246,8 +355,18 @@ static void addLongestDelayEdgeForNode(MCMgraph &g, MCMnode &n, MCMedge &e) {
  * longest path between two nodes crossing one edge with a delay. Edges
  * with no delay are removed and edges with more than one delay element
  * are converted into a sequence of edges with one delay element.
+ *
+ * For every edge e from n to x with a delay, an edge is added from n to every
+ * other node m reachable from x over edges without delay, with as weight the
+ * weight of e plus the longest such path from x to m. The subgraph of edges
+ * without delay is ordered topologically once, after which the longest paths
+ * from every x follow from a single pass over the nodes in that order. If the
+ * edges without delay form cycles, which must then have no positive weight,
+ * the longest paths are found by label correcting instead. The paths from the
+ * different nodes x are computed in parallel and the new edges are added
+ * afterwards, in the order of the delayed edges.
  */
-void addLongestDelayEdgesToMCMgraph(MCMgraph &g) {
+void addLongestDelayEdgesToMCMgraph(MCMgraph &g, unsigned int nrThreads) {
 
     // Find longest path between a node n and a node m
     // over all sequences of edges in which only the
@@ -259,21 +378,155 @@ void addLongestDelayEdgesToMCMgraph(MCMgraph &g) {
         }
     }
 
-    // Find longest path between a node n and a node m
-    // over all sequences of edges in which only the
-    // first edge may contain a delay
-    for (auto &e : g.getEdgeRefs()) {
-        // Initial tokens on edge?
-        if (e->d != 0 && e->visible) {
-            // Find the longest path from n to any node m
-            // and add an edge with the path wait to the graph
-            addLongestDelayEdgeForNode(g, *e->src, *e);
+    // number the nodes and collect the edges without delay per source
+    std::unordered_map<const MCMnode *, unsigned int> index;
+    std::vector<MCMnode *> nodes;
+    for (auto &n : g.getNodes()) {
+        index.emplace(&n, static_cast<unsigned int>(nodes.size()));
+        nodes.push_back(&n);
+    }
+    const auto n = static_cast<unsigned int>(nodes.size());
+    std::vector<unsigned int> start(n + 1, 0);
+    std::vector<unsigned int> inDegree(n, 0);
+    for (const auto &e : g.getEdges()) {
+        if (e.d == 0) {
+            start[index[e.src] + 1]++;
+            inDegree[index[e.dst]]++;
+        }
+    }
+    for (unsigned int v = 0; v < n; v++) {
+        start[v + 1] += start[v];
+    }
+    std::vector<unsigned int> zeroDst(start[n]);
+    std::vector<CDouble> zeroW(start[n]);
+    std::vector<unsigned int> pos(start.begin(), start.end() - 1);
+    for (const auto &e : g.getEdges()) {
+        if (e.d == 0) {
+            const unsigned int i = pos[index[e.src]]++;
+            zeroDst[i] = index[e.dst];
+            zeroW[i] = e.w;
+        }
+    }
+
+    // order them topologically
+    std::vector<unsigned int> order;
+    order.reserve(n);
+    for (unsigned int v = 0; v < n; v++) {
+        if (inDegree[v] == 0) {
+            order.push_back(v);
+        }
+    }
+    for (size_t k = 0; k < order.size(); k++) {
+        for (unsigned int i = start[order[k]]; i < start[order[k] + 1]; i++) {
+            if (--inDegree[zeroDst[i]] == 0) {
+                order.push_back(zeroDst[i]);
+            }
+        }
+    }
+    const bool acyclic = order.size() == n;
+    if (!acyclic && hasPositiveCycle(n, start, zeroDst, zeroW)) {
+        throw MaxPlus::MPException("addLongestDelayEdgesToMCMgraph: the graph has a cycle "
+                                   "without delay and with a positive weight.");
+    }
+    std::vector<unsigned int> rank(n);
+    for (unsigned int k = 0; k < order.size(); k++) {
+        rank[order[k]] = k;
+    }
 
-            // Seen this edge (set it to invisible)
-            e->visible = false;
+    // the visible edges with a delay and the distinct nodes they point to
+    std::vector<MCMedge *> delayed;
+    std::vector<unsigned int> target(n, n);
+    std::vector<unsigned int> targets;
+    for (auto &e : g.getEdges()) {
+        if (e.d != 0 && e.visible) {
+            delayed.push_back(&e);
+            const unsigned int x = index[e.dst];
+            if (target[x] == n) {
+                target[x] = static_cast<unsigned int>(targets.size());
+                targets.push_back(x);
+            }
         }
     }
 
+    // longest paths without delay from every target
+    if (targets.size() * n < MIN_WORK_FOR_PARALLEL_PATHS) {
+        nrThreads = 1;
+    }
+    std::vector<ZeroDelayPaths> paths(targets.size());
+    MaxPlus::parallelFor(
+            0,
+            targets.size(),
+            [&](size_t t) {
+                const unsigned int x = targets[t];
+                std::vector<CDouble> dist(n, -INFINITY);
+                dist[x] = 0.0;
+                if (!acyclic) {
+                    // label correcting, it terminates since no cycle has a positive weight;
+                    // the nodes are listed in the order in which they are reached, x first
+                    std::vector<bool> queued(n, false);
+                    std::deque<unsigned int> queue{x};
+                    queued[x] = true;
+                    paths[t].nodes.push_back(x);
+                    while (!queue.empty()) {
+                        const unsigned int u = queue.front();
+                        queue.pop_front();
+                        queued[u] = false;
+                        for (unsigned int i = start[u]; i < start[u + 1]; i++) {
+                            const unsigned int v = zeroDst[i];
+                            if (dist[u] + zeroW[i] <= dist[v]) {
+                                continue;
+                            }
+                            if (dist[v] == -INFINITY) {
+                                paths[t].nodes.push_back(v);
+                            }
+                            dist[v] = dist[u] + zeroW[i];
+                            if (!queued[v]) {
+                                queued[v] = true;
+                                queue.push_back(v);
+                            }
+                        }
+                    }
+                    for (unsigned int u : paths[t].nodes) {
+                        paths[t].lengths.push_back(dist[u]);
+                    }
+                    return;
+                }
+                for (unsigned int k = rank[x]; k < n; k++) {
+                    const unsigned int u = order[k];
+                    if (dist[u] == -INFINITY) {
+                        continue;
+                    }
+                    paths[t].nodes.push_back(u);
+                    paths[t].lengths.push_back(dist[u]);
+                    for (unsigned int i = start[u]; i < start[u + 1]; i++) {
+                        dist[zeroDst[i]] = std::max(dist[zeroDst[i]], dist[u] + zeroW[i]);
+                    }
+                }
+            },
+            nrThreads);
+
+    // add an edge between the node n and any node m reachable from
+    // n with a weight equal to the longest path from n to m
+    size_t nrNewEdges = 0;
+    for (const MCMedge *e : delayed) {
+        nrNewEdges += paths[target[index[e->dst]]].nodes.size() - 1;
+    }
+    g.reserveEdges(g.getEdges().size() + nrNewEdges);
+    for (MCMedge *e : delayed) {
+        const ZeroDelayPaths &p = paths[target[index[e->dst]]];
+        // the first node on the paths is e.dst itself, which e already connects to
+        for (size_t i = 1; i < p.nodes.size(); i++) {
+            g.addEdge(static_cast<CId>(g.getEdges().size()),
+                      *e->src,
+                      *nodes[p.nodes[i]],
+                      e->w + p.lengths[i],
+                      e->d,
+                      false); // e.d should always be 1
+        }
+        // Seen this edge (set it to invisible)
+        e->visible = false;
+    }
+
     // Hide all edges which do not contain a delay
     for (auto &e : g.getEdges()) {
         // No initial tokens on edge?
@@ -601,6 +854,89 @@ void stronglyConnectedMCMgraph(MCMgraph &g,
     // cerr << "}" << endl;
 }
 
+/**
+ * Components with fewer edges than this in total are evaluated on the calling
+ * thread, as starting threads would cost more than it saves.
+ */
+constexpr size_t MIN_EDGES_FOR_PARALLEL_COMPONENTS = 4096;
+
+/**
+ * maximumCycleMeanOverComponents ()
+ * The function evaluates mcm on every strongly connected component of g and
+ * returns the maximum, optionally with a critical node in g.
+ */
+CDouble maximumCycleMeanOverComponents(
+        MCMgraph &g,
+        const std::function<CDouble(MCMgraph &scc, const MCMnode **criticalNode)> &mcm,
+        MCMnode **criticalNode,
+        unsigned int nrThreads) {
+    MCMgraphs sccList;
+    stronglyConnectedMCMgraph(g, sccList, false);
+    std::vector<std::shared_ptr<MCMgraph>> sccs(sccList.begin(), sccList.end());
+
+    if (criticalNode != nullptr) {
+        *criticalNode = nullptr;
+    }
+
+    const size_t nrComponents = sccs.size();
+    std::vector<std::map<CId, CId>> nodeMaps(nrComponents);
+    std::vector<size_t> order(nrComponents);
+    std::vector<size_t> sizes(nrComponents);
+    std::vector<CDouble> bounds(nrComponents, -INFINITY);
+    size_t totalEdges = 0;
+    for (size_t i = 0; i < nrComponents; i++) {
+        sccs[i]->relabelNodeIds(&nodeMaps[i]);
+        for (const auto &e : sccs[i]->getEdges()) {
+            bounds[i] = std::max(bounds[i], e.w);
+        }
+        sizes[i] = sccs[i]->numberOfNodes() + sccs[i]->numberOfEdges();
+        totalEdges += sccs[i]->numberOfEdges();
+        order[i] = i;
+    }
+
+    // largest components first
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+        return sizes[a] > sizes[b];
+    });
+
+    std::vector<CDouble> results(nrComponents, -INFINITY);
+    std::vector<const MCMnode *> criticalNodes(nrComponents, nullptr);
+    std::atomic<CDouble> best(-INFINITY);
+
+    const auto evaluate = [&](size_t t) {
+        const size_t i = order[t];
+        if (bounds[i] < best.load(std::memory_order_relaxed)) {
+            return;
+        }
+        CDouble cmcm = mcm(*sccs[i], &criticalNodes[i]);
+        results[i] = cmcm;
+        CDouble current = best.load(std::memory_order_relaxed);
+        while (cmcm > current
+               && !best.compare_exchange_weak(current, cmcm, std::memory_order_relaxed)) {
+        }
+    };
+    if (totalEdges < MIN_EDGES_FOR_PARALLEL_COMPONENTS) {
+        nrThreads = 1;
+    }
+    MaxPlus::parallelFor(0, nrComponents, evaluate, nrThreads);
+
+    // deterministic reduction in component order, skipped components keep
+    // -INFINITY and their bound is below the maximum, so they cannot be chosen
+    auto result = static_cast<CDouble>(-INFINITY);
+    for (size_t i = 0; i < nrComponents; i++) {
+        if (results[i] > result) {
+            result = results[i];
+            if (criticalNode != nullptr) {
+                *criticalNode = criticalNodes[i] == nullptr
+                                        ? nullptr
+                                        : g.getNode(nodeMaps[i][criticalNodes[i]->id]);
+            }
+        }
+    }
+
+    return result;
+}
+
 /**
  * relabelMCMgraph ()
  * The function removes all hidden nodes and edges from the graph. All visible
@@ -639,7 +975,7 @@ void relabelMCMgraph(MCMgraph &g) {
     uint nodeId = 0;
     for (auto &n : g.getNodes()) {
         if (n.visible) {
-            n.id = nodeId;
+            g.setNodeId(n, nodeId);
             nodeId++;
         }
     }
@@ -648,86 +984,128 @@ void relabelMCMgraph(MCMgraph &g) {
     uint edgeId = 0;
     for (auto &e : g.getEdges()) {
         if (e.visible) {
-            e.id = edgeId;
+            g.setEdgeId(e, edgeId);
             edgeId++;
         }
     }
 }
 
+/**
+ * Graphs with fewer edges than this are pruned on the calling thread.
+ */
+constexpr size_t MIN_EDGES_FOR_PARALLEL_PRUNING = 4096;
+
+/**
+ * paretoFront ()
+ * Reduce edges, the outgoing edges of a node, to the Pareto maximal edges to
+ * every destination: an edge is dropped if another edge to the same
+ * destination has no larger delay and no smaller weight; of equal edges, the
+ * first one is kept. The edges are sorted on destination, delay and decreasing
+ * weight, such that an edge is on the front if and only if it is heavier than
+ * the last edge kept for its destination.
+ */
+static void paretoFront(std::vector<MCMedge *> &edges) {
+    std::stable_sort(edges.begin(), edges.end(), [](const MCMedge *a, const MCMedge *b) {
+        if (a->dst->id != b->dst->id) {
+            return a->dst->id < b->dst->id;
+        }
+        if (a->d != b->d) {
+            return a->d < b->d;
+        }
+        return a->w > b->w;
+    });
+    size_t k = 0;
+    for (MCMedge *e : edges) {
+        if (k == 0 || e->dst->id != edges[k - 1]->dst->id || e->w > edges[k - 1]->w) {
+            edges[k++] = e;
+        }
+    }
+    edges.resize(k);
+}
+
+/**
+ * paretoFronts ()
+ * The Pareto fronts of the outgoing edges of all nodes, computed in parallel
+ * on up to nrThreads threads.
+ */
+std::vector<std::vector<MCMedge *>> MCMgraph::paretoFronts(unsigned int nrThreads) {
+    std::vector<std::vector<MCMedge *>> fronts;
+    fronts.reserve(this->nodes.size());
+    for (auto &u : this->nodes) {
+        fronts.emplace_back(u.out.begin(), u.out.end());
+    }
+    if (this->edges.size() < MIN_EDGES_FOR_PARALLEL_PRUNING) {
+        nrThreads = 1;
+    }
+    MaxPlus::parallelFor(
+            0, fronts.size(), [&](size_t i) { paretoFront(fronts[i]); }, nrThreads);
+    return fronts;
+}
+
 // Prune the edges in the MCMgraph to maintain only Pareto maximal combinations
 // Of the weight and number of tokens pair pair of nodes
 // Generates a new graph
 // Note this algorithm does currently not distinguish visible and invisible edges!
-std::shared_ptr<MCMgraph> MCMgraph::pruneEdges() {
-
-    class _local {
-    public:
-        std::map<MCMnode *, MCMedgeRefs, MCMNodeLess> paretoEdges;
-        void insert(MCMedge *e) {
-            MCMedgeRefs &edges = paretoEdges[e->dst];
-            // Simple Cull
-            auto i = edges.begin();
-            bool cont = i != edges.end();
-            bool add_e = true;
-            while (cont) {
-                MCMedge *f = *i;
-                // if e is worse than f
-                if ((e->d <= f->d) && (e->w >= f->w)) {
-                    // remove f from edges;
-                    i = edges.erase(i);
-                } else {
-                    // if f is worse than e
-                    if ((f->d <= e->d) && (f->w >= e->w)) {
-                        // forget e and stop iterating;
-                        add_e = false;
-                        cont = false;
-                    } else {
-                        // incomparable, go on
-                        i++;
-                    }
-                }
-                cont = cont && (i != edges.end());
-            }
-            if (add_e) {
-                edges.push_back(e);
-            }
-        }
-    };
-
-    _local local;
+std::shared_ptr<MCMgraph> MCMgraph::pruneEdges(unsigned int nrThreads) {
+    const std::vector<std::vector<MCMedge *>> fronts = this->paretoFronts(nrThreads);
 
     // create new graph
     std::shared_ptr<MCMgraph> result = std::make_shared<MCMgraph>();
 
     // create all nodes.
-    std::map<MCMnode *, MCMnode *> newNodeMap;
+    std::unordered_map<const MCMnode *, MCMnode *> newNodeMap;
+    newNodeMap.reserve(this->nodes.size());
     for (auto &u : this->nodes) {
-        auto *n = result->addNode(u.id, u.visible);
-        newNodeMap[&u] = n;
+        newNodeMap[&u] = result->addNode(u.id, u.visible);
     }
 
-    // for every node
+    // add the Pareto edges of every node, grouped by destination
+    size_t i = 0;
     for (auto &u : this->nodes) {
+        for (const MCMedge *e : fronts[i++]) {
+            result->addEdge(e->id, *newNodeMap[&u], *newNodeMap[e->dst], e->w, e->d, true);
+        }
+    }
 
-        local.paretoEdges.clear();
+    return result;
+}
 
-        // for every outgoing edges to a simple cull Pareto filtering
-        for (auto &i : u.out) {
-            local.insert(i);
-        }
+// Prune the edges in the MCMgraph itself, keeping the order of the remaining
+// edges. Like pruneEdges it does not distinguish visible and invisible edges.
+void MCMgraph::pruneEdgesInPlace(unsigned int nrThreads) {
+    const std::vector<std::vector<MCMedge *>> fronts = this->paretoFronts(nrThreads);
+    std::unordered_set<const MCMedge *> kept;
+    kept.reserve(this->edges.size());
+    for (const auto &front : fronts) {
+        kept.insert(front.begin(), front.end());
+    }
+    if (kept.size() == this->edges.size()) {
+        return;
+    }
 
-        // add Pareto Edges to new Graph.
-        // for every dst node
-        for (auto &j : local.paretoEdges) {
-            const MCMedgeRefs &edges = j.second;
-            // for every edge
-            for (const auto &e : edges) {
-                result->addEdge(e->id, *newNodeMap[&u], *newNodeMap[e->dst], e->w, e->d, true);
-            }
+    const auto dropped = [&kept](const MCMedge *e) { return kept.find(e) == kept.end(); };
+    for (auto &u : this->nodes) {
+        u.out.remove_if(dropped);
+        u.in.remove_if(dropped);
+    }
+    bool stale = false;
+    for (auto it = this->edges.begin(); it != this->edges.end();) {
+        if (!dropped(&*it)) {
+            ++it;
+            continue;
+        }
+        this->edgePositions.erase(&*it);
+        auto idx = this->edgeIndex.find(it->id);
+        if (idx != this->edgeIndex.end() && idx->second == &*it) {
+            this->edgeIndex.erase(idx);
+        } else {
+            stale = true;
         }
+        it = this->edges.erase(it);
+    }
+    if (stale) {
+        this->reindexEdges();
     }
-
-    return result;
 }
 
 CDouble MCMgraph::calculateMaximumCycleMeanKarp() { return maximumCycleMeanKarp(*this); }
@@ -751,6 +1129,7 @@ void MCMgraph::relabelNodeIds(std::map<CId, CId> *nodeIdMap) {
         n.id = k;
         k++;
     }
+    this->reindexNodes();
 }
 
 std::shared_ptr<MCMgraph> MCMgraph::normalize(CDouble mu) const {
@@ -772,39 +1151,90 @@ std::shared_ptr<MCMgraph> MCMgraph::normalize(const std::map<CId, CDouble> &mu)
     return result;
 }
 
-// longest path computation, may not be implemented optimally.
-std::map<CId, CDouble> MCMgraph::longestPaths(const CId rootNodeId) const {
-    std::map<CId, CDouble> result;
-    for (const auto &n : this->nodes) {
-        result[n.id] = (n.id == rootNodeId) ? 0.0 : -DBL_MAX;
-    }
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        for (const auto &e : this->edges) {
-            if (result[e.src->id] != -DBL_MAX) {
-                if (result[e.src->id] + e.w > result[e.dst->id]) {
-                    changed = true;
-                    result[e.dst->id] = result[e.src->id] + e.w;
-                }
+namespace {
+
+// relative amount by which a path must be longer to replace the current one,
+// so that rounding errors on cycles of length zero do not look like progress
+constexpr CDouble LONGEST_PATH_EPSILON = 1e-12;
+
+/**
+ * longestPathsFrom ()
+ * Longest paths from the node with id rootNodeId with the weight of edge e
+ * given by weight(e), by the queue based Bellman-Ford algorithm (SPFA), see
+ * longestPaths in mcmpaths.h. Nodes that are not reached get -DBL_MAX.
+ */
+template <typename Weight>
+std::map<CId, CDouble>
+longestPathsFrom(const MCMnodes &nodes, const CId rootNodeId, Weight weight) {
+    std::unordered_map<const MCMnode *, unsigned int> index;
+    index.reserve(nodes.size());
+    const MCMnode *root = nullptr;
+    for (const auto &n : nodes) {
+        index.emplace(&n, static_cast<unsigned int>(index.size()));
+        if (n.id == rootNodeId) {
+            root = &n;
+        }
+    }
+
+    const auto nrNodes = static_cast<unsigned int>(nodes.size());
+    std::vector<CDouble> dist(nrNodes, -DBL_MAX);
+    std::vector<unsigned int> nrPathEdges(nrNodes, 0);
+    std::vector<bool> queued(nrNodes, false);
+    std::deque<const MCMnode *> queue;
+    if (root != nullptr) {
+        dist[index[root]] = 0.0;
+        queued[index[root]] = true;
+        queue.push_back(root);
+    }
+    while (!queue.empty()) {
+        const MCMnode *u = queue.front();
+        queue.pop_front();
+        const unsigned int ui = index[u];
+        queued[ui] = false;
+        for (const MCMedge *e : u->out) {
+            const unsigned int vi = index[e->dst];
+            const CDouble length = dist[ui] + weight(*e);
+            if (dist[vi] != -DBL_MAX
+                && length <= dist[vi] + LONGEST_PATH_EPSILON * (1.0 + std::fabs(dist[vi]))) {
+                continue;
+            }
+            dist[vi] = length;
+            nrPathEdges[vi] = nrPathEdges[ui] + 1;
+            if (nrPathEdges[vi] >= nrNodes) {
+                throw MaxPlus::MPException("Positive cycle found in MCMgraph::longestPaths.");
+            }
+            if (!queued[vi]) {
+                queued[vi] = true;
+                queue.push_back(e->dst);
             }
         }
     }
+
+    std::map<CId, CDouble> result;
+    for (const auto &n : nodes) {
+        result[n.id] = dist[index[&n]];
+    }
     return result;
 }
 
+} // namespace
+
+std::map<CId, CDouble> MCMgraph::longestPaths(const CId rootNodeId) const {
+    return longestPathsFrom(this->nodes, rootNodeId, [](const MCMedge &e) { return e.w; });
+}
+
 std::map<CId, CDouble> MCMgraph::normalizedLongestPaths(const CId rootNodeId,
                                                         const CDouble mu) const {
-    std::shared_ptr<MCMgraph> normalizedGraph = this->normalize(mu);
-    std::map<CId, CDouble> result = normalizedGraph->longestPaths(rootNodeId);
-    return result;
+    return longestPathsFrom(
+            this->nodes, rootNodeId, [mu](const MCMedge &e) { return e.w - mu; });
 }
 
 std::map<CId, CDouble> MCMgraph::normalizedLongestPaths(const CId rootNodeId,
                                                         const std::map<CId, CDouble> &mu) const {
-    std::shared_ptr<MCMgraph> normalizedGraph = this->normalize(mu);
-    std::map<CId, CDouble> result = normalizedGraph->longestPaths(rootNodeId);
-    return result;
+    return longestPathsFrom(this->nodes, rootNodeId, [&mu](const MCMedge &e) {
+        CDouble nc = mu.at(e.src->id);
+        return nc != -DBL_MAX ? e.w - nc : e.w;
+    });
 }
 
 } // namespace Graphs
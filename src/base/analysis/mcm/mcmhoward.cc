@@ -49,15 +49,19 @@
  *  SOFTWARE.
  */
 
+#include "base/analysis/mcm/mcmcompact.h"
 #include "base/analysis/mcm/mcmgraph.h"
+#include "base/analysis/mcm/mcmhoward.h"
 #include "base/exception/exception.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <unordered_map>
 
 using namespace MaxPlus;
 
@@ -81,16 +85,22 @@ public:
               std::shared_ptr<std::vector<CDouble>> *v,
               std::shared_ptr<std::vector<int>> *policy,
               int *nr_iterations,
-              int *nr_components) :
+              int *nr_components,
+              const std::vector<int> *initial_policy = nullptr,
+              const std::vector<CDouble> *T = nullptr,
+              const HowardCheckpoint *checkpoint = nullptr) :
         ij(ij),
         a(A),
+        t(T),
         nr_nodes(nr_nodes),
         narcs(nr_arcs),
         chi(chi),
         v(v),
         pi(policy),
         NIterations(nr_iterations),
-        NComponents(nr_components) {}
+        NComponents(nr_components),
+        initial_policy(initial_policy),
+        checkpoint(checkpoint) {}
 
     void Run() {
 
@@ -105,10 +115,14 @@ public:
         Allocate_Memory();
         Epsilon(&epsilon);
         Initial_Policy();
+        Warm_Start();
         New_Build_Inverse();
 
         do {
             Value();
+            if (checkpoint != nullptr && !(*checkpoint)(**chi, **v, **pi)) {
+                return;
+            }
             Improve(&improved);
             Update_Policy();
             New_Build_Inverse();
@@ -121,6 +135,8 @@ public:
 private:
     const std::vector<int> &ij;
     const std::vector<CDouble> &a;
+    /* transit times of the arcs for cycle ratios, nullptr for cycle means */
+    const std::vector<CDouble> *t;
     int nr_nodes;
     int narcs;
     std::shared_ptr<std::vector<CDouble>> *chi;
@@ -128,6 +144,9 @@ private:
     std::shared_ptr<std::vector<int>> *pi;
     int *NIterations;
     int *NComponents;
+    const std::vector<int> *initial_policy;
+    /* called after every evaluation of a policy, stops the iteration when it returns false */
+    const HowardCheckpoint *checkpoint;
 
     std::shared_ptr<std::vector<int>> new_pi =
             std::make_shared<std::vector<int>>(); /*  new policy */
@@ -146,8 +165,10 @@ private:
     std::vector<int> pi_inv_last;
 
     std::vector<CDouble> c;
+    std::vector<CDouble> ct;
     std::vector<CDouble> v_aux;
     std::vector<CDouble> new_c;
+    std::vector<CDouble> new_ct;
     std::vector<CDouble> new_chi;
     std::vector<int> visited;
     std::vector<int> component;
@@ -155,6 +176,12 @@ private:
     CDouble epsilon = 0;
     int color = 1;
 
+    /**
+     * Transit ()
+     * The transit time of arc i, 1 for all arcs when computing cycle means.
+     */
+    [[nodiscard]] CDouble Transit(int i) const { return t == nullptr ? 1.0 : (*t)[i]; }
+
     /**
      * Epsilon ()
      * The termination tests are performed up to an epsilon constant, which is fixed
@@ -194,11 +221,37 @@ private:
             if (v_aux[ij[i * 2]] <= a[i]) {
                 (**pi)[ij[i * 2]] = ij[i * 2 + 1];
                 c[ij[i * 2]] = a[i];
+                ct[ij[i * 2]] = Transit(i);
                 v_aux[ij[i * 2]] = a[i];
             }
         }
     }
 
+    /**
+     * Warm_Start
+     * Replace the greedy initial policy by the initial policy given by the caller, for all
+     * nodes for which it is still admissible, i.e., for which the node it selects is still a
+     * successor. When the policy is still optimal for the current weights, the algorithm then
+     * terminates after a single iteration.
+     */
+    void Warm_Start() {
+        if (initial_policy != nullptr && static_cast<int>(initial_policy->size()) == nr_nodes) {
+            std::vector<bool> matched(nr_nodes, false);
+            for (int i = 0; i < narcs; i++) {
+                int src = ij[i * 2];
+                if (ij[i * 2 + 1] != (*initial_policy)[src]) {
+                    continue;
+                }
+                if (!matched[src] || c[src] <= a[i]) {
+                    (**pi)[src] = ij[i * 2 + 1];
+                    c[src] = a[i];
+                    ct[src] = Transit(i);
+                    matched[src] = true;
+                }
+            }
+        }
+    }
+
     void New_Build_Inverse() {
         int ptr = 0;
 
@@ -237,14 +290,15 @@ private:
      *
      * Given the value of v at initial point i, we compute v[j] for all predecessor
      * j of i, according to the spectral equation, v[j]+ lambda = A(arc from j to i)
-     * v[i] the array visited is changed by side effect.
+     * v[i] the array visited is changed by side effect. For cycle ratios lambda is
+     * scaled by the transit time of the arc.
      */
     void New_Depth_First_Label(int i) {
         int a = pi_inv_idx[i];
         while (a != -1 && visited[pi_inv_elem[a]] == 0) {
             int next_i = pi_inv_elem[a];
             visited[next_i] = 1;
-            (**v)[next_i] = -lambda + c[next_i] + (**v)[i];
+            (**v)[next_i] = -lambda * ct[next_i] + c[next_i] + (**v)[i];
             component[next_i] = color;
             (**chi)[next_i] = lambda;
             New_Depth_First_Label(next_i);
@@ -267,11 +321,11 @@ private:
 
         /* a cycle has been detected, since newindex is already visited */
         CDouble weight = 0;
-        int length = 0;
+        CDouble length = 0;
         int i = index;
         do {
             weight += c[i];
-            length++;
+            length += ct[i];
             i = pir[i];
         } while (i != index);
 
@@ -308,6 +362,7 @@ private:
             v_aux[i] = (**v)[i];
             (*new_pi)[i] = (**pi)[i];
             new_c[i] = c[i];
+            new_ct[i] = ct[i];
         }
     }
 
@@ -318,6 +373,7 @@ private:
                 (*new_pi)[ij[i * 2]] = ij[i * 2 + 1];
                 new_chi[ij[i * 2]] = (**chi)[ij[i * 2 + 1]];
                 new_c[ij[i * 2]] = a[i];
+                new_ct[ij[i * 2]] = Transit(i);
             }
         }
     }
@@ -329,12 +385,13 @@ private:
             for (int i = 0; i < narcs; i++) {
                 /* arc i is critical */
                 if (chir[ij[i * 2 + 1]] == new_chi[ij[i * 2]]) {
-                    CDouble w = a[i] + vr[ij[i * 2 + 1]] - chir[ij[i * 2 + 1]];
+                    CDouble w = a[i] + vr[ij[i * 2 + 1]] - chir[ij[i * 2 + 1]] * Transit(i);
                     if (w > v_aux[ij[i * 2]] + epsilon) {
                         *improved = true;
                         v_aux[ij[i * 2]] = w;
                         (*new_pi)[ij[i * 2]] = ij[i * 2 + 1];
                         new_c[ij[i * 2]] = a[i];
+                        new_ct[ij[i * 2]] = Transit(i);
                     }
                 }
             }
@@ -342,12 +399,13 @@ private:
             /* we know that all the arcs realize the max in the
             first order improvement */
             for (int i = 0; i < narcs; i++) {
-                CDouble w = a[i] + vr[ij[i * 2 + 1]] - chir[ij[i * 2 + 1]];
+                CDouble w = a[i] + vr[ij[i * 2 + 1]] - chir[ij[i * 2 + 1]] * Transit(i);
                 if (w > v_aux[ij[i * 2]] + epsilon) {
                     *improved = true;
                     v_aux[ij[i * 2]] = w;
                     (*new_pi)[ij[i * 2]] = ij[i * 2 + 1];
                     new_c[ij[i * 2]] = a[i];
+                    new_ct[ij[i * 2]] = Transit(i);
                 }
             }
         }
@@ -376,7 +434,9 @@ private:
         visited.resize(nr_nodes);
         component.resize(nr_nodes);
         c.resize(nr_nodes);
+        ct.resize(nr_nodes);
         new_c.resize(nr_nodes);
+        new_ct.resize(nr_nodes);
         v_aux.resize(nr_nodes);
         new_chi.resize(nr_nodes);
     }
@@ -413,6 +473,7 @@ private:
         for (int i = 0; i < nr_nodes; i++) {
             (**pi)[i] = (*new_pi)[i];
             c[i] = new_c[i];
+            ct[i] = new_ct[i];
             v_aux[i] = (**v)[i]; /* Keep a copy of the current value function */
         }
     }
@@ -479,6 +540,75 @@ void Howard(const std::vector<int> &ij,
     AH.Run();
 }
 
+/**
+ * Howard ()
+ * Howard Policy Iteration Algorithm for the maximum cycle ratio of a sparse
+ * matrix with non-negative transit times T[k] on the arcs; chi then holds the
+ * cycle ratios. Cycles of zero transit time are not allowed.
+ */
+void Howard(const std::vector<int> &ij,
+            const std::vector<CDouble> &A,
+            const std::vector<CDouble> &T,
+            int nr_nodes,
+            int nr_arcs,
+            std::shared_ptr<std::vector<CDouble>> *chi,
+            std::shared_ptr<std::vector<CDouble>> *v,
+            std::shared_ptr<std::vector<int>> *policy,
+            int *nr_iterations,
+            int *nr_components) {
+    AlgHoward AH(ij,
+                 A,
+                 nr_nodes,
+                 nr_arcs,
+                 chi,
+                 v,
+                 policy,
+                 nr_iterations,
+                 nr_components,
+                 nullptr,
+                 &T);
+    AH.Run();
+}
+
+/**
+ * Howard ()
+ * Howard Policy Iteration Algorithm on the sparse matrix stored in state. If
+ * the state holds a policy for the same number of nodes, e.g., from a previous
+ * run, the iteration starts from it; the results of the run are stored in the
+ * state for the next one.
+ */
+void Howard(HowardState &state) { Howard(state, HowardCheckpoint()); }
+
+/**
+ * Howard ()
+ * As Howard (state) above, calling checkpoint after the evaluation of every
+ * policy.
+ */
+void Howard(HowardState &state, const HowardCheckpoint &checkpoint) {
+    std::shared_ptr<std::vector<CDouble>> chi = nullptr;
+    std::shared_ptr<std::vector<CDouble>> v = nullptr;
+    std::shared_ptr<std::vector<int>> policy = nullptr;
+    const bool warm = static_cast<int>(state.policy.size()) == state.nrNodes;
+
+    AlgHoward AH(state.ij,
+                 state.A,
+                 state.nrNodes,
+                 static_cast<int>(state.A.size()),
+                 &chi,
+                 &v,
+                 &policy,
+                 &state.nrIterations,
+                 &state.nrComponents,
+                 warm ? &state.policy : nullptr,
+                 nullptr,
+                 checkpoint ? &checkpoint : nullptr);
+    AH.Run();
+
+    state.chi = std::move(*chi);
+    state.v = std::move(*v);
+    state.policy = std::move(*policy);
+}
+
 /**
  * convertMCMgraphToMatrix ()
  * The function converts a weighted directed graph used in the MCM algorithms
@@ -520,9 +650,131 @@ void convertMCMgraphToMatrix(MCMgraph &g,
     }
 }
 
+/**
+ * convertMCMgraphToMatrix ()
+ * The function converts the visible part of a graph to the sparse matrix of
+ * a HowardState. The results in the state are kept if the topology of the
+ * graph equals that of the matrix already in the state, so that a next run of
+ * Howard's algorithm starts from its policy, and are cleared otherwise.
+ */
+void convertMCMgraphToMatrix(MCMgraph &g, HowardState &state) {
+    // Re-map the id of all visible nodes to the range [0, g.nrVisibleNodes())
+    std::unordered_map<const MCMnode *, int> mapId;
+    int nrNodes = 0;
+    for (const auto &n : g.getNodes()) {
+        if (n.visible) {
+            mapId[&n] = nrNodes++;
+        }
+    }
+
+    std::vector<int> ij;
+    std::vector<CDouble> A;
+    for (const auto &e : g.getEdges()) {
+        if (e.visible && e.src->visible && e.dst->visible) {
+            ij.push_back(mapId[e.src]);
+            ij.push_back(mapId[e.dst]);
+            A.push_back(e.w);
+        }
+    }
+
+    if (nrNodes != state.nrNodes || ij != state.ij) {
+        state.policy.clear();
+        state.v.clear();
+        state.chi.clear();
+        state.ij = std::move(ij);
+        state.nrNodes = nrNodes;
+    }
+    state.A = std::move(A);
+}
+
+/**
+ * criticalNodeOfState ()
+ * A visible node of g on a cycle with the largest cycle mean in the state,
+ * found by following the policy from a node with the largest cycle mean.
+ */
+static MCMnode *criticalNodeOfState(MCMgraph &g, const HowardState &state) {
+    int critical = 0;
+    for (int i = 1; i < state.nrNodes; i++) {
+        if (state.chi[i] > state.chi[critical]) {
+            critical = i;
+        }
+    }
+    std::vector<bool> visited(state.nrNodes, false);
+    while (!visited[critical]) {
+        visited[critical] = true;
+        critical = state.policy[critical];
+    }
+    int i = 0;
+    for (auto &n : g.getNodes()) {
+        if (n.visible) {
+            if (i == critical) {
+                return &n;
+            }
+            i++;
+        }
+    }
+    return nullptr;
+}
+
+CDouble maximumCycleMeanHoward(MCMgraph &g, HowardState &state, MCMnode **criticalNode) {
+    convertMCMgraphToMatrix(g, state);
+
+    if (state.nrNodes == 0) {
+        if (criticalNode != nullptr) {
+            (*criticalNode) = nullptr;
+        }
+        return -INFINITY;
+    }
+
+    Howard(state);
+
+    if (criticalNode != nullptr) {
+        (*criticalNode) = criticalNodeOfState(g, state);
+    }
+    return *std::max_element(state.chi.begin(), state.chi.end());
+}
+
 CDouble maximumCycleMeanHoward(MCMgraph &g, MCMnode **criticalNode) {
+    HowardState state;
+    return maximumCycleMeanHoward(g, state, criticalNode);
+}
+
+CDouble
+maximumCycleMeanHowardGeneral(MCMgraph &g, MCMnode **criticalNode, unsigned int nrThreads) {
+    return maximumCycleMeanOverComponents(
+            g,
+            [](MCMgraph &scc, const MCMnode **sccCriticalNode) {
+                MCMnode *critical = nullptr;
+                CDouble cmcm = maximumCycleMeanHoward(scc, &critical);
+                *sccCriticalNode = critical;
+                return cmcm;
+            },
+            criticalNode,
+            nrThreads);
+}
 
-    if (g.numberOfNodes() == 0) {
+/**
+ * convertMCMgraphToMatrix ()
+ * The function converts a compact graph to a sparse matrix input for Howard's
+ * algorithm. The dense node numbering of the compact graph is used directly.
+ */
+void convertMCMgraphToMatrix(const CompactMCMgraph &g,
+                             std::shared_ptr<std::vector<int>> *ij,
+                             std::shared_ptr<std::vector<CDouble>> *A) {
+    const unsigned int m = g.nrEdges();
+    *ij = std::make_shared<std::vector<int>>(2 * static_cast<size_t>(m));
+    auto &ijr = *(*ij);
+    *A = std::make_shared<std::vector<CDouble>>(g.weights());
+
+    for (unsigned int e = 0; e < m; e++) {
+        ijr[2 * static_cast<size_t>(e)] = static_cast<int>(g.source(e));
+        ijr[2 * static_cast<size_t>(e) + 1] = static_cast<int>(g.destination(e));
+    }
+}
+
+CDouble maximumCycleMeanHoward(const CompactMCMgraph &g, const MCMnode **criticalNode) {
+
+    if (g.nrNodes() == 0) {
         if (criticalNode != nullptr) {
             (*criticalNode) = nullptr;
         }
@@ -541,8 +793,8 @@ CDouble maximumCycleMeanHoward(MCMgraph &g, MCMnode **criticalNode) {
 
     Howard(*ij,
            *A,
-           g.numberOfNodes(),
-           g.numberOfEdges(),
+           static_cast<int>(g.nrNodes()),
+           static_cast<int>(g.nrEdges()),
            &chi,
            &v,
            &policy,
@@ -550,48 +802,173 @@ CDouble maximumCycleMeanHoward(MCMgraph &g, MCMnode **criticalNode) {
            &nr_components);
 
     // find maximum cycle mean in chi vector
-    MCMnodes &nodes = g.getNodes();
-    auto n = nodes.begin();
+    unsigned int critNode = 0;
     CDouble mcm = chi->at(0);
-    MCMnode *critNode = &(*n);
-    for (auto &val : *chi) {
-        if (val > mcm) {
-            mcm = val;
-            critNode = &(*n);
-            n++;
+    for (unsigned int i = 1; i < g.nrNodes(); i++) {
+        if (chi->at(i) > mcm) {
+            mcm = chi->at(i);
+            critNode = i;
         }
     }
 
     if (criticalNode != nullptr) {
-        (*criticalNode) = &(*n);
+        // follow the policy to a node on the critical cycle
+        std::vector<bool> visited(g.nrNodes(), false);
+        while (!visited[critNode]) {
+            visited[critNode] = true;
+            critNode = static_cast<unsigned int>(policy->at(critNode));
+        }
+        (*criticalNode) = g.node(critNode);
     }
     return mcm;
 }
 
-CDouble maximumCycleMeanHowardGeneral(MCMgraph &g, MCMnode **criticalNode) {
+void convertMCMgraphToMatrix(const CompactMCMgraph &g, HowardState &state) {
+    const unsigned int m = g.nrEdges();
+    std::vector<int> ij(2 * static_cast<size_t>(m));
+    for (unsigned int e = 0; e < m; e++) {
+        ij[2 * static_cast<size_t>(e)] = static_cast<int>(g.source(e));
+        ij[2 * static_cast<size_t>(e) + 1] = static_cast<int>(g.destination(e));
+    }
 
-    MCMgraphs sccs;
-    stronglyConnectedMCMgraph(g, sccs, false);
+    const auto nrNodes = static_cast<int>(g.nrNodes());
+    if (nrNodes != state.nrNodes || ij != state.ij) {
+        state.policy.clear();
+        state.v.clear();
+        state.chi.clear();
+        state.ij = std::move(ij);
+        state.nrNodes = nrNodes;
+    }
+    state.A = g.weights();
+}
 
-    CDouble mcm = -INFINITY;
-    if (criticalNode != nullptr) {
-        *criticalNode = nullptr;
-    }
-    for (auto &scc : sccs) {
-        std::map<CId, CId> nodeMap;
-        scc->relabelNodeIds(&nodeMap);
-        MCMnode *sccCriticalNode = nullptr;
-        ;
-        CDouble cmcm = maximumCycleMeanHoward(*scc, &sccCriticalNode);
-        if (cmcm > mcm) {
-            mcm = cmcm;
-            if (criticalNode != nullptr) {
-                *criticalNode = g.getNode(nodeMap[sccCriticalNode->id]);
+std::vector<unsigned int> policyCycle(const CompactMCMgraph &g,
+                                      const std::vector<CDouble> &w,
+                                      const std::vector<int> &policy,
+                                      unsigned int start) {
+    // follow the policy until a node repeats, that node is on the cycle
+    std::vector<bool> visited(g.nrNodes(), false);
+    unsigned int u = start;
+    while (!visited[u]) {
+        visited[u] = true;
+        u = static_cast<unsigned int>(policy[u]);
+    }
+
+    std::vector<unsigned int> cycle;
+    const unsigned int first = u;
+    do {
+        // the heaviest edge to the successor in the policy
+        const auto next = static_cast<unsigned int>(policy[u]);
+        unsigned int best = g.nrEdges();
+        for (unsigned int i = g.outBegin(u); i < g.outEnd(u); i++) {
+            unsigned int e = g.outEdge(i);
+            if (g.destination(e) != next) {
+                continue;
+            }
+            if (best == g.nrEdges() || w[e] > w[best]) {
+                best = e;
             }
         }
+        cycle.push_back(best);
+        u = next;
+    } while (u != first);
+    return cycle;
+}
+
+/**
+ * cycleRatioHoward ()
+ * Howard's algorithm for the maximum cycle ratio of g, or, if minimize is true,
+ * for the minimum cycle ratio as the negated maximum cycle ratio with negated
+ * weights.
+ */
+static CDouble
+cycleRatioHoward(const CompactMCMgraph &g, bool minimize, std::vector<const MCMedge *> *cycle) {
+    std::vector<bool> zeroDelay(g.nrEdges());
+    for (unsigned int e = 0; e < g.nrEdges(); e++) {
+        if (g.delay(e) < 0.0) {
+            throw MPException("Howard: cycle ratios require non-negative delays.");
+        }
+        zeroDelay[e] = g.delay(e) == 0.0;
+    }
+    std::vector<unsigned int> deadlock;
+    if (findCycle(g, zeroDelay, &deadlock)) {
+        if (minimize) {
+            throw MPException("Howard: the graph has a cycle without delay (deadlock).");
+        }
+        if (cycle != nullptr) {
+            *cycle = g.originalEdges(deadlock);
+        }
+        return INFINITY;
     }
 
-    return mcm;
+    // Howard needs an outgoing edge on every node
+    const CompactMCMgraph core = g.subgraph(nodesReachingCycles(g));
+    if (core.nrNodes() == 0) {
+        if (cycle != nullptr) {
+            cycle->clear();
+        }
+        return minimize ? INFINITY : -INFINITY;
+    }
+
+    std::vector<int> ij(2 * static_cast<size_t>(core.nrEdges()));
+    std::vector<CDouble> A(core.weights());
+    for (unsigned int e = 0; e < core.nrEdges(); e++) {
+        ij[2 * static_cast<size_t>(e)] = static_cast<int>(core.source(e));
+        ij[2 * static_cast<size_t>(e) + 1] = static_cast<int>(core.destination(e));
+        if (minimize) {
+            A[e] = -A[e];
+        }
+    }
+
+    std::shared_ptr<std::vector<CDouble>> chi = nullptr;
+    std::shared_ptr<std::vector<CDouble>> v = nullptr;
+    std::shared_ptr<std::vector<int>> policy = nullptr;
+    int nr_iterations = 0;
+    int nr_components = 0;
+    Howard(ij,
+           A,
+           core.delays(),
+           static_cast<int>(core.nrNodes()),
+           static_cast<int>(core.nrEdges()),
+           &chi,
+           &v,
+           &policy,
+           &nr_iterations,
+           &nr_components);
+
+    unsigned int critical = 0;
+    for (unsigned int i = 1; i < core.nrNodes(); i++) {
+        if ((*chi)[i] > (*chi)[critical]) {
+            critical = i;
+        }
+    }
+    const CDouble lambda = (*chi)[critical];
+
+    if (cycle != nullptr) {
+        // of parallel edges, take the one that is tight for lambda
+        std::vector<CDouble> slack(A);
+        for (unsigned int e = 0; e < core.nrEdges(); e++) {
+            slack[e] -= lambda * core.delay(e);
+        }
+        *cycle = core.originalEdges(policyCycle(core, slack, *policy, critical));
+    }
+    return minimize ? -lambda : lambda;
+}
+
+CDouble maximumCycleRatioHoward(const CompactMCMgraph &g, std::vector<const MCMedge *> *cycle) {
+    return cycleRatioHoward(g, false, cycle);
+}
+
+CDouble minimumCycleRatioHoward(const CompactMCMgraph &g, std::vector<const MCMedge *> *cycle) {
+    return cycleRatioHoward(g, true, cycle);
+}
+
+CDouble maximumCycleRatioHoward(MCMgraph &g, std::vector<const MCMedge *> *cycle) {
+    return cycleRatioHoward(CompactMCMgraph(g), false, cycle);
+}
+
+CDouble minimumCycleRatioHoward(MCMgraph &g, std::vector<const MCMedge *> *cycle) {
+    return cycleRatioHoward(CompactMCMgraph(g), true, cycle);
 }
 
-} // namespace Graphs
\ No newline at end of file
+} // namespace Graphs
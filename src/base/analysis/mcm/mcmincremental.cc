@@ -0,0 +1,292 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmincremental.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Maintain the MCM of a growing graph.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmincremental.h"
+#include "base/analysis/mcm/mcmcompact.h"
+#include "base/analysis/mcm/mcmhoward.h"
+#include "base/exception/exception.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+namespace Graphs {
+
+namespace {
+
+// Potentials are feasible up to this fraction of the range of the weights,
+// as in the termination test of Howard's algorithm.
+constexpr CDouble INCREMENTAL_EPSILON_FACTOR = 1e-9;
+
+bool isVisible(const MCMedge &e) { return e.visible && e.src->visible && e.dst->visible; }
+
+} // namespace
+
+IncrementalMCM::IncrementalMCM(MCMgraph &g) : g(g) {
+    for (const auto &e : g.getEdges()) {
+        if (isVisible(e)) {
+            this->addWeight(e.w);
+        }
+    }
+    this->recompute();
+}
+
+MCMnode *IncrementalMCM::addNode(CId id) {
+    MCMnode *n = this->g.addNode(id);
+    this->indexOf(n);
+    return n;
+}
+
+MCMedge *IncrementalMCM::addEdge(CId id, MCMnode &src, MCMnode &dst, CDouble w, CDouble d) {
+    MCMedge *e = this->g.addEdge(id, src, dst, w, d);
+    if (!isVisible(*e)) {
+        return e;
+    }
+    this->addWeight(w);
+    if (this->mu == -INFINITY) {
+        // the graph has no cycle, the edge may close the first one
+        if (this->closesCycle(*e)) {
+            this->recompute();
+        }
+    } else {
+        this->repair(*e);
+    }
+    return e;
+}
+
+void IncrementalMCM::increaseWeight(MCMedge &e, CDouble w) {
+    if (w < e.w) {
+        throw MaxPlus::MPException("IncrementalMCM does not support decreasing edge weights.");
+    }
+    e.w = w;
+    if (!isVisible(e)) {
+        return;
+    }
+    this->addWeight(w);
+    // without cycles the MCM stays -INFINITY
+    if (this->mu != -INFINITY) {
+        this->repair(e);
+    }
+}
+
+void IncrementalMCM::addWeight(CDouble w) {
+    this->minWeight = std::min(this->minWeight, w);
+    this->maxWeight = std::max(this->maxWeight, w);
+    this->epsilon = INCREMENTAL_EPSILON_FACTOR * (1.0 + this->maxWeight - this->minWeight);
+}
+
+unsigned int IncrementalMCM::indexOf(const MCMnode *n) {
+    auto [it, isNew] = this->index.emplace(n, static_cast<unsigned int>(this->x.size()));
+    if (isNew) {
+        this->x.push_back(0.0);
+        this->raise.push_back(0.0);
+        this->done.push_back(false);
+    }
+    return it->second;
+}
+
+/**
+ * repair ()
+ * The edge e = (u, v) requires x(u) to rise by delta = w - mu + x(v) - x(u).
+ * A node p with an edge to a raised node q must rise by the raise of q minus
+ * the slack of the edge, which is never more than the raise of q. Hence the
+ * nodes are raised in the order of a Dijkstra search over the incoming edges,
+ * each at most once. If v has to rise, the cycle through e has a positive
+ * weight under w - mu and mu must be recomputed.
+ */
+void IncrementalMCM::repair(const MCMedge &e) {
+    const unsigned int u = this->indexOf(e.src);
+    const unsigned int v = this->indexOf(e.dst);
+    const CDouble delta = e.w - this->mu + this->x[v] - this->x[u];
+    if (delta <= this->epsilon) {
+        return;
+    }
+
+    using Entry = std::pair<CDouble, const MCMnode *>;
+    std::priority_queue<Entry> queue;
+    this->raise[u] = delta;
+    this->touched.push_back(u);
+    queue.emplace(delta, e.src);
+    bool infeasible = false;
+    while (!queue.empty()) {
+        const auto [r, node] = queue.top();
+        queue.pop();
+        const unsigned int q = this->index[node];
+        if (this->done[q] || r < this->raise[q]) {
+            continue;
+        }
+        if (q == v) {
+            infeasible = true;
+            break;
+        }
+        this->done[q] = true;
+        this->x[q] += r;
+        for (const MCMedge *f : node->in) {
+            if (!isVisible(*f)) {
+                continue;
+            }
+            const unsigned int p = this->indexOf(f->src);
+            const CDouble need = f->w - this->mu + this->x[q] - this->x[p];
+            if (!this->done[p] && need > this->epsilon && need > this->raise[p]) {
+                if (this->raise[p] == 0.0) {
+                    this->touched.push_back(p);
+                }
+                this->raise[p] = need;
+                queue.emplace(need, f->src);
+            }
+        }
+    }
+
+    for (unsigned int t : this->touched) {
+        this->raise[t] = 0.0;
+        this->done[t] = false;
+    }
+    this->touched.clear();
+    if (infeasible) {
+        this->recompute();
+    }
+}
+
+bool IncrementalMCM::closesCycle(const MCMedge &e) {
+    // depth-first search from the destination for the source
+    std::vector<const MCMnode *> stack{e.dst};
+    bool found = false;
+    while (!stack.empty() && !found) {
+        const MCMnode *n = stack.back();
+        stack.pop_back();
+        const unsigned int i = this->indexOf(n);
+        if (this->done[i]) {
+            continue;
+        }
+        this->done[i] = true;
+        this->touched.push_back(i);
+        for (const MCMedge *f : n->out) {
+            if (isVisible(*f)) {
+                found = found || f->dst == e.src;
+                stack.push_back(f->dst);
+            }
+        }
+    }
+    for (unsigned int t : this->touched) {
+        this->done[t] = false;
+    }
+    this->touched.clear();
+    return found;
+}
+
+/**
+ * recompute ()
+ * Howard's algorithm on the nodes that reach a cycle gives every such node the
+ * maximum cycle mean chi it reaches and a bias b with b(s) >= w - chi + b(d) for
+ * the edges between nodes with the same chi. Since chi does not increase along
+ * an edge, the potential x = b + K * level, with levels numbering the values of
+ * chi in increasing order and K large enough, satisfies all inequalities. The
+ * nodes that do not reach a cycle are at level 0 with the longest paths from
+ * them, which are computed in reverse topological order.
+ */
+void IncrementalMCM::recompute() {
+    this->recomputations++;
+    for (auto &n : this->g.getNodes()) {
+        this->x[this->indexOf(&n)] = 0.0;
+    }
+
+    CompactMCMgraph c(this->g);
+    const std::vector<bool> keep = nodesReachingCycles(c);
+    const CompactMCMgraph core = c.subgraph(keep);
+    if (core.nrNodes() == 0) {
+        this->mu = -INFINITY;
+        return;
+    }
+
+    HowardState state;
+    convertMCMgraphToMatrix(core, state);
+    Howard(state);
+    this->mu = *std::max_element(state.chi.begin(), state.chi.end());
+
+    // levels and biases of the nodes that reach a cycle
+    std::vector<CDouble> levels(state.chi);
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    std::vector<unsigned int> level(this->x.size(), 0);
+    for (unsigned int i = 0; i < core.nrNodes(); i++) {
+        const unsigned int n = this->indexOf(core.node(i));
+        level[n] = static_cast<unsigned int>(
+                std::lower_bound(levels.begin(), levels.end(), state.chi[i]) - levels.begin() + 1);
+        this->x[n] = state.v[i];
+    }
+
+    // longest paths from the other nodes, peeling off nodes without successors
+    std::vector<unsigned int> outDegree(c.nrNodes());
+    std::vector<unsigned int> sinks;
+    for (unsigned int i = 0; i < c.nrNodes(); i++) {
+        outDegree[i] = c.outEnd(i) - c.outBegin(i);
+        if (outDegree[i] == 0) {
+            sinks.push_back(i);
+        }
+    }
+    while (!sinks.empty()) {
+        const unsigned int i = sinks.back();
+        sinks.pop_back();
+        CDouble length = 0.0;
+        for (unsigned int k = c.outBegin(i); k < c.outEnd(i); k++) {
+            const unsigned int f = c.outEdge(k);
+            const unsigned int d = this->indexOf(c.node(c.destination(f)));
+            length = std::max(length, c.weight(f) - this->mu + this->x[d]);
+        }
+        this->x[this->indexOf(c.node(i))] = length;
+        for (unsigned int k = c.inBegin(i); k < c.inEnd(i); k++) {
+            const unsigned int s = c.source(c.inEdge(k));
+            if (--outDegree[s] == 0) {
+                sinks.push_back(s);
+            }
+        }
+    }
+
+    // lift the levels apart far enough for the edges between them
+    CDouble lift = 0.0;
+    for (unsigned int f = 0; f < c.nrEdges(); f++) {
+        const unsigned int s = this->indexOf(c.node(c.source(f)));
+        const unsigned int d = this->indexOf(c.node(c.destination(f)));
+        if (level[s] > level[d]) {
+            lift = std::max(lift, c.weight(f) - this->mu + this->x[d] - this->x[s]);
+        }
+    }
+    for (unsigned int n = 0; n < this->x.size(); n++) {
+        this->x[n] += lift * level[n];
+    }
+}
+
+} // namespace Graphs
@@ -0,0 +1,423 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmio.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Read and write graphs for the MCM algorithms.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmio.h"
+#include "base/exception/exception.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <istream>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace MaxPlus;
+
+namespace Graphs {
+
+namespace {
+
+// size of the chunks in which text is read and written
+constexpr std::size_t MCM_IO_CHUNK = 64 * 1024;
+
+// upper bound on the length of a single formatted edge
+constexpr std::size_t MCM_IO_MAX_LINE = 128;
+
+// lower bound on the length of an edge line, "a 1 1 0" and its newline
+constexpr std::size_t MCM_IO_MIN_LINE = 8;
+
+constexpr std::array<char, 8> BINARY_MAGIC = {'M', 'P', 'M', 'C', 'M', 'G', '0', '1'};
+constexpr std::size_t BINARY_HEADER_SIZE = BINARY_MAGIC.size() + 2 * sizeof(std::uint64_t);
+constexpr std::size_t BINARY_EDGE_SIZE = 2 * sizeof(std::uint32_t) + 2 * sizeof(CDouble);
+
+static_assert(sizeof(unsigned int) == sizeof(std::uint32_t),
+              "the binary format stores node numbers as unsigned int");
+
+[[noreturn]] void parseError(std::size_t lineNumber, const char *what) {
+    MPString message("Cannot parse line ");
+    message += MPString(std::to_string(lineNumber));
+    message += " in readCompactMCMgraph: ";
+    message += what;
+    throw MPException(message);
+}
+
+[[noreturn]] void outOfMemory(const char *where) {
+    throw MPException(MPString("Not enough memory for the graph in ") + MPString(where));
+}
+
+/**
+ * EdgeListParser
+ * Parses the input line by line into edge arrays. Lines that are split between
+ * two chunks are collected in a buffer; the other lines are parsed in place.
+ */
+class EdgeListParser {
+public:
+    // inputSize is the number of bytes to parse, or 0 if it is not known
+    explicit EdgeListParser(std::size_t inputSize) : inputSize(inputSize) {}
+
+    void consume(const char *data, std::size_t len) {
+        const char *end = data + len;
+        while (data != end) {
+            const char *newline = std::find(data, end, '\n');
+            if (newline == end) {
+                this->pending.append(data, end);
+                return;
+            }
+            if (this->pending.empty()) {
+                parseLine(data, newline);
+            } else {
+                this->pending.append(data, newline);
+                parseLine(this->pending.data(), this->pending.data() + this->pending.size());
+                this->pending.clear();
+            }
+            data = newline + 1;
+        }
+    }
+
+    CompactMCMgraph finish() {
+        if (!this->pending.empty()) {
+            parseLine(this->pending.data(), this->pending.data() + this->pending.size());
+            this->pending.clear();
+        }
+        return CompactMCMgraph::fromEdges(this->nrNodes,
+                                          std::move(this->src),
+                                          std::move(this->dst),
+                                          std::move(this->w),
+                                          std::move(this->d));
+    }
+
+private:
+    static const char *skipSpace(const char *p, const char *end) {
+        while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+        }
+        return p;
+    }
+
+    template <typename T> T field(const char *&p, const char *end) const {
+        p = skipSpace(p, end);
+        T value{};
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) {
+            parseError(this->lineNumber, "expected a number.");
+        }
+        p = result.ptr;
+        return value;
+    }
+
+    unsigned int node(const char *&p, const char *end) const {
+        auto v = field<unsigned int>(p, end);
+        if (v == 0 || (this->hasProblem && v > this->nrNodes)) {
+            parseError(this->lineNumber, "node number out of range.");
+        }
+        return v - 1;
+    }
+
+    void parseLine(const char *p, const char *end) {
+        this->lineNumber++;
+        p = skipSpace(p, end);
+        if (p == end || *p == 'c') {
+            return;
+        }
+        const char kind = *p++;
+        if (kind == 'a') {
+            const unsigned int u = node(p, end);
+            const unsigned int v = node(p, end);
+            const auto weight = field<CDouble>(p, end);
+            p = skipSpace(p, end);
+            const CDouble delay = p == end ? 0.0 : field<CDouble>(p, end);
+            if (std::isnan(weight) || std::isnan(delay)) {
+                parseError(this->lineNumber, "weight or delay is not a number.");
+            }
+            this->src.push_back(u);
+            this->dst.push_back(v);
+            this->w.push_back(weight);
+            this->d.push_back(delay);
+            if (!this->hasProblem) {
+                this->nrNodes = std::max(this->nrNodes, std::max(u, v) + 1);
+            }
+        } else if (kind == 'p') {
+            if (this->hasProblem || !this->src.empty()) {
+                parseError(this->lineNumber, "misplaced problem line.");
+            }
+            // skip the name of the problem
+            p = skipSpace(p, end);
+            while (p != end && *p != ' ' && *p != '\t') {
+                p++;
+            }
+            this->nrNodes = field<unsigned int>(p, end);
+            const auto nrEdges = field<unsigned int>(p, end);
+            this->hasProblem = true;
+            // do not trust the count further than the input reaches
+            std::size_t reserved = nrEdges;
+            if (this->inputSize > 0) {
+                if (nrEdges > this->inputSize / MCM_IO_MIN_LINE + 1) {
+                    parseError(this->lineNumber, "more edges than fit in the input.");
+                }
+            } else {
+                reserved = std::min(reserved, MCM_IO_CHUNK);
+            }
+            this->src.reserve(reserved);
+            this->dst.reserve(reserved);
+            this->w.reserve(reserved);
+            this->d.reserve(reserved);
+        } else {
+            parseError(this->lineNumber, "unknown kind of line.");
+        }
+        if (skipSpace(p, end) != end) {
+            parseError(this->lineNumber, "unexpected text at the end of the line.");
+        }
+    }
+
+    std::string pending;
+    std::size_t inputSize;
+    std::size_t lineNumber = 0;
+    bool hasProblem = false;
+    unsigned int nrNodes = 0;
+    std::vector<unsigned int> src;
+    std::vector<unsigned int> dst;
+    std::vector<CDouble> w;
+    std::vector<CDouble> d;
+};
+
+/**
+ * MappedFile
+ * A file that is mapped into memory for reading, as long as the object lives.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &fileName) {
+        this->fd = open(fileName.c_str(), O_RDONLY);
+        struct stat status {};
+        if (this->fd < 0 || fstat(this->fd, &status) != 0) {
+            throw MPException(MPString("Cannot open file ") + MPString(fileName));
+        }
+        this->size = static_cast<std::size_t>(status.st_size);
+        if (this->size > 0) {
+            this->data = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+            if (this->data == MAP_FAILED) {
+                this->data = nullptr;
+                throw MPException(MPString("Cannot map file ") + MPString(fileName));
+            }
+        }
+    }
+
+    ~MappedFile() {
+        if (this->data != nullptr) {
+            munmap(this->data, this->size);
+        }
+        if (this->fd >= 0) {
+            close(this->fd);
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+    MappedFile &operator=(MappedFile &&) = delete;
+
+    [[nodiscard]] const char *bytes() const { return static_cast<const char *>(this->data); }
+    [[nodiscard]] std::size_t length() const { return this->size; }
+
+private:
+    int fd = -1;
+    void *data = nullptr;
+    std::size_t size = 0;
+};
+
+template <typename T> std::vector<T> copyArray(const char *from, std::size_t count) {
+    std::vector<T> result(count);
+    std::memcpy(result.data(), from, count * sizeof(T));
+    return result;
+}
+
+template <typename T> void writeArray(std::ofstream &out, const std::vector<T> &values) {
+    out.write(reinterpret_cast<const char *>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+} // namespace
+
+CompactMCMgraph readCompactMCMgraph(std::istream &in) {
+    // the size of the remaining input, if the stream can tell
+    std::size_t inputSize = 0;
+    const std::istream::pos_type start = in.tellg();
+    if (start != std::istream::pos_type(-1)) {
+        if (in.seekg(0, std::ios::end)) {
+            inputSize = static_cast<std::size_t>(in.tellg() - start);
+        }
+        in.clear();
+        in.seekg(start);
+    }
+
+    // node counts are not bounded by the input size, a malformed one may not fit in memory
+    try {
+        EdgeListParser parser(inputSize);
+        std::vector<char> buffer(MCM_IO_CHUNK);
+        while (in) {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            auto n = static_cast<std::size_t>(in.gcount());
+            if (n == 0) {
+                break;
+            }
+            parser.consume(buffer.data(), n);
+        }
+        return parser.finish();
+    } catch (const std::bad_alloc &) {
+        outOfMemory("readCompactMCMgraph.");
+    } catch (const std::length_error &) {
+        outOfMemory("readCompactMCMgraph.");
+    }
+}
+
+void writeCompactMCMgraph(std::ostream &out, const CompactMCMgraph &g) {
+    std::vector<char> buffer(MCM_IO_CHUNK);
+    std::size_t pos = 0;
+    auto flush = [&]() {
+        out.write(buffer.data(), static_cast<std::streamsize>(pos));
+        pos = 0;
+    };
+    auto put = [&](auto value) {
+        auto result = std::to_chars(&buffer[pos], buffer.data() + buffer.size(), value);
+        pos = static_cast<std::size_t>(result.ptr - buffer.data());
+    };
+
+    out << "p mcm " << g.nrNodes() << ' ' << g.nrEdges() << '\n';
+    for (unsigned int e = 0; e < g.nrEdges(); e++) {
+        if (pos + MCM_IO_MAX_LINE > buffer.size()) {
+            flush();
+        }
+        buffer[pos++] = 'a';
+        buffer[pos++] = ' ';
+        put(g.source(e) + 1);
+        buffer[pos++] = ' ';
+        put(g.destination(e) + 1);
+        buffer[pos++] = ' ';
+        put(g.weight(e));
+        buffer[pos++] = ' ';
+        put(g.delay(e));
+        buffer[pos++] = '\n';
+    }
+    flush();
+}
+
+void saveBinaryMCMgraph(const std::string &fileName, const CompactMCMgraph &g) {
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out) {
+        throw MPException(MPString("Cannot open file ") + MPString(fileName));
+    }
+    const std::uint64_t n = g.nrNodes();
+    const std::uint64_t m = g.nrEdges();
+    std::vector<unsigned int> src(m);
+    std::vector<unsigned int> dst(m);
+    for (unsigned int e = 0; e < m; e++) {
+        src[e] = g.source(e);
+        dst[e] = g.destination(e);
+    }
+    out.write(BINARY_MAGIC.data(), BINARY_MAGIC.size());
+    out.write(reinterpret_cast<const char *>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char *>(&m), sizeof(m));
+    writeArray(out, src);
+    writeArray(out, dst);
+    writeArray(out, g.weights());
+    writeArray(out, g.delays());
+    if (!out) {
+        throw MPException(MPString("Cannot write file ") + MPString(fileName));
+    }
+}
+
+CompactMCMgraph loadBinaryMCMgraph(const std::string &fileName) {
+    MappedFile file(fileName);
+    const char *p = file.bytes();
+    std::uint64_t n = 0;
+    std::uint64_t m = 0;
+    if (file.length() < BINARY_HEADER_SIZE
+        || std::memcmp(p, BINARY_MAGIC.data(), BINARY_MAGIC.size()) != 0) {
+        throw MPException(MPString("Not a binary MCM graph: ") + MPString(fileName));
+    }
+    std::memcpy(&n, p + BINARY_MAGIC.size(), sizeof(n));
+    std::memcpy(&m, p + BINARY_MAGIC.size() + sizeof(n), sizeof(m));
+    if (n > UINT32_MAX || m > UINT32_MAX
+        || file.length() != BINARY_HEADER_SIZE + m * BINARY_EDGE_SIZE) {
+        throw MPException(MPString("Corrupt binary MCM graph: ") + MPString(fileName));
+    }
+
+    p += BINARY_HEADER_SIZE;
+    auto src = copyArray<unsigned int>(p, m);
+    p += m * sizeof(unsigned int);
+    auto dst = copyArray<unsigned int>(p, m);
+    p += m * sizeof(unsigned int);
+    auto w = copyArray<CDouble>(p, m);
+    p += m * sizeof(CDouble);
+    auto d = copyArray<CDouble>(p, m);
+    // the edge count is checked against the file size, the node count cannot be
+    try {
+        return CompactMCMgraph::fromEdges(static_cast<unsigned int>(n),
+                                          std::move(src),
+                                          std::move(dst),
+                                          std::move(w),
+                                          std::move(d));
+    } catch (const std::bad_alloc &) {
+        outOfMemory("loadBinaryMCMgraph.");
+    } catch (const std::length_error &) {
+        outOfMemory("loadBinaryMCMgraph.");
+    }
+}
+
+MCMgraph materializeMCMgraph(const CompactMCMgraph &g) {
+    MCMgraph result;
+    std::vector<MCMnode *> nodes(g.nrNodes());
+    for (unsigned int v = 0; v < g.nrNodes(); v++) {
+        nodes[v] = result.addNode(v);
+    }
+    result.reserveEdges(g.nrEdges());
+    for (unsigned int e = 0; e < g.nrEdges(); e++) {
+        result.addEdge(e, *nodes[g.source(e)], *nodes[g.destination(e)], g.weight(e), g.delay(e));
+    }
+    return result;
+}
+
+} // namespace Graphs
@@ -39,9 +39,14 @@
  *  SOFTWARE.
  */
 
+#include "base/analysis/mcm/mcmcompact.h"
 #include "base/analysis/mcm/mcmgraph.h"
+#include "base/parallel/parallel.h"
 #include "base/math/cmath.h"
+#include <algorithm>
+#include <cfloat>
 #include <climits>
+#include <cmath>
 #include <cstdint>
 
 namespace Graphs {
@@ -105,23 +110,14 @@ CDouble maximumCycleMeanKarp(MCMgraph &mcmGraph) {
     return l;
 }
 
-CDouble maximumCycleMeanKarpGeneral(MCMgraph &g) {
-    MCMgraphs sccs;
-    stronglyConnectedMCMgraph(g, sccs, false);
-
-    auto mcm = static_cast<CDouble>(-INFINITY);
-    for (auto &scc : sccs) {
-        std::map<CId, CId> nodeMap;
-        scc->relabelNodeIds(&nodeMap);
-        MCMnode *sccCriticalNode = nullptr;
-        ;
-        CDouble cmcm = maximumCycleMeanKarp(*scc);
-        if (cmcm > mcm) {
-            mcm = cmcm;
-        }
-    }
-
-    return mcm;
+CDouble maximumCycleMeanKarpGeneral(MCMgraph &g, unsigned int nrThreads) {
+    return maximumCycleMeanOverComponents(
+            g,
+            [](MCMgraph &scc, const MCMnode ** /*criticalNode*/) {
+                return maximumCycleMeanKarp(scc);
+            },
+            nullptr,
+            nrThreads);
 }
 
 /**
@@ -184,29 +180,486 @@ CDouble maximumCycleMeanKarpDouble(MCMgraph &mcmGraph, const MCMnode **criticalN
     return l;
 }
 
-CDouble maximumCycleMeanKarpDoubleGeneral(MCMgraph &g, const MCMnode **criticalNode) {
-    MCMgraphs sccs;
-    stronglyConnectedMCMgraph(g, sccs, false);
+CDouble maximumCycleMeanKarpDoubleGeneral(MCMgraph &g,
+                                          const MCMnode **criticalNode,
+                                          unsigned int nrThreads) {
+    MCMnode *critical = nullptr;
+    CDouble mcm = maximumCycleMeanOverComponents(
+            g,
+            [](MCMgraph &scc, const MCMnode **sccCriticalNode) {
+                return maximumCycleMeanKarpDouble(scc, sccCriticalNode);
+            },
+            criticalNode != nullptr ? &critical : nullptr,
+            nrThreads);
+    if (criticalNode != nullptr) {
+        *criticalNode = critical;
+    }
+    return mcm;
+}
+
+/**
+ * Karp's algorithm on a CompactMCMgraph. The distance table d[k][u] is a single
+ * contiguous array, stored at d[k * n + u]. Entries equal to -DBL_MAX stand for
+ * -infinity. The serial and the parallel version use the same functions on
+ * (ranges of) nodes, so that their results are bit-identical.
+ */
+
+// Compute the next layer dCur of the distances from dPrev for the nodes v in
+// [vBegin, vEnd).
+static void karpRelaxLayer(const CompactMCMgraph &g,
+                           const CDouble *dPrev,
+                           CDouble *dCur,
+                           unsigned int vBegin,
+                           unsigned int vEnd) {
+    for (unsigned int v = vBegin; v < vEnd; v++) {
+        CDouble dv = -DBL_MAX;
+        for (unsigned int i = g.inBegin(v); i < g.inEnd(v); i++) {
+            const unsigned int e = g.inEdge(i);
+            const CDouble du = dPrev[g.source(e)];
+            if (du != -DBL_MAX) {
+                dv = MAX(dv, du + g.weight(e));
+            }
+        }
+        dCur[v] = dv;
+    }
+}
+
+// Apply Karp's theorem to the nodes u in [uBegin, uEnd); returns the maximum
+// and stores the first node attaining it in critical (n if there is none).
+static CDouble karpMaximumOfRange(const CompactMCMgraph &g,
+                                  const std::vector<CDouble> &d,
+                                  unsigned int uBegin,
+                                  unsigned int uEnd,
+                                  unsigned int *critical) {
+    const unsigned int n = g.nrNodes();
+    auto l = static_cast<CDouble>(-INFINITY);
+    *critical = n;
+    const CDouble *dn = &d[static_cast<size_t>(n) * n];
+    for (unsigned int u = uBegin; u < uEnd; u++) {
+        if (dn[u] == -DBL_MAX) {
+            continue;
+        }
+        CDouble ld = DBL_MAX;
+        for (unsigned int k = 0; k < n; k++) {
+            const CDouble dk = d[static_cast<size_t>(k) * n + u];
+            if (dk == -DBL_MAX) {
+                continue;
+            }
+            CDouble nld = (dn[u] - dk) / static_cast<CDouble>(n - k);
+            if (nld < ld) {
+                ld = nld;
+            }
+        }
+        if (ld > l) {
+            l = ld;
+            *critical = u;
+        }
+    }
+    return l;
+}
+
+static std::vector<CDouble> karpInitialDistances(unsigned int n) {
+    // d[k][u], 1<=k<n+1 with value -inf, d[0][u] with value 0
+    std::vector<CDouble> d(static_cast<size_t>(n + 1) * n, -DBL_MAX);
+    std::fill(d.begin(), d.begin() + n, 0.0);
+    return d;
+}
+
+/**
+ * maximumCycleMeanKarpDouble ()
+ * The function computes the maximum cycle mean of a CompactMCMgraph using
+ * Karp's algorithm. The relaxation runs over the in-adjacency arrays of the
+ * graph. The graph need not be strongly connected, nor do the nodes need an
+ * outgoing edge. If the graph has no cycle, -INFINITY is returned.
+ *
+ * A critical node is only returned if criticalNode is not nullptr.
+ */
+CDouble maximumCycleMeanKarpDouble(const CompactMCMgraph &g, const MCMnode **criticalNode) {
+    const unsigned int n = g.nrNodes();
+    std::vector<CDouble> d = karpInitialDistances(n);
 
-    auto mcm = static_cast<CDouble>(-INFINITY);
+    // Compute the distances
+    for (unsigned int k = 1; k < n + 1; k++) {
+        karpRelaxLayer(
+                g, &d[static_cast<size_t>(k - 1) * n], &d[static_cast<size_t>(k) * n], 0, n);
+    }
+
+    // Compute lambda using Karp's theorem
+    unsigned int critical = n;
+    CDouble l = karpMaximumOfRange(g, d, 0, n, &critical);
+    if (criticalNode != nullptr) {
+        *criticalNode = critical < n ? g.node(critical) : nullptr;
+    }
+    return l;
+}
+
+/**
+ * Relative tolerance of the optimality test in the Hartmann-Orlin early
+ * termination of the lean Karp algorithm.
+ */
+constexpr CDouble KARP_EARLY_TERMINATION_EPSILON = 1e-12;
+
+// Find the cycles of the policy graph in which every node with a finite
+// distance in dCur points to the source of the first in-edge attaining that
+// distance from dPrev. Returns the largest mean of such a cycle, or -INFINITY,
+// and a node on that cycle in critical.
+static CDouble karpBestPolicyCycle(const CompactMCMgraph &g,
+                                   const CDouble *dPrev,
+                                   const CDouble *dCur,
+                                   unsigned int *critical) {
+    const unsigned int n = g.nrNodes();
+    const unsigned int m = g.nrEdges();
+    std::vector<unsigned int> policy(n, m);
+    for (unsigned int v = 0; v < n; v++) {
+        if (dCur[v] == -DBL_MAX) {
+            continue;
+        }
+        for (unsigned int i = g.inBegin(v); i < g.inEnd(v); i++) {
+            const unsigned int e = g.inEdge(i);
+            const CDouble du = dPrev[g.source(e)];
+            if (du != -DBL_MAX && du + g.weight(e) == dCur[v]) {
+                policy[v] = e;
+                break;
+            }
+        }
+    }
+
+    // walk the policy from every node; visited[v] is the start of the walk
+    // that first reached v
+    auto best = static_cast<CDouble>(-INFINITY);
+    std::vector<unsigned int> visited(n, n);
+    for (unsigned int start = 0; start < n; start++) {
+        unsigned int v = start;
+        while (v < n && visited[v] == n) {
+            visited[v] = start;
+            v = policy[v] < m ? g.source(policy[v]) : n;
+        }
+        if (v == n || visited[v] != start) {
+            continue;
+        }
+        // v is on a cycle found by this walk
+        CDouble weight = 0.0;
+        unsigned int length = 0;
+        unsigned int u = v;
+        do {
+            weight += g.weight(policy[u]);
+            length++;
+            u = g.source(policy[u]);
+        } while (u != v);
+        const CDouble mean = weight / static_cast<CDouble>(length);
+        if (mean > best) {
+            best = mean;
+            *critical = v;
+        }
+    }
+    return best;
+}
+
+// Test whether no cycle has a mean larger than lambda, using the potential
+// pi(v) = max_{0<=j<=k} d_j(v) - j * lambda of Hartmann and Orlin, which is
+// feasible for the weights w - lambda if and only if it satisfies every edge.
+static bool karpIsUpperBound(const CompactMCMgraph &g, CDouble lambda, unsigned int k) {
+    const unsigned int n = g.nrNodes();
+    std::vector<CDouble> prev(n, 0.0);
+    std::vector<CDouble> cur(n);
+    std::vector<CDouble> pi(n, 0.0);
+    for (unsigned int j = 1; j <= k; j++) {
+        karpRelaxLayer(g, prev.data(), cur.data(), 0, n);
+        for (unsigned int v = 0; v < n; v++) {
+            if (cur[v] != -DBL_MAX) {
+                pi[v] = MAX(pi[v], cur[v] - static_cast<CDouble>(j) * lambda);
+            }
+        }
+        prev.swap(cur);
+    }
+    for (unsigned int e = 0; e < g.nrEdges(); e++) {
+        const CDouble pu = pi[g.source(e)];
+        const CDouble pv = pi[g.destination(e)];
+        const CDouble w = g.weight(e);
+        const CDouble tolerance = KARP_EARLY_TERMINATION_EPSILON
+                                  * (std::fabs(pu) + std::fabs(w) + std::fabs(lambda)
+                                     + std::fabs(pv));
+        if (pu + w - lambda > pv + tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * maximumCycleMeanKarpLean ()
+ * Karp's algorithm on a CompactMCMgraph in O(n) memory. A first pass computes
+ * the layers 1..n of the distance table keeping only the last two; a second
+ * pass recomputes the layers 0..n-1 in order and applies Karp's theorem to
+ * each of them against the stored layer n. Without early termination the result
+ * is bit-identical to maximumCycleMeanKarpDouble.
+ *
+ * After layers 2, 4, 8, ... the first pass applies the test of Hartmann and
+ * Orlin: the best cycle of the policies that produced the tested layers gives a
+ * lower bound lambda, and if the distances computed so far yield a feasible
+ * potential for the weights w - lambda, lambda is the maximum cycle mean and
+ * the algorithm stops. This costs a recomputation of the first k layers per
+ * test, but graphs whose critical cycles are short finish after a few layers.
+ */
+CDouble maximumCycleMeanKarpLean(const CompactMCMgraph &g,
+                                 const MCMnode **criticalNode,
+                                 unsigned int *nrLayers) {
+    const unsigned int n = g.nrNodes();
     if (criticalNode != nullptr) {
         *criticalNode = nullptr;
     }
-    for (auto &scc : sccs) {
-        std::map<CId, CId> nodeMap;
-        scc->relabelNodeIds(&nodeMap);
-        const MCMnode *sccCriticalNode = nullptr;
-        ;
-        CDouble cmcm = maximumCycleMeanKarpDouble(*scc, &sccCriticalNode);
-        if (cmcm > mcm) {
-            mcm = cmcm;
+
+    // first pass, computing layer n with early termination
+    std::vector<CDouble> prev(n, 0.0);
+    std::vector<CDouble> cur(n);
+    // the best cycle found so far, a lower bound on the maximum cycle mean
+    auto lambda = static_cast<CDouble>(-INFINITY);
+    unsigned int lambdaNode = n;
+    unsigned int nextTest = 2;
+    for (unsigned int k = 1; k < n + 1; k++) {
+        karpRelaxLayer(g, prev.data(), cur.data(), 0, n);
+        if (k == nextTest && k < n) {
+            nextTest *= 2;
+            unsigned int critical = n;
+            CDouble cycleMean = karpBestPolicyCycle(g, prev.data(), cur.data(), &critical);
+            if (cycleMean > lambda) {
+                lambda = cycleMean;
+                lambdaNode = critical;
+            }
+            if (lambdaNode < n && karpIsUpperBound(g, lambda, k)) {
+                if (criticalNode != nullptr) {
+                    *criticalNode = g.node(lambdaNode);
+                }
+                if (nrLayers != nullptr) {
+                    *nrLayers = k;
+                }
+                return lambda;
+            }
+        }
+        prev.swap(cur);
+    }
+    if (nrLayers != nullptr) {
+        *nrLayers = n;
+    }
+    const std::vector<CDouble> dn(prev);
+
+    // second pass, applying Karp's theorem layer by layer
+    std::vector<CDouble> ld(n, DBL_MAX);
+    std::fill(prev.begin(), prev.end(), 0.0);
+    for (unsigned int k = 0; k < n; k++) {
+        if (k > 0) {
+            karpRelaxLayer(g, prev.data(), cur.data(), 0, n);
+            prev.swap(cur);
+        }
+        for (unsigned int u = 0; u < n; u++) {
+            if (dn[u] == -DBL_MAX || prev[u] == -DBL_MAX) {
+                continue;
+            }
+            CDouble nld = (dn[u] - prev[u]) / static_cast<CDouble>(n - k);
+            if (nld < ld[u]) {
+                ld[u] = nld;
+            }
+        }
+    }
+
+    auto l = static_cast<CDouble>(-INFINITY);
+    for (unsigned int u = 0; u < n; u++) {
+        if (dn[u] != -DBL_MAX && ld[u] > l) {
+            l = ld[u];
             if (criticalNode != nullptr) {
-                *criticalNode = g.getNode(nodeMap[sccCriticalNode->id]);
+                *criticalNode = g.node(u);
             }
         }
     }
+    return l;
+}
 
-    return mcm;
+/**
+ * Graphs with fewer edges than this are analysed by the serial Karp algorithm,
+ * as the synchronization per layer would cost more than it saves.
+ */
+constexpr unsigned int MIN_EDGES_FOR_PARALLEL_KARP = 4096;
+
+/**
+ * maximumCycleMeanKarpDoubleParallel ()
+ * Karp's algorithm on a CompactMCMgraph with every layer of the distance table
+ * computed in parallel. The nodes are split into contiguous ranges of roughly
+ * equal in-degree, one per thread. A thread only writes the entries of its own
+ * nodes and only reads the previous layer, so no atomics are needed; threads
+ * synchronize on a barrier after each layer. The maximum over the ranges is
+ * reduced in node order with the same strict comparison as the serial version.
+ */
+CDouble maximumCycleMeanKarpDoubleParallel(const CompactMCMgraph &g,
+                                           const MCMnode **criticalNode,
+                                           unsigned int nrThreads) {
+    const unsigned int n = g.nrNodes();
+    if (nrThreads == 0) {
+        nrThreads = MaxPlus::defaultThreadCount();
+    }
+    if (nrThreads > n) {
+        nrThreads = n;
+    }
+    if (nrThreads <= 1 || g.nrEdges() < MIN_EDGES_FOR_PARALLEL_KARP) {
+        return maximumCycleMeanKarpDouble(g, criticalNode);
+    }
+
+    // split the nodes into ranges of about equal work
+    std::vector<unsigned int> rangeStart(nrThreads + 1, n);
+    rangeStart[0] = 0;
+    const size_t totalWork = static_cast<size_t>(g.nrEdges()) + n;
+    unsigned int t = 1;
+    for (unsigned int v = 0; v < n && t < nrThreads; v++) {
+        const size_t work = static_cast<size_t>(g.inBegin(v)) + v;
+        if (work * nrThreads >= totalWork * t) {
+            rangeStart[t++] = v;
+        }
+    }
+    for (; t < nrThreads; t++) {
+        rangeStart[t] = n;
+    }
+
+    std::vector<CDouble> d = karpInitialDistances(n);
+    std::vector<CDouble> rangeMaximum(nrThreads);
+    std::vector<unsigned int> rangeCritical(nrThreads);
+    MaxPlus::Barrier layerDone(nrThreads);
+
+    MaxPlus::parallelRun(
+            [&](unsigned int thread, unsigned int /*nrThreads*/) {
+                const unsigned int vBegin = rangeStart[thread];
+                const unsigned int vEnd = rangeStart[thread + 1];
+                for (unsigned int k = 1; k < n + 1; k++) {
+                    karpRelaxLayer(g,
+                                   &d[static_cast<size_t>(k - 1) * n],
+                                   &d[static_cast<size_t>(k) * n],
+                                   vBegin,
+                                   vEnd);
+                    layerDone.arriveAndWait();
+                }
+                rangeMaximum[thread] =
+                        karpMaximumOfRange(g, d, vBegin, vEnd, &rangeCritical[thread]);
+            },
+            nrThreads);
+
+    auto l = static_cast<CDouble>(-INFINITY);
+    unsigned int critical = n;
+    for (unsigned int r = 0; r < nrThreads; r++) {
+        if (rangeMaximum[r] > l) {
+            l = rangeMaximum[r];
+            critical = rangeCritical[r];
+        }
+    }
+    if (criticalNode != nullptr) {
+        *criticalNode = critical < n ? g.node(critical) : nullptr;
+    }
+    return l;
+}
+
+/**
+ * maximumCycleMeanKarpDouble ()
+ * Karp's algorithm on component c of g. The distance table is indexed by the
+ * positions of the nodes in the component and the layers are relaxed over the
+ * edges of the component, so no graph is built for it. As every node of a
+ * strongly connected component with an edge has an incoming edge, the result
+ * equals that of Karp's algorithm on the component as a separate graph.
+ */
+CDouble maximumCycleMeanKarpDouble(const CompactMCMgraph &g,
+                                   const ComponentDecomposition &scc,
+                                   unsigned int c,
+                                   const MCMnode **criticalNode) {
+    if (criticalNode != nullptr) {
+        *criticalNode = nullptr;
+    }
+    if (scc.nrEdges(c) == 0) {
+        return -INFINITY;
+    }
+    const unsigned int n = scc.nrNodes(c);
+    std::vector<CDouble> d = karpInitialDistances(n);
+
+    // Compute the distances
+    for (unsigned int k = 1; k < n + 1; k++) {
+        const CDouble *dPrev = &d[static_cast<size_t>(k - 1) * n];
+        CDouble *dCur = &d[static_cast<size_t>(k) * n];
+        for (unsigned int i = scc.edgeStart[c]; i < scc.edgeStart[c + 1]; i++) {
+            const unsigned int e = scc.edges[i];
+            const CDouble du = dPrev[scc.position[g.source(e)]];
+            if (du != -DBL_MAX) {
+                CDouble &dv = dCur[scc.position[g.destination(e)]];
+                dv = MAX(dv, du + g.weight(e));
+            }
+        }
+    }
+
+    // Compute lambda using Karp's theorem
+    auto l = static_cast<CDouble>(-INFINITY);
+    unsigned int critical = n;
+    const CDouble *dn = &d[static_cast<size_t>(n) * n];
+    for (unsigned int u = 0; u < n; u++) {
+        CDouble ld = DBL_MAX;
+        for (unsigned int k = 0; k < n; k++) {
+            CDouble nld = (dn[u] - d[static_cast<size_t>(k) * n + u]) / static_cast<CDouble>(n - k);
+            if (nld < ld) {
+                ld = nld;
+            }
+        }
+        if (ld > l) {
+            l = ld;
+            critical = u;
+        }
+    }
+    if (criticalNode != nullptr) {
+        *criticalNode = g.node(scc.nodes[scc.nodeStart[c] + critical]);
+    }
+    return l;
+}
+
+/**
+ * maximumCycleMeanKarpComponents ()
+ * Karp's algorithm on every strongly connected component of g, largest
+ * components first, on up to nrThreads threads. The components are found and
+ * evaluated in place; the work is the sum over the components of the product
+ * of their numbers of nodes and edges.
+ */
+CDouble maximumCycleMeanKarpComponents(const CompactMCMgraph &g,
+                                       const MCMnode **criticalNode,
+                                       unsigned int nrThreads) {
+    const ComponentDecomposition scc = decomposeComponents(g);
+    std::vector<unsigned int> order;
+    for (unsigned int c = 0; c < scc.nrComponents; c++) {
+        if (scc.nrEdges(c) > 0) {
+            order.push_back(c);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&scc](unsigned int a, unsigned int b) {
+        return scc.nrEdges(a) > scc.nrEdges(b);
+    });
+
+    std::vector<CDouble> results(scc.nrComponents, -INFINITY);
+    std::vector<const MCMnode *> criticalNodes(scc.nrComponents, nullptr);
+    if (scc.edges.size() < MIN_EDGES_FOR_PARALLEL_KARP) {
+        nrThreads = 1;
+    }
+    MaxPlus::parallelFor(
+            0,
+            order.size(),
+            [&](size_t t) {
+                const unsigned int c = order[t];
+                results[c] = maximumCycleMeanKarpDouble(g, scc, c, &criticalNodes[c]);
+            },
+            nrThreads);
+
+    // the maximum over the components in a fixed order, independent of the threads
+    auto l = static_cast<CDouble>(-INFINITY);
+    const MCMnode *critical = nullptr;
+    for (unsigned int c = 0; c < scc.nrComponents; c++) {
+        if (results[c] > l) {
+            l = results[c];
+            critical = criticalNodes[c];
+        }
+    }
+    if (criticalNode != nullptr) {
+        *criticalNode = critical;
+    }
+    return l;
 }
 
 } // namespace Graphs
@@ -0,0 +1,128 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   mcmpaths.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Longest paths in MCM graphs.
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/analysis/mcm/mcmpaths.h"
+#include "base/exception/exception.h"
+#include <cmath>
+
+namespace Graphs {
+
+namespace {
+
+// relative amount by which a path must be longer to replace the current one,
+// so that rounding errors on cycles of length zero do not look like progress
+constexpr CDouble LONGEST_PATH_EPSILON = 1e-12;
+
+/**
+ * spfaLongestPaths ()
+ * Longest paths from root with the weight of edge e given by weight(e). Every
+ * node is in the queue at most once. A path of n edges visits some node twice,
+ * so when the longest path to a node gets n edges a positive cycle has been
+ * found.
+ */
+template <typename Weight>
+std::vector<CDouble> spfaLongestPaths(const CompactMCMgraph &g, unsigned int root, Weight weight) {
+    const unsigned int n = g.nrNodes();
+    if (root >= n) {
+        throw MaxPlus::MPException("Unknown root node in longestPaths.");
+    }
+    std::vector<CDouble> dist(n, -INFINITY);
+    std::vector<unsigned int> nrPathEdges(n, 0);
+    std::vector<bool> queued(n, false);
+    // circular queue of at most n nodes
+    std::vector<unsigned int> queue(n);
+    unsigned int head = 0;
+    unsigned int size = 0;
+
+    dist[root] = 0.0;
+    queue[0] = root;
+    queued[root] = true;
+    size = 1;
+    while (size > 0) {
+        const unsigned int u = queue[head];
+        head = head + 1 == n ? 0 : head + 1;
+        size--;
+        queued[u] = false;
+        for (unsigned int i = g.outBegin(u); i < g.outEnd(u); i++) {
+            const unsigned int e = g.outEdge(i);
+            const unsigned int v = g.destination(e);
+            const CDouble length = dist[u] + weight(e);
+            if (dist[v] != -INFINITY
+                && length <= dist[v] + LONGEST_PATH_EPSILON * (1.0 + std::fabs(dist[v]))) {
+                continue;
+            }
+            dist[v] = length;
+            nrPathEdges[v] = nrPathEdges[u] + 1;
+            if (nrPathEdges[v] >= n) {
+                throw MaxPlus::MPException("Positive cycle found in longestPaths.");
+            }
+            if (!queued[v]) {
+                queued[v] = true;
+                const unsigned int tail = head + size;
+                queue[tail >= n ? tail - n : tail] = v;
+                size++;
+            }
+        }
+    }
+    return dist;
+}
+
+} // namespace
+
+std::vector<CDouble> longestPaths(const CompactMCMgraph &g, unsigned int root) {
+    return spfaLongestPaths(g, root, [&g](unsigned int e) { return g.weight(e); });
+}
+
+std::vector<CDouble>
+normalizedLongestPaths(const CompactMCMgraph &g, unsigned int root, CDouble mu) {
+    return spfaLongestPaths(
+            g, root, [&g, mu](unsigned int e) { return g.weight(e) - mu * g.delay(e); });
+}
+
+std::vector<CDouble> normalizedLongestPaths(const CompactMCMgraph &g,
+                                            unsigned int root,
+                                            const std::vector<CDouble> &mu) {
+    if (mu.size() != g.nrNodes()) {
+        throw MaxPlus::MPException("Wrong number of values in normalizedLongestPaths.");
+    }
+    return spfaLongestPaths(g, root, [&g, &mu](unsigned int e) {
+        const CDouble m = mu[g.source(e)];
+        return std::isfinite(m) ? g.weight(e) - m * g.delay(e) : g.weight(e);
+    });
+}
+
+} // namespace Graphs
@@ -50,214 +50,252 @@
 #include "base/analysis/mcm/mcmgraph.h"
 #include "base/exception/exception.h"
 #include "base/math/cmath.h"
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace Graphs {
 
-class AlgYTO {
-public:
-    explicit AlgYTO(graph &g) : gr(g) {}
-
-private:
-    static constexpr node *NILN = nullptr;
-    static constexpr arc *NILA = nullptr;
-
-    graph &gr;
-
-    std::int32_t update_level = 0;
-    node *upd_nodes = nullptr;
-
-    static constexpr std::int32_t dh = 4L;
+/**
+ * KeyOrder
+ * Order on the keys of arcs used by the heaps. Keys that differ by at most
+ * epsilon are considered equal. With a positive epsilon, the control flow of
+ * the algorithm does not depend on the order in which the compiler schedules
+ * the floating point operations; with epsilon zero it is the plain order.
+ */
+struct KeyOrder {
+    CDouble epsilon = 0.0;
 
-    /*
-     * d_heap implementation
-     * ---------------------
-     * See R.E. Tarjan: Data Structures and Network
-     * Algorithms (Society for Industrial and Applied
-     * Mathematics)", Philadelphia, PA, 1983) for a
-     * description.
-     *
-     * Indices are numbered from 0 to hz-1 , hz =
-     * maximum heap size, therefore the parent of
-     * node x is int((x-1)/dh), dh = d_heap parameter
-     * = number of children per node, and the children
-     * of node x are the nodes in the interval
-     *
-     * [dh*x+1, dh*x+2, ..., min (dh *(x+1), hz-1)].
-     */
+    [[nodiscard]] bool less(CDouble a, CDouble b) const { return b - a > epsilon; }
+};
 
-    using item = arc *;
+/*
+ * d_heap implementation
+ * ---------------------
+ * See R.E. Tarjan: Data Structures and Network
+ * Algorithms (Society for Industrial and Applied
+ * Mathematics)", Philadelphia, PA, 1983) for a
+ * description.
+ *
+ * Indices are numbered from 0 to hz-1 , hz =
+ * maximum heap size, therefore the parent of
+ * node x is int((x-1)/dh), dh = d_heap parameter
+ * = number of children per node, and the children
+ * of node x are the nodes in the interval
+ *
+ * [dh*x+1, dh*x+2, ..., min (dh *(x+1), hz-1)].
+ *
+ * The position of an arc in the heap is kept in its h_pos field.
+ */
+template <std::int32_t dh> class DHeap {
+public:
+    explicit DHeap(std::vector<arc *> &storage) : items(storage) {}
 
-    using d_heap = struct D_heap {
-        std::int32_t max_size = 0;
-        std::int32_t size = 0;
-        std::vector<item> items;
-    };
+    void reset(graph &gr, KeyOrder o) {
+        // at most one arc per node is on the heap
+        items.resize(gr.n_nodes);
+        size = 0;
+        order = o;
+    }
 
-    d_heap h;
+    [[nodiscard]] arc *top() const { return size == 0 ? nullptr : items[0]; }
 
-#if 0
-        void printHeap()
-        {
-            cerr << "Heap: ";
-            for (std::int32_t i = 0; i < h.size; i++)
-                cerr << h.items[i]->key << ", ";
-            cerr << endl;
-        }
-#endif
+    void insert(arc *i) {
+        siftUp(i, size);
+        ++size;
+    }
 
-    [[nodiscard]] std::int32_t minChild(std::int32_t x) {
-        std::int32_t k_min = -1;
-        if (x != h.size - 1) {
-            CDouble min = DBL_MAX;
-            std::int32_t upb = 0;
-            if (h.size - 1 < dh * (x + 1)) {
-                upb = h.size - 1;
+    void remove(arc *i) {
+        arc *j = items[size - 1];
+        --size;
+        if (i != j) {
+            if (!order.less(i->key, j->key)) {
+                siftUp(j, i->h_pos);
             } else {
-                upb = dh * (x + 1);
-            }
-
-            for (std::int32_t k = dh * x + 1; k <= upb; k++) {
-                if (h.items[k]->key < min) {
-                    min = h.items[k]->key;
-                    k_min = k;
-                }
+                siftDown(j, i->h_pos);
             }
         }
-
-        return (k_min);
     }
 
-    [[nodiscard]] std::int32_t minChildRobust(std::int32_t x, CDouble epsilon) {
+private:
+    std::vector<arc *> &items;
+    std::int32_t size = 0;
+    KeyOrder order;
+
+    [[nodiscard]] std::int32_t minChild(std::int32_t x) const {
         std::int32_t k_min = -1;
-        if (x != h.size - 1) {
+        if (x != size - 1) {
             CDouble min = DBL_MAX;
-            std::int32_t upb = 0;
-            if (h.size - 1 < dh * (x + 1)) {
-                upb = h.size - 1;
-            } else {
-                upb = dh * (x + 1);
-            }
-
+            std::int32_t upb = std::min(size - 1, dh * (x + 1));
             for (std::int32_t k = dh * x + 1; k <= upb; k++) {
-                if (min - h.items[k]->key > epsilon) {
-                    min = h.items[k]->key;
+                if (order.less(items[k]->key, min)) {
+                    min = items[k]->key;
                     k_min = k;
                 }
             }
         }
-
-        return (k_min);
+        return k_min;
     }
 
-    void SiftDown(item i, std::int32_t x) {
+    void siftDown(arc *i, std::int32_t x) {
         std::int32_t c = minChild(x);
-        while (c >= 0 && h.items[c]->key < i->key) {
+        while (c >= 0 && order.less(items[c]->key, i->key)) {
             std::int32_t cc = minChild(c);
-            h.items[x] = h.items[c];
-            h.items[x]->h_pos = x;
-            x = c;
-            c = cc;
-        }
-        h.items[x] = i;
-        i->h_pos = x;
-    }
-
-    void SiftDownRobust(item i, std::int32_t x, CDouble epsilon) {
-        std::int32_t c = minChildRobust(x, epsilon);
-        while (c >= 0 && i->key - h.items[c]->key > epsilon) {
-            std::int32_t cc = minChildRobust(c, epsilon);
-            h.items[x] = h.items[c];
-            h.items[x]->h_pos = x;
+            items[x] = items[c];
+            items[x]->h_pos = x;
             x = c;
             c = cc;
         }
-        h.items[x] = i;
+        items[x] = i;
         i->h_pos = x;
     }
 
-    void SiftUp(item i, std::int32_t x) {
+    void siftUp(arc *i, std::int32_t x) {
         std::int32_t p = (x == 0) ? -1 : (x - 1) / dh;
-        while (p >= 0 && h.items[p]->key > i->key) {
-            h.items[x] = h.items[p];
-            (h.items[x])->h_pos = x;
+        while (p >= 0 && order.less(i->key, items[p]->key)) {
+            items[x] = items[p];
+            items[x]->h_pos = x;
             x = p;
             p = (p == 0) ? -1 : (p - 1) / dh;
         }
-        h.items[x] = i;
+        items[x] = i;
         i->h_pos = x;
     }
+};
 
-    void SiftUpRobust(item i, std::int32_t x, CDouble epsilon) {
-        std::int32_t p = (x == 0) ? -1 : (x - 1) / dh;
-        while (p >= 0 && h.items[p]->key - i->key > epsilon) {
-            h.items[x] = h.items[p];
-            (h.items[x])->h_pos = x;
-            x = p;
-            p = (p == 0) ? -1 : (p - 1) / dh;
-        }
-        h.items[x] = i;
-        i->h_pos = x;
+/*
+ * pairing heap implementation
+ * ---------------------------
+ * See M.L. Fredman, R. Sedgewick, D.D. Sleator, R.E. Tarjan: "The Pairing
+ * Heap: A New Form of Self-Adjusting Heap", Algorithmica 1 (1986), 111-129.
+ *
+ * The heap is a multi-way tree that is kept as a child / sibling binary tree.
+ * For every arc, identified by its index in the arcs array of the graph, the
+ * links array holds its first child, its next sibling and its previous sibling
+ * or, for a first child, its parent. Inserting is a constant time meld;
+ * removing an arc cuts its subtree and melds its children with a two-pass
+ * pairing. The algorithm removes an arc from the heap for every node of every
+ * subtree it moves, so cheap removals pay off when subtrees are large.
+ */
+class PairingHeap {
+public:
+    PairingHeap(std::vector<std::int32_t> &linkStorage, std::vector<std::int32_t> &scratchStorage) :
+        links(linkStorage), scratch(scratchStorage) {}
+
+    void reset(graph &gr, KeyOrder o) {
+        arcs = gr.arcs.data();
+        links.resize(3 * gr.arcs.size());
+        root = NIL;
+        order = o;
     }
 
-    void Insert(item i) {
-        SiftUp(i, h.size);
-        ++(h.size);
-    }
+    [[nodiscard]] arc *top() const { return root == NIL ? nullptr : &arcs[root]; }
 
-    void InsertRobust(item i, CDouble epsilon) {
-        SiftUpRobust(i, h.size, epsilon);
-        ++(h.size);
+    void insert(arc *a) {
+        std::int32_t i = index(a);
+        child(i) = NIL;
+        next(i) = NIL;
+        prev(i) = NIL;
+        root = root == NIL ? i : meld(root, i);
     }
 
-    void Delete(item i) {
-        item j = h.items[h.size - 1];
-        --(h.size);
-        if (i != j) {
-            if (j->key <= i->key) {
-                SiftUp(j, i->h_pos);
-            } else {
-                SiftDown(j, i->h_pos);
-            }
+    void remove(arc *a) {
+        std::int32_t i = index(a);
+        if (i == root) {
+            root = combine(child(i));
+            return;
         }
-    }
-
-    void DeleteRobust(item i, CDouble epsilon) {
-        item j = h.items[h.size - 1];
-        --(h.size);
-        if (i != j) {
-            if (!(j->key - i->key > epsilon)) {
-                SiftUpRobust(j, i->h_pos, epsilon);
-            } else {
-                SiftDownRobust(j, i->h_pos, epsilon);
-            }
+        // cut the subtree rooted at i from the tree
+        std::int32_t p = prev(i);
+        if (child(p) == i) {
+            child(p) = next(i);
+        } else {
+            next(p) = next(i);
+        }
+        if (next(i) != NIL) {
+            prev(next(i)) = p;
+        }
+        std::int32_t sub = combine(child(i));
+        if (sub != NIL) {
+            root = meld(root, sub);
         }
     }
 
-    item DeleteMin() {
-        if (h.size == 0) {
-            return (NILA);
+private:
+    static constexpr std::int32_t NIL = -1;
+
+    std::vector<std::int32_t> &links;
+    std::vector<std::int32_t> &scratch;
+    arc *arcs = nullptr;
+    std::int32_t root = NIL;
+    KeyOrder order;
+
+    [[nodiscard]] std::int32_t index(const arc *a) const {
+        return static_cast<std::int32_t>(a - arcs);
+    }
+    std::int32_t &child(std::int32_t i) { return links[3 * i]; }
+    std::int32_t &next(std::int32_t i) { return links[3 * i + 1]; }
+    std::int32_t &prev(std::int32_t i) { return links[3 * i + 2]; }
+
+    // meld two trees whose roots have no siblings; the first one wins ties
+    std::int32_t meld(std::int32_t a, std::int32_t b) {
+        if (order.less(arcs[b].key, arcs[a].key)) {
+            std::swap(a, b);
+        }
+        next(b) = child(a);
+        if (child(a) != NIL) {
+            prev(child(a)) = b;
         }
-        item i = h.items[0];
-        Delete(i);
-        return (i);
+        prev(b) = a;
+        child(a) = b;
+        return a;
     }
 
-    [[nodiscard]] item GetMin() const {
-        if (h.size == 0) {
-            return (NILA);
+    // meld a list of siblings into a single tree with the two-pass pairing
+    std::int32_t combine(std::int32_t first) {
+        if (first == NIL) {
+            return NIL;
+        }
+        scratch.clear();
+        for (std::int32_t i = first; i != NIL;) {
+            std::int32_t n = next(i);
+            next(i) = NIL;
+            prev(i) = NIL;
+            scratch.push_back(i);
+            i = n;
         }
-        return (h.items[0]);
+        size_t nr = 0;
+        for (size_t k = 0; k < scratch.size(); k += 2) {
+            scratch[nr++] = k + 1 < scratch.size() ? meld(scratch[k], scratch[k + 1]) : scratch[k];
+        }
+        std::int32_t r = scratch[nr - 1];
+        for (size_t k = nr - 1; k > 0; k--) {
+            r = meld(scratch[k - 1], r);
+        }
+        return r;
     }
+};
 
-    void AllocHeap(std::int32_t k) {
-        h.items.resize(k);
-        h.max_size = k;
-        h.size = 0;
-    }
+template <class Heap> class AlgYTO {
+public:
+    AlgYTO(graph &g, Heap &heap) : gr(g), h(heap) {}
+
+private:
+    static constexpr node *NILN = nullptr;
+    static constexpr arc *NILA = nullptr;
+
+    // relative tolerance on transit times, costs and their ratios, see mmcycle
+    static constexpr CDouble MCR_EPSILON_RATIO = 1.0e-8L;
+
+    graph &gr;
+    Heap &h;
+
+    std::int32_t update_level = 0;
+    node *upd_nodes = nullptr;
 
     /**
      * update_subtree ()
@@ -300,13 +338,10 @@ public:
      * Due to the order in which floating point calculations are scheduled, the
      * algorithm's control flow may follow different paths and lead to different
      * critical cycles as the output.
-     * The function mmcycle_robust implements a version of the algorithm that is
-     * deterministic across compilers. It may be a little slower.
-     *
-     * Input parameter:
-     * ---------------
-     * gr     - graph structure with incidence lists of
-     *          incoming and outgoing edges for each node
+     * Therefore transit times, costs and keys are compared with a tolerance of
+     * a constant fraction of the smallest observed values, which makes the
+     * algorithm deterministic across compilers. The vertex keys are kept in
+     * the heap with which the class is instantiated.
      *
      * Output parameters:
      * -----------------
@@ -316,10 +351,8 @@ public:
      *          ordered in array from top to bottom with
      *          respect to subsequent arcs on cycle
      *
-     * len    - number of elements of "cycle"
-     *
-     * If cycle or len is a nullptr-pointer, then these parameters
-     * are not assigned a value.
+     * If cycle is a nullptr-pointer, then it is not
+     * assigned a value.
      *
      * Reference
      * ---------
@@ -384,284 +417,7 @@ public:
      *
      * 9) goto (6);
      */
-    void mmcycle(graph &gr, CDouble *lambda, std::shared_ptr<std::vector<const arc *>> *cycle) {
-
-        // set up initial tree
-        node *s_ptr = gr.vs;
-        s_ptr->in_list = false;
-        s_ptr->cost_t = 0.0L;
-        s_ptr->transit_time_t = 0.0L;
-        s_ptr->level = 0L;
-        s_ptr->parent_in = NILA;
-        s_ptr->left_sibling = s_ptr;
-        s_ptr->right_sibling = s_ptr;
-        arc *a_ptr = s_ptr->first_arc_out;
-        node *v_ptr = a_ptr->head;
-        s_ptr->first_child = v_ptr;
-        while (a_ptr != NILA) {
-            node *w_ptr = a_ptr->head;
-            w_ptr->cost_t = 0.0L;
-            w_ptr->transit_time_t = 0.0L;
-            w_ptr->level = 1L;
-            w_ptr->parent_in = a_ptr;
-            w_ptr->first_child = NILN;
-            w_ptr->left_sibling = v_ptr;
-            v_ptr->right_sibling = w_ptr;
-            w_ptr->in_list = false;
-            a_ptr->in_tree = true;
-            a_ptr->h_pos = -1; // arc does not go into heap
-            a_ptr->key = DBL_MAX;
-            v_ptr = w_ptr;
-            a_ptr = a_ptr->next_out;
-        }
-        s_ptr->first_child->left_sibling = v_ptr;
-        v_ptr->right_sibling = s_ptr->first_child;
-
-        // determine upper bound on lambda, can be used as 'infinity'
-        // adds up all costs, and divide by smallest non-zero transit time
-        // requires that there are no cycles with zero transit time!
-        // Also, determine epsilon value on transit times, cost and cost/time ratios
-        // as a constant fraction of the smallest observed values
-        CDouble total_cost_plus_one = 1.0;
-        CDouble min_transit_time = DBL_MAX;
-        for (auto &a : gr.arcs) {
-            // add costs to total cost
-            total_cost_plus_one += fabs(a.cost);
-            // keep min of transit times
-            if (a.transit_time > 0.0L) {
-                if (a.transit_time < min_transit_time) {
-                    min_transit_time = a.transit_time;
-                }
-            }
-        }
-        CDouble infty = total_cost_plus_one / min_transit_time;
-
-        // initial keys of non tree edges are equal to arc costs
-        for (auto &a : gr.arcs) {
-            if (a.transit_time > 0) {
-                a.key = a.cost / a.transit_time;
-            } else {
-                a.key = infty;
-            }
-            a.in_tree = false;
-        }
-
-        // d-heap used for maintenance of vertex keys
-        AllocHeap(gr.n_nodes);
-
-        // compute initial vertex keys
-        for (auto &v : gr.nodes) {
-            CDouble min = DBL_MAX;
-            arc *vmin_a_ptr = NILA;
-            a_ptr = v.first_arc_in;
-            while (a_ptr != NILA) {
-                if (!a_ptr->in_tree && a_ptr->key < min) {
-                    min = a_ptr->key;
-                    vmin_a_ptr = a_ptr;
-                }
-                a_ptr = a_ptr->next_in;
-            }
-            v.v_key = vmin_a_ptr;
-            if (vmin_a_ptr != NILA) {
-                Insert(vmin_a_ptr);
-            }
-        }
-        gr.vs->v_key = NILA;
-        arc *min_a_ptr = nullptr;
-
-        while (true) {
-            min_a_ptr = GetMin();
-            // should be element on heap
-            assert((min_a_ptr != NILA));
-
-            *lambda = min_a_ptr->key;
-            if (*lambda >= infty) {
-                min_a_ptr = NILA;
-                break; // input graph is acyclic in this case
-            }
-
-            node *uptr = min_a_ptr->tail;
-            v_ptr = min_a_ptr->head;
-
-            /* check if *vptr is an ancestor of *uptr in tree */
-
-            bool foundCycle = false;
-            arc *par_a_ptr = uptr->parent_in;
-
-            // MG: below is a fix, not in the original algorithm, since the original algorithm
-            // does not seem to anticipate the possibility of self-edges in the graph.
-            if (uptr == v_ptr) {
-                // statement below was added to make the calculation of the critical cycle work
-                // correctly for critical self-edges.
-                uptr->parent_in = min_a_ptr;
-                break;
-            }
-
-            while (par_a_ptr != NILA) {
-                if (par_a_ptr->tail == v_ptr) {
-                    foundCycle = true;
-                    break;
-                }
-                par_a_ptr = par_a_ptr->tail->parent_in;
-            }
-            if (foundCycle) {
-                break;
-            }
-
-            // it is not, remove edge (parent(v),v) from tree and make edge (u,v) a
-            // tree edge instead
-            par_a_ptr = v_ptr->parent_in;
-            par_a_ptr->in_tree = false;
-            min_a_ptr->in_tree = true;
-
-            v_ptr->cost_t = uptr->cost_t + min_a_ptr->cost;
-            v_ptr->transit_time_t = uptr->transit_time_t + min_a_ptr->transit_time;
-            node *w_ptr = par_a_ptr->tail;
-
-            // delete link (w_ptr,v_ptr) from tree
-            if (v_ptr->right_sibling == v_ptr) {
-                w_ptr->first_child = NILN;
-            } else {
-                v_ptr->right_sibling->left_sibling = v_ptr->left_sibling;
-                v_ptr->left_sibling->right_sibling = v_ptr->right_sibling;
-                if (w_ptr->first_child == v_ptr) {
-                    w_ptr->first_child = v_ptr->right_sibling;
-                }
-            }
-
-            // insert link (uptr,vptr) into tree
-            v_ptr->parent_in = min_a_ptr;
-            if (uptr->first_child == NILN) {
-                uptr->first_child = v_ptr;
-                v_ptr->right_sibling = v_ptr;
-                v_ptr->left_sibling = v_ptr;
-            } else {
-                v_ptr->right_sibling = uptr->first_child->right_sibling;
-                uptr->first_child->right_sibling->left_sibling = v_ptr;
-                v_ptr->left_sibling = uptr->first_child;
-                uptr->first_child->right_sibling = v_ptr;
-            }
-
-            // subtree rooted at v has u as parent node now, update level and cost
-            // entries of its nodes accordingly and produce list of nodes contained
-            // in subtree
-            upd_nodes = NILN;
-            update_level = uptr->level + 1;
-
-            update_subtree(v_ptr);
-            // now compute new keys of arcs into nodes that have acquired a new
-            // shortest path, such arcs have head or tail in the subtree rooted at
-            // "vptr", update vertex keys at the same time, nodes to be checked are
-            // those contained in the subtree and the ones pointed to by arcs
-            // emanating from nodes in the subtree
-            v_ptr = upd_nodes;
-            while (v_ptr != NILN) {
-                if (v_ptr->v_key != NILA) {
-                    Delete(v_ptr->v_key);
-                }
-                CDouble min = DBL_MAX;
-                arc *vmin_a_ptr = NILA;
-                a_ptr = v_ptr->first_arc_in;
-                while (a_ptr != NILA) {
-                    if (!a_ptr->in_tree) {
-                        uptr = a_ptr->tail;
-                        a_ptr->key =
-                                uptr->transit_time_t + a_ptr->transit_time > v_ptr->transit_time_t
-                                        ? static_cast<CDouble>(uptr->cost_t + a_ptr->cost
-                                                               - v_ptr->cost_t)
-                                                  / static_cast<CDouble>(uptr->transit_time_t
-                                                                         + a_ptr->transit_time
-                                                                         - v_ptr->transit_time_t)
-                                        : infty;
-
-                        if (a_ptr->key < min) {
-                            min = a_ptr->key;
-                            vmin_a_ptr = a_ptr;
-                        }
-                    }
-                    a_ptr = a_ptr->next_in;
-                }
-                if (vmin_a_ptr != NILA) {
-                    Insert(vmin_a_ptr);
-                }
-                v_ptr->v_key = vmin_a_ptr;
-
-                v_ptr = v_ptr->link;
-            }
-
-            min_a_ptr->key = DBL_MAX;
-
-            // now update keys of arcs from nodes in subtree to nodes not contained
-            // in subtree and update vertex keys for the latter if necessary
-            v_ptr = upd_nodes;
-            while (v_ptr != NILN) {
-                a_ptr = v_ptr->first_arc_out;
-                while (a_ptr != NILA) {
-                    if (!a_ptr->in_tree && !a_ptr->head->in_list) {
-                        w_ptr = a_ptr->head;
-                        CDouble a_key =
-                                v_ptr->transit_time_t + a_ptr->transit_time > w_ptr->transit_time_t
-                                        ? static_cast<CDouble>(v_ptr->cost_t + a_ptr->cost
-                                                               - w_ptr->cost_t)
-                                                  / static_cast<CDouble>(v_ptr->transit_time_t
-                                                                         + a_ptr->transit_time
-                                                                         - w_ptr->transit_time_t)
-                                        : infty;
-
-                        if (a_key < w_ptr->v_key->key) {
-                            Delete(w_ptr->v_key);
-                            a_ptr->key = a_key;
-                            Insert(a_ptr);
-                            w_ptr->v_key = a_ptr;
-                        } else {
-                            a_ptr->key = a_key;
-                        }
-                    }
-                    a_ptr = a_ptr->next_out;
-                }
-                v_ptr = v_ptr->link;
-            }
-
-            v_ptr = upd_nodes;
-            while (v_ptr != NILN) {
-                v_ptr->in_list = false;
-                v_ptr = v_ptr->link;
-            }
-        }
-
-        if (cycle != nullptr) {
-            *cycle = std::make_shared<std::vector<const arc *>>();
-            if (min_a_ptr != NILA) {
-                (*cycle)->push_back(min_a_ptr);
-                a_ptr = min_a_ptr->tail->parent_in;
-                while (a_ptr->head != min_a_ptr->head) {
-                    (*cycle)->push_back(a_ptr);
-                    a_ptr = a_ptr->tail->parent_in;
-                }
-            }
-        }
-    }
-
-    /**
-     * mmcycle_robust ()
-     *
-     * Determines maximum ratio cycle in a directed graph in a robust way
-     * G = (V, E, c), c: E->IR a "cost" function on the
-     * edges, alternatively called "length" or "weight".
-     * It has been observed that the mmcycle algorithm can behave non - deterministically
-     * across compilers, when the graph has multiple equally critical cycles
-     * Due to the order in which floating point calculations are scheduled, the
-     * algorithm's control flow may follow different paths and lead to different
-     * critical cycles as the output.
-     * This function mmcycle_robust implements a version of the algorithm that is
-     * deterministic across compilers. It may be a little slower.
-     * For more info about the algorithm, see the mmcycle function.
-     *
-     * TODO: see if the algorithms can be unified to remove duplicate code
-     **/
-
-    void mmcycle_robust(graph &gr, CDouble *lambda, std::vector<const arc *> *cycle) {
-        const CDouble MCR_EPSILON_RATIO = 1.0e-8L;
+    void mmcycle(CDouble *lambda, std::vector<const arc *> *cycle) {
 
         // set up initial tree
         node *s_ptr = gr.vs;
@@ -720,7 +476,7 @@ public:
         }
         CDouble infty = total_cost_plus_one / min_transit_time;
         CDouble epsilon_transit_time = MCR_EPSILON_RATIO * min_transit_time;
-        CDouble epsilon_cost_time_ratio = MCR_EPSILON_RATIO * (min_cost / min_transit_time);
+        const KeyOrder order{MCR_EPSILON_RATIO * (min_cost / min_transit_time)};
 
         // initial keys of non tree edges are equal to arc costs
         for (auto &a : gr.arcs) {
@@ -732,9 +488,8 @@ public:
             a.in_tree = false;
         }
 
-        // d-heap used for maintenance of vertex keys
-        // d_heap h;
-        AllocHeap(gr.n_nodes);
+        // heap used for maintenance of vertex keys
+        h.reset(gr, order);
 
         // compute initial vertex keys
         for (auto &v : gr.nodes) {
@@ -742,7 +497,7 @@ public:
             arc *vmin_a_ptr = NILA;
             a_ptr = v.first_arc_in;
             while (a_ptr != NILA) {
-                if (!a_ptr->in_tree && (min - a_ptr->key > epsilon_cost_time_ratio)) {
+                if (!a_ptr->in_tree && order.less(a_ptr->key, min)) {
                     min = a_ptr->key;
                     vmin_a_ptr = a_ptr;
                 }
@@ -750,7 +505,7 @@ public:
             }
             v.v_key = vmin_a_ptr;
             if (vmin_a_ptr != NILA) {
-                InsertRobust(vmin_a_ptr, epsilon_cost_time_ratio);
+                h.insert(vmin_a_ptr);
             }
         }
         gr.vs->v_key = NILA;
@@ -758,7 +513,7 @@ public:
         arc *min_a_ptr = nullptr;
 
         while (true) {
-            min_a_ptr = GetMin();
+            min_a_ptr = h.top();
             // there must be an element on the heap
             assert(min_a_ptr != NILA);
 
@@ -845,7 +600,7 @@ public:
             v_ptr = upd_nodes;
             while (v_ptr != NILN) {
                 if (v_ptr->v_key != NILA) {
-                    DeleteRobust(v_ptr->v_key, epsilon_cost_time_ratio);
+                    h.remove(v_ptr->v_key);
                 }
                 CDouble min = DBL_MAX;
                 arc *vmin_a_ptr = NILA;
@@ -862,7 +617,7 @@ public:
                             a_ptr->key = infty;
                         }
 
-                        if (min - a_ptr->key > epsilon_cost_time_ratio) {
+                        if (order.less(a_ptr->key, min)) {
                             min = a_ptr->key;
                             vmin_a_ptr = a_ptr;
                         }
@@ -870,7 +625,7 @@ public:
                     a_ptr = a_ptr->next_in;
                 }
                 if (vmin_a_ptr != NILA) {
-                    InsertRobust(vmin_a_ptr, epsilon_cost_time_ratio);
+                    h.insert(vmin_a_ptr);
                 }
                 v_ptr->v_key = vmin_a_ptr;
                 v_ptr = v_ptr->link;
@@ -895,10 +650,10 @@ public:
                         } else {
                             a_key = infty;
                         }
-                        if (w_ptr->v_key->key - a_key > epsilon_cost_time_ratio) {
-                            DeleteRobust(w_ptr->v_key, epsilon_cost_time_ratio);
+                        if (order.less(a_key, w_ptr->v_key->key)) {
+                            h.remove(w_ptr->v_key);
                             a_ptr->key = a_key;
-                            InsertRobust(a_ptr, epsilon_cost_time_ratio);
+                            h.insert(a_ptr);
                             w_ptr->v_key = a_ptr;
                         } else {
                             a_ptr->key = a_key;
@@ -917,7 +672,7 @@ public:
         }
 
         if (cycle != nullptr) {
-            *cycle = std::vector<const arc *>();
+            cycle->clear();
             if (min_a_ptr != NILA) {
                 cycle->push_back(min_a_ptr);
                 a_ptr = min_a_ptr->tail->parent_in;
@@ -930,6 +685,42 @@ public:
     }
 };
 
+/**
+ * mmcycle ()
+ * Run Young-Tarjan-Orlin's algorithm on the graph in the workspace with the
+ * heap selected in the workspace.
+ */
+static void mmcycle(YTOWorkspace &ws, CDouble *lambda, std::vector<const arc *> *cycle) {
+    switch (ws.heap) {
+    case YTOHeap::BinaryHeap: {
+        DHeap<2> h(ws.heapItems);
+        AlgYTO<DHeap<2>>(ws.gr, h).mmcycle(lambda, cycle);
+        break;
+    }
+    case YTOHeap::FourAryHeap: {
+        DHeap<4> h(ws.heapItems);
+        AlgYTO<DHeap<4>>(ws.gr, h).mmcycle(lambda, cycle);
+        break;
+    }
+    case YTOHeap::EightAryHeap: {
+        DHeap<8> h(ws.heapItems);
+        AlgYTO<DHeap<8>>(ws.gr, h).mmcycle(lambda, cycle);
+        break;
+    }
+    case YTOHeap::PairingHeap: {
+        PairingHeap h(ws.heapLinks, ws.heapScratch);
+        AlgYTO<PairingHeap>(ws.gr, h).mmcycle(lambda, cycle);
+        break;
+    }
+    }
+}
+
+void mmcycle(graph &gr, CDouble *lambda, std::vector<const arc *> *cycle) {
+    std::vector<arc *> heapItems;
+    DHeap<4> h(heapItems);
+    AlgYTO<DHeap<4>>(gr, h).mmcycle(lambda, cycle);
+}
+
 /**
  * convertMCMgraphToYTOgraph ()
  * The function converts a weighted directed graph used in the MCM algorithms
@@ -1047,6 +838,64 @@ void convertMCMgraphToYTOgraph(MCMgraph &g,
 #endif
 }
 
+/**
+ * convertMCMgraphToYTOgraph ()
+ * The function converts a compact graph to graph input for Young-Tarjan-Orlin's
+ * algorithm. The arrays cost and transit_time are indexed by edge; a nullptr
+ * stands for a unit cost or transit time on every edge.
+ */
+void convertMCMgraphToYTOgraph(const CompactMCMgraph &g,
+                               graph &gr,
+                               const std::vector<CDouble> *cost,
+                               const std::vector<CDouble> *transit_time) {
+
+    gr.n_nodes = static_cast<int>(g.nrNodes());
+    gr.n_arcs = static_cast<int>(g.nrEdges());
+    // allocate space for the nodes, plus one for the exta source node that will be added
+    gr.nodes.resize(gr.n_nodes + 1);
+    gr.arcs.resize(gr.n_arcs + gr.n_nodes);
+
+    // create nodes, the dense node numbers of the compact graph are used as index
+    for (int i = 0; i < gr.n_nodes; i++) {
+        node &x = gr.nodes[i];
+        x.id = i + 1;
+        x.first_arc_out = nullptr;
+        x.first_arc_in = nullptr;
+    }
+
+    // create arcs
+    for (int aidx = 0; aidx < gr.n_arcs; aidx++) {
+        const auto e = static_cast<unsigned int>(aidx);
+        arc &a = gr.arcs[aidx];
+        a.tail = &(gr.nodes[g.source(e)]);
+        a.head = &(gr.nodes[g.destination(e)]);
+        a.cost = cost == nullptr ? 1.0 : (*cost)[e];
+        a.transit_time = transit_time == nullptr ? 1.0 : (*transit_time)[e];
+        a.next_out = a.tail->first_arc_out;
+        a.tail->first_arc_out = &a;
+        a.next_in = a.head->first_arc_in;
+        a.head->first_arc_in = &a;
+        a.mcmEdge = g.edge(e);
+    }
+
+    // Create a source node which has an edge to all nodes
+    gr.vs = &(gr.nodes[gr.n_nodes]);
+    gr.vs->id = 0;
+    gr.vs->first_arc_out = nullptr;
+    gr.vs->first_arc_in = nullptr;
+    for (int i = 0; i < gr.n_nodes; i++) {
+        arc &a = gr.arcs[gr.n_arcs + i];
+        a.cost = 0;
+        a.transit_time = 0.0;
+        a.tail = gr.vs;
+        a.head = &(gr.nodes[i]);
+        a.next_out = gr.vs->first_arc_out;
+        gr.vs->first_arc_out = &a;
+        a.next_in = a.head->first_arc_in;
+        a.head->first_arc_in = &a;
+    }
+}
+
 /**
  * constOne ()
  * The function returns the unit cost associated with an edge.
@@ -1065,6 +914,59 @@ CDouble getWeight(const MCMedge &e) { return e.w; }
  */
 CDouble getDelay(const MCMedge &e) { return e.d; }
 
+/**
+ * The following functions run Young-Tarjan-Orlin's algorithm on a converted
+ * graph and translate the critical cycle back to the MCMedges from which the
+ * arcs were constructed, in the order in which the cycle is traversed.
+ */
+static void orderCycle(std::vector<const MCMedge *> *cycle) {
+    // put the edges of the cycle in the order in which they are traversed,
+    // starting from the first edge
+    std::unordered_map<const MCMnode *, const MCMedge *> edgeFrom;
+    for (const auto *e : *cycle) {
+        edgeFrom[e->src] = e;
+    }
+    for (size_t i = 1; i < cycle->size(); i++) {
+        (*cycle)[i] = edgeFrom[(*cycle)[i - 1]->dst];
+    }
+}
+
+// Run the algorithm on the graph in the workspace and translate the arcs of the
+// critical cycle, if requested, to their MCMedges. The arcs are listed following
+// the edges backwards; reverse them if the cycle is to be traversed forwards.
+static CDouble runYTO(YTOWorkspace &ws, std::vector<const MCMedge *> *cycle, bool reverse) {
+    CDouble min_cr = 0;
+    if (cycle != nullptr) {
+        mmcycle(ws, &min_cr, &ws.cycle);
+
+        size_t len = ws.cycle.size();
+        cycle->resize(len);
+        for (size_t i = 0; i < len; i++) {
+            (*cycle)[i] = ws.cycle[reverse ? len - 1 - i : i]->mcmEdge;
+        }
+        orderCycle(cycle);
+    } else {
+        mmcycle(ws, &min_cr, nullptr);
+    }
+    return min_cr;
+}
+
+static CDouble maxCycleMeanOfYTOgraph(YTOWorkspace &ws, std::vector<const MCMedge *> *cycle) {
+    // Find maximum cycle mean
+    return 1.0 / runYTO(ws, cycle, false);
+}
+
+static CDouble maxCycleRatioOfYTOgraph(YTOWorkspace &ws, std::vector<const MCMedge *> *cycle) {
+    // Find maximum cycle ratio; note that mmcycle returns the critical cycle following
+    // edges backwards, therefore reverse the order of the edges.
+    return 1.0 / runYTO(ws, cycle, true);
+}
+
+static CDouble minCycleRatioOfYTOgraph(YTOWorkspace &ws, std::vector<const MCMedge *> *cycle) {
+    // Find minimum cycle ratio
+    return runYTO(ws, cycle, false);
+}
+
 /**
  * maxCycleMeanAndCriticalCycleYoungTarjanOrlin ()
  * The function computes the maximum cycle mean of edge weight of
@@ -1080,36 +982,48 @@ CDouble getDelay(const MCMedge &e) { return e.d; }
  */
 CDouble maxCycleMeanAndCriticalCycleYoungTarjanOrlin(MCMgraph &mcmGraph,
                                                      std::vector<const MCMedge *> *cycle) {
-    graph ytoGraph;
+    YTOWorkspace ws;
 
     // Convert the graph to an input graph for the YTO algorithm
-    convertMCMgraphToYTOgraph(mcmGraph, ytoGraph, constOne, getWeight);
-
-    AlgYTO alg(ytoGraph);
-
-    CDouble min_cr = 0;
-    if (cycle != nullptr) {
-        std::vector<const arc *> ytoCycle;
-
-        // Find maximum cycle mean
-        std::int32_t ytoCycLen = 0;
-        alg.mmcycle_robust(ytoGraph, &min_cr, &ytoCycle);
-
-        size_t len = ytoCycle.size();
+    convertMCMgraphToYTOgraph(mcmGraph, ws.gr, constOne, getWeight);
 
-        *cycle = std::vector<const MCMedge *>(len);
-        for (uint i = 0; i < len; i++) {
-            (*cycle).at(i) = ytoCycle.at(i)->mcmEdge;
-        }
+    return maxCycleMeanOfYTOgraph(ws, cycle);
+}
 
-    } else {
-        // Find maximum cycle mean without cycle
-        alg.mmcycle_robust(ytoGraph, &min_cr, nullptr);
+/**
+ * maxCycleMeanAndCriticalCycleYoungTarjanOrlin ()
+ * As above, for a compact graph. The node numbering of the compact graph is
+ * dense by construction, so the graph may contain hidden nodes and edges.
+ * The mean is the inverse of the minimum ratio of edge count over weight, which
+ * requires positive weights. Otherwise all weights are shifted by a constant to
+ * make them positive; every cycle mean shifts by exactly that constant.
+ */
+CDouble maxCycleMeanAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                     std::vector<const MCMedge *> *cycle,
+                                                     YTOWorkspace &ws) {
+    const std::vector<CDouble> &weights = g.weights();
+    CDouble minWeight = INFINITY;
+    for (CDouble w : weights) {
+        minWeight = std::min(minWeight, w);
+    }
+    if (minWeight > 0) {
+        convertMCMgraphToYTOgraph(g, ws.gr, nullptr, &weights);
+        return maxCycleMeanOfYTOgraph(ws, cycle);
     }
 
-    // Cleanup
+    const CDouble shift = 1.0 - minWeight;
+    std::vector<CDouble> shifted(weights.size());
+    for (size_t e = 0; e < weights.size(); e++) {
+        shifted[e] = weights[e] + shift;
+    }
+    convertMCMgraphToYTOgraph(g, ws.gr, nullptr, &shifted);
+    return maxCycleMeanOfYTOgraph(ws, cycle) - shift;
+}
 
-    return 1.0 / min_cr;
+CDouble maxCycleMeanAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                     std::vector<const MCMedge *> *cycle) {
+    YTOWorkspace ws;
+    return maxCycleMeanAndCriticalCycleYoungTarjanOrlin(g, cycle, ws);
 }
 
 /**
@@ -1122,6 +1036,10 @@ CDouble maxCycleMeanYoungTarjanOrlin(MCMgraph &mcmGraph) {
     return maxCycleMeanAndCriticalCycleYoungTarjanOrlin(mcmGraph, nullptr);
 }
 
+CDouble maxCycleMeanYoungTarjanOrlin(const CompactMCMgraph &g) {
+    return maxCycleMeanAndCriticalCycleYoungTarjanOrlin(g, nullptr);
+}
+
 /**
  * maxCycleRatioAndCriticalCycleYoungTarjanOrlin ()
  * The function computes the maximum cycle ratio of edge weight over delay of
@@ -1133,7 +1051,7 @@ CDouble maxCycleMeanYoungTarjanOrlin(MCMgraph &mcmGraph) {
 
 CDouble maxCycleRatioAndCriticalCycleYoungTarjanOrlin(MCMgraph &mcmGraph,
                                                       std::vector<const MCMedge *> *cycle) {
-    graph ytoGraph;
+    YTOWorkspace ws;
 
     // catch special case when the graph has no edges
     if (mcmGraph.nrVisibleEdges() == 0) {
@@ -1141,34 +1059,30 @@ CDouble maxCycleRatioAndCriticalCycleYoungTarjanOrlin(MCMgraph &mcmGraph,
     }
 
     // Convert the graph to an input graph for the YTO algorithm
-    convertMCMgraphToYTOgraph(mcmGraph, ytoGraph, getDelay, getWeight);
-
-    AlgYTO alg(ytoGraph);
-
-    CDouble min_cr = 0;
-    if (cycle != nullptr) {
-
-        std::vector<const arc *> ytoCycle;
+    convertMCMgraphToYTOgraph(mcmGraph, ws.gr, getDelay, getWeight);
 
-        // Find maximum cycle ratio
-        std::int32_t ytoCycLen = 0;
-        alg.mmcycle_robust(ytoGraph, &min_cr, &ytoCycle);
-
-        *cycle = std::vector<const MCMedge *>(ytoCycle.size());
+    return maxCycleRatioOfYTOgraph(ws, cycle);
+}
 
-        // note that mmcycle returns the critical cycle following edges backwards
-        // therefore reverse the order of the edges.
-        size_t len = ytoCycle.size();
-        for (uint i = 0; i < len; i++) {
-            cycle->at(i) = ytoCycle[len - 1 - i]->mcmEdge;
+CDouble maxCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle,
+                                                      YTOWorkspace &ws) {
+    // catch special case when the graph has no edges
+    if (g.nrEdges() == 0) {
+        if (cycle != nullptr) {
+            cycle->clear();
         }
-
-    } else {
-        // Find maximum cycle ratio without cycle
-        alg.mmcycle_robust(ytoGraph, &min_cr, nullptr);
+        return 0.0;
     }
 
-    return 1.0 / min_cr;
+    convertMCMgraphToYTOgraph(g, ws.gr, &g.delays(), &g.weights());
+    return maxCycleRatioOfYTOgraph(ws, cycle);
+}
+
+CDouble maxCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle) {
+    YTOWorkspace ws;
+    return maxCycleRatioAndCriticalCycleYoungTarjanOrlin(g, cycle, ws);
 }
 
 /**
@@ -1181,6 +1095,10 @@ CDouble maxCycleRatioYoungTarjanOrlin(MCMgraph &mcmGraph) {
     return maxCycleRatioAndCriticalCycleYoungTarjanOrlin(mcmGraph, nullptr);
 }
 
+CDouble maxCycleRatioYoungTarjanOrlin(const CompactMCMgraph &g) {
+    return maxCycleRatioAndCriticalCycleYoungTarjanOrlin(g, nullptr);
+}
+
 /**
  * minCycleRatioAndCriticalCycleYoungTarjanOrlin ()
  * The function computes the minimum cycle ratio of edge weight over delay of
@@ -1192,35 +1110,25 @@ CDouble maxCycleRatioYoungTarjanOrlin(MCMgraph &mcmGraph) {
 
 CDouble minCycleRatioAndCriticalCycleYoungTarjanOrlin(MCMgraph &mcmGraph,
                                                       std::vector<const MCMedge *> *cycle) {
-    graph ytoGraph;
+    YTOWorkspace ws;
 
     // Convert the graph to an input graph for the YTO algorithm
-    convertMCMgraphToYTOgraph(mcmGraph, ytoGraph, getWeight, getDelay);
-
-    AlgYTO alg(ytoGraph);
-
-    CDouble min_cr = 0;
-    if (cycle != nullptr) {
-
-        std::vector<const arc *> ytoCycle;
-
-        // Find minimum cycle ratio
-        std::int32_t ytoCycLen = 0;
-        alg.mmcycle_robust(ytoGraph, &min_cr, &ytoCycle);
+    convertMCMgraphToYTOgraph(mcmGraph, ws.gr, getWeight, getDelay);
 
-        size_t len = ytoCycle.size();
-        *cycle = std::vector<const MCMedge *>(len);
-
-        for (uint i = 0; i < len; i++) {
-            cycle->at(i) = ytoCycle[i]->mcmEdge;
-        }
+    return minCycleRatioOfYTOgraph(ws, cycle);
+}
 
-    } else {
-        // Find minimum cycle ratio without cycle
-        alg.mmcycle_robust(ytoGraph, &min_cr, nullptr);
-    }
+CDouble minCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle,
+                                                      YTOWorkspace &ws) {
+    convertMCMgraphToYTOgraph(g, ws.gr, &g.weights(), &g.delays());
+    return minCycleRatioOfYTOgraph(ws, cycle);
+}
 
-    return min_cr;
+CDouble minCycleRatioAndCriticalCycleYoungTarjanOrlin(const CompactMCMgraph &g,
+                                                      std::vector<const MCMedge *> *cycle) {
+    YTOWorkspace ws;
+    return minCycleRatioAndCriticalCycleYoungTarjanOrlin(g, cycle, ws);
 }
 
 /**
@@ -1233,4 +1141,8 @@ CDouble minCycleRatioYoungTarjanOrlin(MCMgraph &mcmGraph) {
     return minCycleRatioAndCriticalCycleYoungTarjanOrlin(mcmGraph, nullptr);
 }
 
+CDouble minCycleRatioYoungTarjanOrlin(const CompactMCMgraph &g) {
+    return minCycleRatioAndCriticalCycleYoungTarjanOrlin(g, nullptr);
+}
+
 } // namespace Graphs
@@ -0,0 +1,159 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *  Dept. of Electrical Engineering
+ *  Electronics Systems Group
+ *  Model Based Design Lab (https://computationalmodeling.info/)
+ *
+ *  Name            :   parallel.cc
+ *
+ *  Date            :   October 19, 2026
+ *
+ *  Function        :   Simple thread parallelism for the analysis algorithms
+ *
+ *  History         :
+ *      19-10-26    :   Initial version.
+ *
+ *  Copyright 2026 Eindhoven University of Technology
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the “Software”),
+ *  to deal in the Software without restriction, including without limitation
+ *  the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *  and/or sell copies of the Software, and to permit persons to whom the
+ *  Software is furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included
+ *  in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "base/parallel/parallel.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MaxPlus {
+
+unsigned int defaultThreadCount() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+void parallelFor(std::size_t begin,
+                 std::size_t end,
+                 const std::function<void(std::size_t)> &body,
+                 unsigned int nrThreads) {
+    if (begin >= end) {
+        return;
+    }
+    if (nrThreads == 0) {
+        nrThreads = defaultThreadCount();
+    }
+    std::size_t nrTasks = end - begin;
+    if (nrThreads > nrTasks) {
+        nrThreads = static_cast<unsigned int>(nrTasks);
+    }
+    if (nrThreads <= 1) {
+        for (std::size_t i = begin; i < end; i++) {
+            body(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next(begin);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        while (!failed.load(std::memory_order_relaxed)) {
+            std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= end) {
+                return;
+            }
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nrThreads - 1);
+    for (unsigned int t = 1; t < nrThreads; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &t : threads) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void parallelRun(const std::function<void(unsigned int, unsigned int)> &body,
+                 unsigned int nrThreads) {
+    if (nrThreads == 0) {
+        nrThreads = defaultThreadCount();
+    }
+    if (nrThreads == 1) {
+        body(0, 1);
+        return;
+    }
+
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&](unsigned int t) {
+        try {
+            body(t, nrThreads);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nrThreads - 1);
+    for (unsigned int t = 1; t < nrThreads; t++) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto &t : threads) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void Barrier::arriveAndWait() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    unsigned int arrivedIn = this->generation;
+    if (++this->waiting == this->count) {
+        this->waiting = 0;
+        this->generation++;
+        this->allArrived.notify_all();
+        return;
+    }
+    this->allArrived.wait(lock, [this, arrivedIn] { return this->generation != arrivedIn; });
+}
+
+} // namespace MaxPlus
@@ -1,5 +1,6 @@
 #include "graph/mpautomaton.h"
 #include "base/analysis/mcm/mcm.h"
+#include "base/analysis/mcm/mcmhoward.h"
 #include "base/analysis/mcm/mcmyto.h"
 #include "base/basic_types.h"
 #include <memory>
@@ -21,6 +22,7 @@ CDouble MaxPlusAutomatonWithRewards::calculateMCR() {
     }
 
     CId eId = 0;
+    bool negativeReward = false;
     for (const auto &s : this->getStates()) {
         for (const auto *e : (s.second)->getOutgoingEdges()) {
             const auto *mpae = dynamic_cast<MPAREdgeRef>(e);
@@ -29,13 +31,16 @@ CDouble MaxPlusAutomatonWithRewards::calculateMCR() {
                       *nodeMap[(mpae->getDestination())],
                       static_cast<CDouble>(mpae->getLabel().delay),
                       mpae->getLabel().reward);
+            negativeReward = negativeReward || mpae->getLabel().reward < 0.0;
         }
     }
 
-    std::vector<const MCMedge *> cycle;
-    CDouble mcr = maxCycleRatioAndCriticalCycleYoungTarjanOrlin(g, &cycle);
-
-    return mcr;
+    // the rewards are the delays of the MCM graph, which Howard's algorithm requires
+    // to be non-negative
+    if (negativeReward) {
+        return maxCycleRatioYoungTarjanOrlin(g);
+    }
+    return maximumCycleRatioHoward(g);
 }
 
 CDouble MaxPlusAutomatonWithRewards::calculateMCRAndCycle(
@@ -52,21 +57,25 @@ CDouble MaxPlusAutomatonWithRewards::calculateMCRAndCycle(
     }
 
     CId eId = 0;
+    bool negativeReward = false;
     std::map<const MCMedge *, MPAREdgeRef> edgeMap;
 
     for (const auto &s : this->getStates()) {
         for (const auto *e : (s.second)->getOutgoingEdges()) {
             const auto *mpae = dynamic_cast<MPAREdgeRef>(e);
-            g.addEdge(eId++,
-                      *nodeMap[mpae->getSource()],
-                      *nodeMap[mpae->getDestination()],
-                      static_cast<CDouble>(mpae->getLabel().delay),
-                      mpae->getLabel().reward);
+            const MCMedge *me = g.addEdge(eId++,
+                                          *nodeMap[mpae->getSource()],
+                                          *nodeMap[mpae->getDestination()],
+                                          static_cast<CDouble>(mpae->getLabel().delay),
+                                          mpae->getLabel().reward);
+            edgeMap[me] = mpae;
+            negativeReward = negativeReward || mpae->getLabel().reward < 0.0;
         }
     }
 
     std::vector<const MCMedge *> mcmCycle;
-    CDouble mcr = maxCycleRatioAndCriticalCycleYoungTarjanOrlin(g, &mcmCycle);
+    CDouble mcr = negativeReward ? maxCycleRatioAndCriticalCycleYoungTarjanOrlin(g, &mcmCycle)
+                                 : maximumCycleRatioHoward(g, &mcmCycle);
     if (cycle != nullptr) {
         *cycle = std::make_shared<std::vector<MPAREdgeRef>>();
         for (const auto *e : mcmCycle) {
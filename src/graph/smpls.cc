@@ -320,6 +320,7 @@ std::shared_ptr<MaxPlusAutomaton> SMPLSwithEvents::convertToMaxPlusAutomaton() {
         const auto *s = dynamic_cast<IOAStateRef>(i);
         this->elsFSM.addFinalState(*this->elsFSM.getStateLabeled(s->getLabel()));
     }
+    this->shareModeMatrices();
     return SMPLS::convertToMaxPlusAutomaton();
 }
 
@@ -337,8 +338,24 @@ void SMPLSwithEvents::makeMatricesSquare() {
 
 // transposes all matrices of the SMPLS
 void SMPLS::transposeMatrices() {
+    std::map<const Matrix *, std::shared_ptr<Matrix>> transposed;
     for (auto &it : this->mm) {
-        it.second = it.second->getTransposedCopy();
+        auto &t = transposed[it.second.get()];
+        if (!t) {
+            t = it.second->getTransposedCopy();
+        }
+        it.second = t;
+    }
+    if (this->registry.size() > 0) {
+        // the registered matrices are no longer the ones in use
+        this->registry.clear();
+        this->shareModeMatrices();
+    }
+}
+
+void SMPLS::shareModeMatrices() {
+    for (auto &it : this->mm) {
+        it.second = this->registry.intern(it.second);
     }
 }
 /*
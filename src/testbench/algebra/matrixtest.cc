@@ -1,6 +1,11 @@
 #include <algorithm>
+#include <sstream>
 
+#include "algebra/mpbatch.h"
 #include "algebra/mpmatrix.h"
+#include "algebra/mpmatrixio.h"
+#include "algebra/mpregistry.h"
+#include "base/exception/exception.h"
 #include "matrixtest.h"
 #include "testing.h"
 
@@ -12,6 +17,10 @@ void MatrixTest::Run() {
     this->test_SubMatrix();
     this->test_Equality();
     this->test_Addition();
+    this->test_TextReadWrite();
+    this->test_Residuation();
+    this->test_BatchEigenvalues();
+    this->test_Registry();
 };
 
 int MatrixTest::test_SetMPTimeInMatrix() {
@@ -79,10 +88,21 @@ int MatrixTest::test_SubMatrix() {
 }
 
 int MatrixTest::test_Equality() {
-    // Equality is not implemented!
-    // Matrix m1(3, 3, MatrixFill::MinusInfinity);
-    // Matrix m2(3, 3, MatrixFill::MinusInfinity);
-    // ASSERT_THROW(m1==m2);
+    std::cout << "Running test: Equality" << std::endl;
+
+    Matrix m1(3, 3, MatrixFill::MinusInfinity);
+    Matrix m2(3, 3, MatrixFill::MinusInfinity);
+    ASSERT_THROW(m1 == m2);
+    ASSERT_THROW(m1.hash() == m2.hash());
+
+    m2.put(1, 2, MPTime(0.0));
+    ASSERT_THROW(m1 != m2);
+    ASSERT_THROW(m1.hash() != m2.hash());
+
+    Matrix m3(3, 2, MatrixFill::Zero);
+    Matrix m4(2, 3, MatrixFill::Zero);
+    ASSERT_THROW(m3 != m4);
+    ASSERT_THROW(m3.hash() != m4.hash());
 
     return 0;
 }
@@ -114,3 +134,183 @@ int MatrixTest::test_Addition() {
 
     return 0;
 }
+
+int MatrixTest::test_TextReadWrite() {
+    std::cout << "Running test: TextReadWrite" << std::endl;
+
+    Matrix m(3, 4, MatrixFill::MinusInfinity);
+    m.put(0, 0, MPTime(0.1));
+    m.put(0, 3, MPTime(1.0 / 3.0));
+    m.put(1, 1, MPTime(-2.5e-7));
+    m.put(2, 2, MPTime(123456789.123456789));
+    m.put(2, 3, MPTime(-0.0));
+
+    for (auto format : {MatrixTextFormat::Plain, MatrixTextFormat::Matlab, MatrixTextFormat::CSV}) {
+        std::stringstream ss;
+        writeMatrix(ss, m, format);
+        Matrix r = readMatrix(ss);
+        ASSERT_EQUAL(m.getRows(), r.getRows());
+        ASSERT_EQUAL(m.getCols(), r.getCols());
+        for (unsigned int row = 0; row < m.getRows(); row++) {
+            for (unsigned int col = 0; col < m.getCols(); col++) {
+                ASSERT_EQUAL(static_cast<CDouble>(m.get(row, col)),
+                             static_cast<CDouble>(r.get(row, col)));
+            }
+        }
+    }
+
+    std::stringstream plain;
+    writeMatrix(plain, m, MatrixTextFormat::Plain);
+    ASSERT_THROW(plain.str().find("-mp_inf") != std::string::npos);
+
+    std::stringstream matlab("[ 1 -Inf ;\n -inf 2.5 ]\n");
+    Matrix r = readMatrix(matlab);
+    ASSERT_EQUAL(2, r.getRows());
+    ASSERT_EQUAL(2.5, static_cast<CDouble>(r.get(1, 1)));
+    ASSERT_EQUAL(static_cast<CDouble>(MP_MINUS_INFINITY), static_cast<CDouble>(r.get(0, 1)));
+
+    bool thrown = false;
+    try {
+        std::stringstream ragged("1 2\n3\n");
+        readMatrix(ragged);
+    } catch (MPException &) {
+        thrown = true;
+    }
+    ASSERT_THROW(thrown);
+
+    return 0;
+}
+
+int MatrixTest::test_Residuation() {
+    std::cout << "Running test: Residuation" << std::endl;
+
+    // 3x11 matrix, wide enough for the vectorized kernels to be used
+    const unsigned int NC = 11;
+    Matrix A(3, NC, MatrixFill::MinusInfinity);
+    for (unsigned int j = 0; j < NC - 1; j++) {
+        A.put(j % 3, j, MPTime(static_cast<CDouble>(j)));
+        A.put((j + 1) % 3, j, MPTime(1.0));
+    }
+    Vector b(3);
+    b.put(0, MPTime(20.0));
+    b.put(1, MPTime(12.0));
+    b.put(2, MPTime(15.0));
+
+    Vector x = A.residuate(b);
+    for (unsigned int j = 0; j < NC - 1; j++) {
+        CDouble expected = std::min(static_cast<CDouble>(b.get(j % 3)) - j,
+                                    static_cast<CDouble>(b.get((j + 1) % 3)) - 1.0);
+        ASSERT_EQUAL(expected, static_cast<CDouble>(x.get(j)));
+    }
+    // unconstrained column
+    ASSERT_EQUAL(static_cast<CDouble>(MP_PLUS_INFINITY), static_cast<CDouble>(x.get(NC - 1)));
+
+    // x is a subsolution
+    Vector y = A.mp_multiply(x);
+    for (unsigned int i = 0; i < 3; i++) {
+        ASSERT_THROW(y.get(i) <= b.get(i));
+    }
+
+    // b = A x for some x is solvable, a perturbed b is not
+    Vector x0(NC, MPTime(0.0));
+    Vector b0 = A.mp_multiply(x0);
+    ASSERT_THROW(A.isSolvable(b0));
+    b0.put(1, MPTime(static_cast<CDouble>(b0.get(1)) - 100.0));
+    ASSERT_THROW(!A.isSolvable(b0));
+
+    // a minus infinity in b forces the columns it constrains to minus infinity
+    b.put(1, MP_MINUS_INFINITY);
+    Vector xInf = A.residuate(b);
+    ASSERT_MP_MINUS_INFINITY(static_cast<CDouble>(xInf.get(0)));
+    ASSERT_EQUAL(13.0, static_cast<CDouble>(xInf.get(2)));
+
+    // matrix residuation agrees column-wise with vector residuation
+    Matrix B(3, 2, MatrixFill::Zero);
+    B.put(0, 1, MPTime(7.0));
+    Matrix X = A.residuate(B);
+    for (unsigned int c = 0; c < 2; c++) {
+        Vector bc(3);
+        for (unsigned int i = 0; i < 3; i++) {
+            bc.put(i, B.get(i, c));
+        }
+        Vector xc = A.residuate(bc);
+        for (unsigned int j = 0; j < NC; j++) {
+            ASSERT_EQUAL(static_cast<CDouble>(xc.get(j)), static_cast<CDouble>(X.get(j, c)));
+        }
+    }
+
+    return 0;
+}
+
+int MatrixTest::test_BatchEigenvalues() {
+    std::cout << "Running test: BatchEigenvalues" << std::endl;
+
+    // enough matrices for several chunks, and a count that is not a multiple of the chunk size
+    const unsigned int K = 523;
+    const unsigned int N = 5;
+    MatrixBatch batch(K, N);
+    unsigned int seed = 12345;
+    for (unsigned int m = 0; m < K; m++) {
+        for (unsigned int i = 0; i < N; i++) {
+            for (unsigned int j = 0; j < N; j++) {
+                seed = seed * 1103515245 + 12345;
+                unsigned int r = (seed >> 16) % 100;
+                // the last matrix has no finite entries at all
+                if (r < 40 || m == K - 1) {
+                    continue;
+                }
+                batch.put(m, i, j, MPTime(static_cast<CDouble>(r) / 7.0 - 5.0));
+            }
+        }
+    }
+
+    std::vector<CDouble> sequential = batch.mpEigenvalues(1);
+    std::vector<CDouble> parallel = batch.mpEigenvalues(4);
+    ASSERT_EQUAL(K, sequential.size());
+    for (unsigned int m = 0; m < K; m++) {
+        CDouble expected = batch.getMatrix(m).mp_eigenvalue();
+        ASSERT_EQUAL(expected, sequential[m]);
+        ASSERT_EQUAL(expected, parallel[m]);
+    }
+    ASSERT_MP_MINUS_INFINITY(sequential[K - 1]);
+
+    // packed row-major input
+    std::vector<CDouble> packed = {1.0, 2.0, 3.0, -1.0e30, 0.0, 4.0, 0.0, 0.0};
+    MatrixBatch fromPacked(2, 2, packed.data());
+    std::vector<CDouble> lambda = fromPacked.mpEigenvalues();
+    ASSERT_APPROX_EQUAL(lambda[0], 2.5, 1.0e-9);
+    ASSERT_APPROX_EQUAL(lambda[1], 2.0, 1.0e-9);
+
+    return 0;
+}
+
+int MatrixTest::test_Registry() {
+    std::cout << "Running test: Registry" << std::endl;
+
+    MatrixRegistry registry;
+    auto a = std::make_shared<Matrix>(2, 2, MatrixFill::Identity);
+    a->put(0, 1, MPTime(3.0));
+    auto b = std::make_shared<Matrix>(*a);
+    auto c = std::make_shared<Matrix>(2, 2, MatrixFill::Zero);
+
+    auto ia = registry.intern(a);
+    auto ib = registry.intern(b);
+    auto ic = registry.intern(c);
+    ASSERT_THROW(ia == a);
+    ASSERT_THROW(ib == a);
+    ASSERT_THROW(ic == c);
+    ASSERT_EQUAL(2, registry.size());
+
+    // a copy finds the same entry, and memoized results match a direct computation
+    Matrix copy(*c);
+    ASSERT_THROW(registry.intern(copy) == c);
+    ASSERT_EQUAL(c->mp_eigenvalue(), registry.eigenvalue(copy));
+    const Matrix &closure = registry.starClosure(*a);
+    ASSERT_THROW(&closure == &registry.starClosure(*b));
+    ASSERT_THROW(closure == a->starClosureMatrix());
+    const auto &gev = registry.generalizedEigenvectors(*b);
+    ASSERT_THROW(&gev == &registry.generalizedEigenvectors(*a));
+    ASSERT_EQUAL(2, registry.size());
+
+    return 0;
+}
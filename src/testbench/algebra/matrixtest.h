@@ -19,5 +19,9 @@ public:
     int test_SubMatrix();
     int test_Equality();
     int test_Addition();
+    int test_TextReadWrite();
+    int test_Residuation();
+    int test_BatchEigenvalues();
+    int test_Registry();
     virtual void Run();
 };
@@ -14,6 +14,7 @@ void SparseMatrixTest::Run() {
     this->test_GetPutMatrix();
     this->test_Addition();
     this->test_Multiplication();
+    this->test_Residuation();
 };
 
 int SparseMatrixTest::test_Vectors() {
@@ -149,3 +150,27 @@ int SparseMatrixTest::test_Multiplication() {
 
     return 0;
 }
+
+int SparseMatrixTest::test_Residuation() {
+    std::cout << "Running test: SparseResiduation" << std::endl;
+
+    SparseMatrix M(100, 100);
+    M.putAll(0, 50, 0, 50, MPTime(1.0));
+    M.putAll(50, 100, 50, 100, MPTime(2.0));
+    M.put(10, 60, MPTime(4.0));
+
+    SparseVector b(100, MPTime(10.0));
+    b.put(20, MPTime(5.0));
+
+    SparseVector x = M.residuate(b);
+    ASSERT_APPROX_EQUAL(static_cast<CDouble>(x.get(0)), 4.0, ASSERT_EPSILON);
+    ASSERT_APPROX_EQUAL(static_cast<CDouble>(x.get(55)), 8.0, ASSERT_EPSILON);
+    ASSERT_APPROX_EQUAL(static_cast<CDouble>(x.get(60)), 6.0, ASSERT_EPSILON);
+
+    SparseVector y = M.multiply(x);
+    for (unsigned int i = 0; i < 100; i++) {
+        ASSERT_THROW(y.get(i) <= b.get(i));
+    }
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 
 #include "algebra/mpmatrix.h"
 #include "testing.h"
@@ -6,7 +7,11 @@
 
 using namespace MaxPlus;
 
-void VectorTest::Run() { this->test_Infinity(); };
+void VectorTest::Run() {
+    this->test_Infinity();
+    this->test_ElementWise();
+    this->test_NormalizeAndHash();
+};
 
 // Test vector operations.
 void VectorTest::test_Infinity() {
@@ -19,4 +24,93 @@ void VectorTest::test_Infinity() {
     ASSERT_EQUAL(4.0, static_cast<CDouble>(vec.get(0)));
     ASSERT_EQUAL(5.0, static_cast<CDouble>(vec.get(1)));
     ASSERT_EQUAL(6.0, static_cast<CDouble>(vec.get(2)));
-}
\ No newline at end of file
+}
+// Compare the element-wise operations against MPTime arithmetic, for all sizes around the
+// vector widths so that the remainder loops are covered as well.
+void VectorTest::test_ElementWise() {
+    std::cout << "Running test: ElementWise" << std::endl;
+
+    for (unsigned int n = 1; n < 20; n++) {
+        Vector a(n);
+        Vector b(n);
+        for (unsigned int k = 0; k < n; k++) {
+            a.put(k, k % 3 == 1 ? MP_MINUS_INFINITY : MPTime(0.5 * k - 3.0));
+            b.put(k, k % 5 == 2 ? MP_MINUS_INFINITY : MPTime(4.0 - 0.25 * k));
+        }
+
+        MPTime expectedNorm = MP_MINUS_INFINITY;
+        unsigned int expectedPos = n + 1;
+        MPTime expectedMin = MP_MINUS_INFINITY;
+        for (unsigned int k = 0; k < n; k++) {
+            expectedNorm = MP_MAX(expectedNorm, a.get(k));
+            if (!a.get(k).isMinusInfinity()
+                && (expectedPos == n + 1 || a.get(k) < expectedMin)) {
+                expectedMin = a.get(k);
+                expectedPos = k;
+            }
+        }
+        ASSERT_EQUAL(static_cast<CDouble>(expectedNorm), static_cast<CDouble>(a.norm()));
+        unsigned int pos = 0;
+        ASSERT_EQUAL(static_cast<CDouble>(expectedMin),
+                     static_cast<CDouble>(a.minimalFiniteElement(&pos)));
+        ASSERT_EQUAL(expectedPos, pos);
+
+        Vector sum = a.add(b);
+        Vector shifted = a.add(MPTime(1.5));
+        Vector max(n);
+        a.maximum(b, max);
+        for (unsigned int k = 0; k < n; k++) {
+            ASSERT_EQUAL(static_cast<CDouble>(a.get(k) + b.get(k)),
+                         static_cast<CDouble>(sum.get(k)));
+            ASSERT_EQUAL(static_cast<CDouble>(a.get(k) + MPTime(1.5)),
+                         static_cast<CDouble>(shifted.get(k)));
+            ASSERT_EQUAL(static_cast<CDouble>(MP_MAX(a.get(k), b.get(k))),
+                         static_cast<CDouble>(max.get(k)));
+        }
+
+        Vector c(n, MPTime(2.0));
+        Vector d(n, MPTime(2.0));
+        ASSERT_THROW(c.compare(d));
+        d.put(n - 1, MPTime(2.1));
+        ASSERT_THROW(!c.compare(d));
+        c.negate();
+        ASSERT_EQUAL(-2.0, static_cast<CDouble>(c.get(n - 1)));
+        ASSERT_THROW(!a.compare(a) || n == 1);
+
+        // the sign of a zero maximum does not depend on the kernel implementation
+        Vector z(n);
+        for (unsigned int k = 0; k < n; k++) {
+            z.put(k, MPTime(k % 2 == 0 ? -0.0 : 0.0));
+        }
+        ASSERT_THROW(!std::signbit(static_cast<CDouble>(z.norm())));
+    }
+}
+
+void VectorTest::test_NormalizeAndHash() {
+    std::cout << "Running test: NormalizeAndHash" << std::endl;
+
+    Vector a(37);
+    Vector b(37);
+    for (unsigned int k = 0; k < 37; k++) {
+        MPTime v = k % 4 == 3 ? MP_MINUS_INFINITY : MPTime(static_cast<CDouble>(k % 7));
+        a.put(k, v);
+        b.put(k, v + MPTime(10.0));
+    }
+    Vector c(a);
+
+    std::uint64_t hashA = 0;
+    std::uint64_t hashB = 0;
+    ASSERT_EQUAL(6.0, static_cast<CDouble>(a.normalizeAndHash(hashA)));
+    ASSERT_EQUAL(16.0, static_cast<CDouble>(b.normalizeAndHash(hashB)));
+    ASSERT_THROW(hashA == hashB);
+
+    c.normalize();
+    for (unsigned int k = 0; k < 37; k++) {
+        ASSERT_EQUAL(static_cast<CDouble>(c.get(k)), static_cast<CDouble>(a.get(k)));
+        ASSERT_EQUAL(static_cast<CDouble>(c.get(k)), static_cast<CDouble>(b.get(k)));
+    }
+
+    b.put(5, MPTime(-2.5));
+    b.normalizeAndHash(hashB);
+    ASSERT_THROW(hashA != hashB);
+}
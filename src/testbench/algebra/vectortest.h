@@ -13,4 +13,6 @@ public:
     virtual void SetUp(){};
     virtual void TearDown(){};
     void test_Infinity();
+    void test_ElementWise();
+    void test_NormalizeAndHash();
 };
@@ -2,14 +2,26 @@
 
 #include "algebra/mptype.h"
 #include "base/analysis/mcm/mcm.h"
+#include "base/analysis/mcm/mcmanytime.h"
+#include "base/analysis/mcm/mcmapprox.h"
+#include "base/analysis/mcm/mcmbatch.h"
+#include "base/analysis/mcm/mcmcompact.h"
+#include "base/analysis/mcm/mcmcritical.h"
 #include "base/analysis/mcm/mcmdg.h"
+#include "base/analysis/mcm/mcmexact.h"
+#include "base/analysis/mcm/mcmincremental.h"
+#include "base/analysis/mcm/mcmio.h"
+#include "base/analysis/mcm/mcmpaths.h"
 #include "base/analysis/mcm/mcmgraph.h"
+#include "base/exception/exception.h"
 #include "mcmtest.h"
 #include "testing.h"
 #include <array>
 #include <base/analysis/mcm/mcmhoward.h>
 #include <base/analysis/mcm/mcmyto.h>
+#include <cstdio>
 #include <random>
+#include <sstream>
 #include <type_traits>
 
 using namespace MaxPlus;
@@ -18,9 +30,24 @@ using namespace Graphs;
 void MCMTest::Run() {
     this->test_dg();
     this->test_howard();
+    this->test_howardRatio();
     this->test_karp();
     this->test_yto();
     this->test_prune();
+    this->test_compact();
+    this->test_lookup();
+    this->test_components();
+    this->test_facade();
+    this->test_batch();
+    this->test_exact();
+    this->test_longestDelayEdges();
+    this->test_critical();
+    this->test_incremental();
+    this->test_io();
+    this->test_longestPaths();
+    this->test_decomposition();
+    this->test_anytime();
+    this->test_approximate();
 };
 
 MCMgraph makeGraph1() {
@@ -52,11 +79,18 @@ MCMgraph makeGraph2() {
     return g;
 }
 
-MCMgraph
-makeRandomGraph(unsigned int numberOfNodes, unsigned int numberOfEdges, unsigned int seed) {
+// A random graph with between numberOfNodes / 2 and numberOfNodes nodes, in
+// which every node has an outgoing edge, with weights in [0, 100) and delays
+// in [minDelay, maxDelay).
+MCMgraph makeRandomGraph(unsigned int numberOfNodes,
+                         unsigned int numberOfEdges,
+                         unsigned int seed,
+                         CDouble minDelay = 0.0,
+                         CDouble maxDelay = 100.0) {
     MCMgraph g;
 
     std::mt19937 rng(seed);
+    const CDouble delayScale = (maxDelay - minDelay) / 100.0;
     unsigned int actualNumberOfNodes = (numberOfNodes / 2) + (rng() % (numberOfNodes / 2));
 
     std::vector<MCMnode *> nodes;
@@ -82,7 +116,7 @@ makeRandomGraph(unsigned int numberOfNodes, unsigned int numberOfEdges, unsigned
         } while (existingEdges.find(std::make_pair(src, dst)) != existingEdges.end());
         existingEdges.insert(std::make_pair(src, dst));
         CDouble w = static_cast<CDouble>(rng() % 100000) / 1000.0;
-        CDouble d = static_cast<CDouble>(rng() % 100000) / 1000.0;
+        CDouble d = minDelay + static_cast<CDouble>(rng() % 100000) / 1000.0 * delayScale;
         g.addEdge(i, *(nodes[src]), *(nodes[dst]), w, d);
     }
 
@@ -91,7 +125,7 @@ makeRandomGraph(unsigned int numberOfNodes, unsigned int numberOfEdges, unsigned
         if (n->out.size() == 0) {
             CId dst = rng() % actualNumberOfNodes;
             CDouble w = static_cast<CDouble>(rng() % 100000) / 1000.0;
-            CDouble d = static_cast<CDouble>(rng() % 100000) / 1000.0;
+            CDouble d = minDelay + static_cast<CDouble>(rng() % 100000) / 1000.0 * delayScale;
             g.addEdge(i++, *n, *(nodes[dst]), w, d);
         }
     }
@@ -157,6 +191,35 @@ void MCMTest::test_howard() {
     MCMgraph g2 = makeGraph2();
     result = maximumCycleMeanHowardGeneral(g2, &criticalNode);
     ASSERT_EQUAL(-INFINITY, result);
+
+    // the critical node is a node with the maximum cycle mean
+    MCMgraph g3 = makeGraph1();
+    g3.getNode(4)->out.front()->w = 3.0;
+    result = maximumCycleMeanHoward(g3, &criticalNode);
+    ASSERT_APPROX_EQUAL(3.0, result, 1e-5);
+    ASSERT_EQUAL(4, criticalNode->id);
+
+    // warm-started runs
+    for (unsigned int k = 0; k < 10; k++) {
+        MCMgraph gr = makeRandomGraph(50, 200, k);
+        HowardState state;
+        CDouble cold = maximumCycleMeanHoward(gr, state);
+        result = maximumCycleMeanHoward(gr, state);
+        ASSERT_EQUAL(cold, result);
+        ASSERT_EQUAL(1, state.nrIterations);
+
+        // change a few weights
+        unsigned int i = 0;
+        for (auto &e : gr.getEdges()) {
+            if (i++ % 17 == 0) {
+                e.w += 5.0;
+            }
+        }
+        HowardState fresh;
+        cold = maximumCycleMeanHoward(gr, fresh);
+        result = maximumCycleMeanHoward(gr, state);
+        ASSERT_APPROX_EQUAL(cold, result, 1e-9);
+    }
 }
 
 /// Test MCM Karp.
@@ -178,6 +241,44 @@ void MCMTest::test_karp() {
 
     result = maximumCycleMeanKarpDoubleGeneral(g2);
     ASSERT_EQUAL(-INFINITY, result);
+
+    // the layer-parallel version gives bit-identical results
+    for (unsigned int k = 0; k < 3; k++) {
+        MCMgraph gr = makeRandomGraph(400, 20000, k);
+        CompactMCMgraph c(gr);
+        const MCMnode *serialNode = nullptr;
+        const MCMnode *parallelNode = nullptr;
+        CDouble serial = maximumCycleMeanKarpDouble(c, &serialNode);
+        CDouble parallel = maximumCycleMeanKarpDoubleParallel(c, &parallelNode, 4);
+        ASSERT_EQUAL(serial, parallel);
+        ASSERT_THROW(serialNode == parallelNode);
+        ASSERT_APPROX_EQUAL(maxCycleMeanYoungTarjanOrlin(c), parallel, 1e-2);
+
+        // the lean version stops early on these graphs
+        unsigned int nrLayers = 0;
+        CDouble lean = maximumCycleMeanKarpLean(c, nullptr, &nrLayers);
+        ASSERT_APPROX_EQUAL(serial, lean, 1e-9);
+        ASSERT_THROW(nrLayers < c.nrNodes());
+    }
+
+    // and is otherwise bit-identical to the full table
+    for (unsigned int k = 0; k < 50; k++) {
+        MCMgraph gr = makeRandomGraph(20, 40, k);
+        CompactMCMgraph c(gr);
+        unsigned int nrLayers = 0;
+        const MCMnode *fullNode = nullptr;
+        const MCMnode *leanNode = nullptr;
+        CDouble full = maximumCycleMeanKarpDouble(c, &fullNode);
+        CDouble lean = maximumCycleMeanKarpLean(c, &leanNode, &nrLayers);
+        if (nrLayers == c.nrNodes()) {
+            ASSERT_EQUAL(full, lean);
+            ASSERT_THROW(fullNode == leanNode);
+        } else {
+            ASSERT_APPROX_EQUAL(full, lean, 1e-9);
+        }
+    }
+    MCMgraph g3 = makeGraph2();
+    ASSERT_EQUAL(-INFINITY, maximumCycleMeanKarpLean(CompactMCMgraph(g3)));
 }
 
 /// Test MCM YTO.
@@ -268,6 +369,29 @@ void MCMTest::test_yto() {
         ASSERT_APPROX_EQUAL(expectedMaxCycleRatios[k], result, 1e-2);
         // std::cout << "MCM: " << result << "cycle length: " << cycle->size() << std::endl;
     }
+
+    // all heaps give the same results, also when the workspace is reused; the
+    // random weights make ties between keys, and so different cycles, unlikely
+    std::array<YTOHeap, 4> heaps = {YTOHeap::BinaryHeap,
+                                    YTOHeap::FourAryHeap,
+                                    YTOHeap::EightAryHeap,
+                                    YTOHeap::PairingHeap};
+    YTOWorkspace ws;
+    std::vector<const MCMedge *> expectedCycle;
+    for (unsigned int k = 0; k < 20; k++) {
+        MCMgraph gr = makeRandomGraph(k % 2 == 0 ? 20 : 200, k % 2 == 0 ? 40 : 2000, k);
+        CompactMCMgraph cr(gr);
+        CDouble expectedMax = maxCycleRatioAndCriticalCycleYoungTarjanOrlin(cr, &expectedCycle);
+        CDouble expectedMin = minCycleRatioYoungTarjanOrlin(cr);
+        for (auto heap : heaps) {
+            ws.heap = heap;
+            result = maxCycleRatioAndCriticalCycleYoungTarjanOrlin(cr, &cycle, ws);
+            ASSERT_EQUAL(expectedMax, result);
+            ASSERT_THROW(cycle == expectedCycle);
+            result = minCycleRatioAndCriticalCycleYoungTarjanOrlin(cr, nullptr, ws);
+            ASSERT_EQUAL(expectedMin, result);
+        }
+    }
 }
 
 void MCMTest::test_prune() {
@@ -363,4 +487,1076 @@ void MCMTest::test_prune() {
     CDouble mcr2 = maxCycleRatioAndCriticalCycleYoungTarjanOrlin(*result, nullptr);
 
     ASSERT_APPROX_EQUAL(mcr1, mcr2, 1e3);
+
+    // the compact graph and in-place pruning keep the same edges
+    const CompactMCMgraph compact = CompactMCMgraph(mcmGraph).pruneEdges();
+    ASSERT_EQUAL(result->nrVisibleEdges(), compact.nrEdges());
+    mcmGraph.pruneEdgesInPlace();
+    ASSERT_EQUAL(result->nrVisibleEdges(), mcmGraph.nrVisibleEdges());
+    ASSERT_APPROX_EQUAL(
+            mcr1, maxCycleRatioAndCriticalCycleYoungTarjanOrlin(mcmGraph, nullptr), 1e3);
+
+    // parallel edges, of equal ones the first is kept
+    const auto makeParallel = []() {
+        MCMgraph g;
+        MCMnode &p0 = *g.addNode(0);
+        MCMnode &p1 = *g.addNode(1);
+        g.addEdge(0, p0, p1, 1.0, 1.0);
+        g.addEdge(1, p0, p1, 2.0, 1.0);
+        g.addEdge(2, p0, p1, 2.0, 2.0);
+        g.addEdge(3, p0, p1, 3.0, 3.0);
+        g.addEdge(4, p0, p1, 2.0, 1.0);
+        g.addEdge(5, p0, p1, 0.0, 0.0);
+        g.addEdge(6, p1, p0, 1.0, 1.0);
+        return g;
+    };
+    const std::vector<CId> expected = {1, 3, 5, 6};
+    MCMgraph gp = makeParallel();
+    std::vector<CId> ids;
+    std::shared_ptr<MCMgraph> pruned = gp.pruneEdges();
+    for (const auto &e : pruned->getEdges()) {
+        ids.push_back(e.id);
+    }
+    std::sort(ids.begin(), ids.end());
+    ASSERT_THROW(ids == expected);
+
+    const CompactMCMgraph cp = CompactMCMgraph(gp).pruneEdges();
+    ids.clear();
+    for (unsigned int e = 0; e < cp.nrEdges(); e++) {
+        ids.push_back(cp.edge(e)->id);
+    }
+    ASSERT_THROW(ids == expected);
+
+    gp.pruneEdgesInPlace();
+    ids.clear();
+    for (const auto &e : gp.getEdges()) {
+        ids.push_back(e.id);
+    }
+    ASSERT_THROW(ids == expected);
+    ASSERT_EQUAL(3, gp.getNode(0)->out.size());
+    ASSERT_EQUAL(3, gp.getNode(1)->in.size());
+    ASSERT_THROW(gp.getEdge(4) == nullptr);
+    ASSERT_EQUAL(5, gp.getEdge(5)->id);
+}
+
+/// Test the MCM algorithms on the compact graph representation.
+void MCMTest::test_compact() {
+    std::cout << "Running test: MCM-compact" << std::endl;
+
+    MCMgraph g1 = makeGraph1();
+    CompactMCMgraph c1(g1);
+    ASSERT_EQUAL(5, c1.nrNodes());
+    ASSERT_EQUAL(7, c1.nrEdges());
+    ASSERT_EQUAL(3, c1.outEnd(3) - c1.outBegin(3));
+    ASSERT_EQUAL(2, c1.inEnd(4) - c1.inBegin(4));
+    ASSERT_EQUAL(3, c1.edge(c1.outEdge(c1.outBegin(3)))->id);
+
+    const MCMnode *criticalNode = nullptr;
+    CDouble result = maximumCycleMeanKarpDouble(c1, &criticalNode);
+    ASSERT_APPROX_EQUAL(2.5, result, 1e-5);
+    ASSERT_THROW(criticalNode != nullptr && criticalNode->id <= 3);
+
+    result = maximumCycleMeanHoward(c1, &criticalNode);
+    ASSERT_APPROX_EQUAL(2.5, result, 1e-5);
+    ASSERT_THROW(criticalNode->id <= 3);
+
+    ASSERT_APPROX_EQUAL(2.5, mcmDG(c1), 1e-5);
+    ASSERT_APPROX_EQUAL(2.5, maxCycleMeanYoungTarjanOrlin(c1), 1e-5);
+    ASSERT_APPROX_EQUAL(10.0 / 3.0, maxCycleRatioYoungTarjanOrlin(c1), 1e-5);
+    std::vector<const MCMedge *> cycle;
+    result = minCycleRatioAndCriticalCycleYoungTarjanOrlin(c1, &cycle);
+    ASSERT_APPROX_EQUAL(1.0, result, 1e-5);
+    ASSERT_EQUAL(6, cycle.at(0)->id);
+
+    // hidden nodes and edges are left out, node ids need not be dense
+    MCMgraph g2 = makeGraph1();
+    g2.getNode(4)->visible = false;
+    g2.getEdge(5)->visible = false;
+    g2.getEdge(6)->visible = false;
+    g2.setNodeId(*g2.getNode(0), 10);
+    CompactMCMgraph c2(g2);
+    ASSERT_EQUAL(4, c2.nrNodes());
+    ASSERT_EQUAL(5, c2.nrEdges());
+    ASSERT_APPROX_EQUAL(2.5, mcmDG(c2), 1e-5);
+    ASSERT_APPROX_EQUAL(2.5, maximumCycleMeanKarpDouble(c2), 1e-5);
+    ASSERT_APPROX_EQUAL(10.0 / 3.0, maxCycleRatioYoungTarjanOrlin(c2), 1e-5);
+
+    MCMgraph g3 = makeGraph2();
+    CompactMCMgraph c3(g3);
+    ASSERT_EQUAL(-INFINITY, maximumCycleMeanKarpDouble(c3));
+    ASSERT_EQUAL(-INFINITY, mcmDG(c3));
+
+    // compare against the MCMgraph implementations
+    for (unsigned int k = 0; k < 50; k++) {
+        MCMgraph gr = makeRandomGraph(20, 40, k);
+        CompactMCMgraph cr(gr);
+        CDouble expected = maxCycleMeanYoungTarjanOrlin(gr);
+        ASSERT_APPROX_EQUAL(expected, maxCycleMeanYoungTarjanOrlin(cr), 1e-6);
+        ASSERT_APPROX_EQUAL(expected, maximumCycleMeanKarpDouble(cr), 1e-6);
+        ASSERT_APPROX_EQUAL(expected, maximumCycleMeanHoward(cr, nullptr), 1e-6);
+        ASSERT_APPROX_EQUAL(expected, mcmDG(cr), 1e-6);
+        ASSERT_APPROX_EQUAL(
+                maxCycleRatioYoungTarjanOrlin(gr), maxCycleRatioYoungTarjanOrlin(cr), 1e-6);
+    }
+}
+
+/// Test node and edge lookup and removal in an MCMgraph.
+void MCMTest::test_lookup() {
+    std::cout << "Running test: MCM-lookup" << std::endl;
+
+    MCMgraph g = makeGraph1();
+    ASSERT_EQUAL(3, g.getNode(3)->id);
+    ASSERT_EQUAL(5, g.getEdge(5)->id);
+    ASSERT_EQUAL(4, g.getEdge(3, 3)->id);
+    ASSERT_THROW(g.getNode(7) == nullptr);
+    ASSERT_THROW(g.getEdge(7) == nullptr);
+    ASSERT_THROW(g.getEdge(0, 2) == nullptr);
+
+    g.removeEdge(*g.getEdge(5));
+    ASSERT_THROW(g.getEdge(5) == nullptr);
+    ASSERT_EQUAL(6, g.numberOfEdges());
+    ASSERT_EQUAL(2, g.getNode(3)->out.size());
+
+    g.removeNode(*g.getNode(4));
+    ASSERT_THROW(g.getNode(4) == nullptr);
+    ASSERT_THROW(g.getEdge(6) == nullptr);
+    ASSERT_EQUAL(4, g.numberOfNodes());
+    ASSERT_EQUAL(5, g.numberOfEdges());
+
+    // changed ids are picked up by the lookup
+    g.setNodeId(*g.getNode(0), 10);
+    ASSERT_THROW(g.getNode(0) == nullptr);
+    ASSERT_EQUAL(10, g.getNode(10)->id);
+    ASSERT_EQUAL(0, g.getEdge(10, 1)->id);
+    g.removeNode(*g.getNode(10));
+    ASSERT_THROW(g.getNode(10) == nullptr);
+    ASSERT_EQUAL(3, g.numberOfNodes());
+
+    // relabelling keeps the graph consistent
+    g.getNode(1)->visible = false;
+    relabelMCMgraph(g);
+    ASSERT_EQUAL(2, g.numberOfNodes());
+    ASSERT_THROW(g.getNode(2) == nullptr);
+    ASSERT_EQUAL(1, g.getEdge(0, 1)->dst->id);
+    ASSERT_APPROX_EQUAL(1.0, g.getEdge(1, 1)->w, 1e-9);
+    ASSERT_EQUAL(1, g.getEdge(1)->src->id);
+}
+
+/// Test the parallel evaluation of strongly connected components.
+void MCMTest::test_components() {
+    std::cout << "Running test: MCM-components" << std::endl;
+
+    // a graph of several disjoint random components, linked in a chain
+    MCMgraph g;
+    CId nodeOffset = 0;
+    CId edgeId = 0;
+    MCMnode *previous = nullptr;
+    for (unsigned int k = 0; k < 12; k++) {
+        MCMgraph part = makeRandomGraph(60, 800, 100 + k);
+        for (const auto &n : part.getNodes()) {
+            g.addNode(nodeOffset + n.id);
+        }
+        for (const auto &e : part.getEdges()) {
+            g.addEdge(edgeId++,
+                      *g.getNode(nodeOffset + e.src->id),
+                      *g.getNode(nodeOffset + e.dst->id),
+                      e.w,
+                      e.d);
+        }
+        if (previous != nullptr) {
+            g.addEdge(edgeId++, *previous, *g.getNode(nodeOffset), 1000.0, 1.0);
+        }
+        previous = g.getNode(nodeOffset);
+        nodeOffset += part.numberOfNodes();
+    }
+    CompactMCMgraph c(g);
+    CDouble expected = maxCycleMeanYoungTarjanOrlin(c);
+
+    for (unsigned int nrThreads : {1U, 4U}) {
+        MCMgraph gk(g);
+        const MCMnode *karpNode = nullptr;
+        CDouble karp = maximumCycleMeanKarpDoubleGeneral(gk, &karpNode, nrThreads);
+        ASSERT_APPROX_EQUAL(expected, karp, 1e-6);
+        ASSERT_THROW(karpNode != nullptr);
+
+        MCMgraph gh(g);
+        MCMnode *howardNode = nullptr;
+        CDouble howard = maximumCycleMeanHowardGeneral(gh, &howardNode, nrThreads);
+        ASSERT_APPROX_EQUAL(expected, howard, 1e-6);
+        ASSERT_THROW(howardNode != nullptr);
+    }
+}
+
+/// Test the maximumCycleMean entry point.
+void MCMTest::test_facade() {
+    std::cout << "Running test: MCM-facade" << std::endl;
+
+    const auto cycleMean = [](const std::vector<const MCMedge *> &cycle) {
+        CDouble w = 0.0;
+        for (size_t i = 0; i < cycle.size(); i++) {
+            ASSERT_THROW(cycle[i]->dst == cycle[(i + 1) % cycle.size()]->src);
+            w += cycle[i]->w;
+        }
+        return w / static_cast<CDouble>(cycle.size());
+    };
+
+    MCMgraph g1 = makeGraph1();
+    MCMOptions options;
+    options.criticalCycle = true;
+    MCMResult result = maximumCycleMean(g1, options);
+    ASSERT_APPROX_EQUAL(2.5, result.value, 1e-5);
+    ASSERT_THROW(result.algorithm == MCMAlgorithm::Howard);
+    ASSERT_EQUAL(4, result.cycle.size());
+    ASSERT_APPROX_EQUAL(2.5, cycleMean(result.cycle), 1e-9);
+    ASSERT_EQUAL(5, result.nrNodes);
+    ASSERT_THROW(result.integerWeights);
+
+    result = maximumCycleMean(g1);
+    ASSERT_APPROX_EQUAL(2.5, result.value, 1e-5);
+    ASSERT_THROW(result.algorithm == MCMAlgorithm::Karp);
+    ASSERT_THROW(result.cycle.empty());
+
+    // nodes that cannot reach a cycle are removed before the analysis
+    MCMgraph g2 = makeGraph2();
+    result = maximumCycleMean(g2, options);
+    ASSERT_EQUAL(-INFINITY, result.value);
+    ASSERT_EQUAL(0, result.nrNodes);
+    g2.addEdge(1, *g2.getNode(0), *g2.getNode(0), 1.5, 1.0);
+    result = maximumCycleMean(g2, options);
+    ASSERT_APPROX_EQUAL(1.5, result.value, 1e-9);
+    ASSERT_EQUAL(1, result.nrNodes);
+    ASSERT_THROW(!result.integerWeights);
+
+    // all algorithms agree, also on zero and negative weights
+    for (unsigned int k = 0; k < 30; k++) {
+        MCMgraph gr = makeRandomGraph(30, 60, k);
+        if (k >= 20) {
+            for (auto &e : gr.getEdges()) {
+                e.w = std::floor(e.w) - 50.0;
+            }
+        }
+        result = maximumCycleMean(gr, options);
+        ASSERT_APPROX_EQUAL(result.value, cycleMean(result.cycle), 1e-6);
+        for (MCMAlgorithm algorithm : {MCMAlgorithm::Karp,
+                                       MCMAlgorithm::KarpParallel,
+                                       MCMAlgorithm::KarpLean,
+                                       MCMAlgorithm::YoungTarjanOrlin,
+                                       MCMAlgorithm::DasdanGupta}) {
+            MCMOptions o;
+            o.algorithm = algorithm;
+            o.criticalCycle = true;
+            MCMResult r = maximumCycleMean(gr, o);
+            ASSERT_THROW(r.algorithm == algorithm);
+            ASSERT_APPROX_EQUAL(result.value, r.value, 1e-6);
+            ASSERT_APPROX_EQUAL(result.value, cycleMean(r.cycle), 1e-6);
+        }
+    }
+    for (CDouble a : {-3.0, 0.0, 2.5}) {
+        MCMgraph gr;
+        MCMnode &n0 = *gr.addNode(0);
+        MCMnode &n1 = *gr.addNode(1);
+        MCMnode &n2 = *gr.addNode(2);
+        gr.addEdge(0, n0, n1, a, 1.0);
+        gr.addEdge(1, n1, n0, -1.0, 1.0);
+        gr.addEdge(2, n1, n2, 5.0, 1.0);
+        for (MCMAlgorithm algorithm : {MCMAlgorithm::Automatic,
+                                       MCMAlgorithm::Howard,
+                                       MCMAlgorithm::Karp,
+                                       MCMAlgorithm::KarpParallel,
+                                       MCMAlgorithm::KarpLean,
+                                       MCMAlgorithm::YoungTarjanOrlin,
+                                       MCMAlgorithm::DasdanGupta}) {
+            MCMOptions o;
+            o.algorithm = algorithm;
+            o.criticalCycle = true;
+            MCMResult r = maximumCycleMean(gr, o);
+            ASSERT_APPROX_EQUAL((a - 1.0) / 2.0, r.value, 1e-9);
+            ASSERT_EQUAL(2, r.cycle.size());
+            ASSERT_APPROX_EQUAL((a - 1.0) / 2.0, cycleMean(r.cycle), 1e-9);
+        }
+    }
+
+    // when Howard does not converge, a critical cycle still comes with the fallback
+    MCMgraph slow = makeRandomGraph(30, 60, 3);
+    options.maxHowardIterations = 1;
+    MCMOptions howard = options;
+    howard.algorithm = MCMAlgorithm::Howard;
+    ASSERT_MP_EXCEPTION(maximumCycleMean(slow, howard));
+    result = maximumCycleMean(slow, options);
+    ASSERT_THROW(result.algorithm == MCMAlgorithm::YoungTarjanOrlin);
+    ASSERT_APPROX_EQUAL(maximumCycleMean(slow).value, result.value, 1e-6);
+    ASSERT_APPROX_EQUAL(result.value, cycleMean(result.cycle), 1e-6);
+}
+
+/// Test the evaluation of a batch of weightings of one graph.
+void MCMTest::test_batch() {
+    std::cout << "Running test: MCM-batch" << std::endl;
+
+    std::mt19937 rng(7);
+    for (unsigned int seed = 0; seed < 5; seed++) {
+        MCMgraph g = seed == 0 ? makeGraph1() : makeRandomGraph(30, 60, seed);
+        const CompactMCMgraph c(g);
+        const unsigned int m = c.nrEdges();
+
+        // more weightings than fit in one chunk
+        const size_t K = 300;
+        std::vector<CDouble> weights(K * m);
+        for (CDouble &w : weights) {
+            w = static_cast<CDouble>(rng() % 100000) / 1000.0 - 50.0;
+        }
+        std::vector<std::vector<const MCMedge *>> cycles;
+        std::vector<CDouble> means = maximumCycleMeansBatch(c, weights, &cycles, 3);
+        ASSERT_EQUAL(K, means.size());
+        ASSERT_EQUAL(K, cycles.size());
+
+        for (size_t k = 0; k < K; k++) {
+            unsigned int e = 0;
+            for (auto &edge : g.getEdges()) {
+                edge.w = weights[k * m + e++];
+            }
+            const CompactMCMgraph ck(g);
+            ASSERT_EQUAL(maximumCycleMeanKarpDouble(ck), means[k]);
+            CDouble w = 0.0;
+            for (size_t i = 0; i < cycles[k].size(); i++) {
+                ASSERT_THROW(cycles[k][i]->dst == cycles[k][(i + 1) % cycles[k].size()]->src);
+                w += cycles[k][i]->w;
+            }
+            ASSERT_APPROX_EQUAL(means[k], w / static_cast<CDouble>(cycles[k].size()), 1e-6);
+        }
+    }
+
+    // a graph without cycles
+    MCMgraph g2 = makeGraph2();
+    const CompactMCMgraph c2(g2);
+    std::vector<std::vector<const MCMedge *>> cycles;
+    std::vector<CDouble> means = maximumCycleMeansBatch(c2, {1.0, 2.0}, &cycles);
+    ASSERT_EQUAL(2, means.size());
+    ASSERT_EQUAL(-INFINITY, means[1]);
+    ASSERT_THROW(cycles[1].empty());
+
+    // the number of weights must be a multiple of the number of edges
+    MCMgraph g1 = makeGraph1();
+    ASSERT_MP_EXCEPTION(maximumCycleMeansBatch(CompactMCMgraph(g1), {1.0, 2.0, 3.0, 4.0, 5.0}));
+}
+
+/// Test the maximum and minimum cycle ratio with Howard.
+void MCMTest::test_howardRatio() {
+    std::cout << "Running test: MCM-Howard-ratio" << std::endl;
+
+    const auto cycleRatio = [](const std::vector<const MCMedge *> &cycle) {
+        CDouble w = 0.0;
+        CDouble d = 0.0;
+        for (size_t i = 0; i < cycle.size(); i++) {
+            ASSERT_THROW(cycle[i]->dst == cycle[(i + 1) % cycle.size()]->src);
+            w += cycle[i]->w;
+            d += cycle[i]->d;
+        }
+        return w / d;
+    };
+
+    MCMgraph g1 = makeGraph1();
+    std::vector<const MCMedge *> cycle;
+    ASSERT_APPROX_EQUAL(10.0 / 3.0, maximumCycleRatioHoward(g1, &cycle), 1e-9);
+    ASSERT_EQUAL(1, cycle.size());
+    ASSERT_EQUAL(4, cycle[0]->id);
+    ASSERT_APPROX_EQUAL(1.0, minimumCycleRatioHoward(g1, &cycle), 1e-9);
+    ASSERT_EQUAL(1, cycle.size());
+    ASSERT_EQUAL(6, cycle[0]->id);
+
+    // of parallel edges, the critical cycle takes the one attaining the ratio
+    MCMgraph gp;
+    MCMnode &p0 = *gp.addNode(0);
+    MCMnode &p1 = *gp.addNode(1);
+    gp.addEdge(0, p0, p1, 1.0, 1.0);
+    gp.addEdge(1, p1, p0, 1.0, 1.0);
+    gp.addEdge(2, p1, p0, 3.0, 3.0);
+    gp.addEdge(3, p1, p0, 2.0, 0.5);
+    ASSERT_APPROX_EQUAL(2.0, maximumCycleRatioHoward(gp, &cycle), 1e-9);
+    ASSERT_APPROX_EQUAL(2.0, cycleRatio(cycle), 1e-9);
+    ASSERT_APPROX_EQUAL(1.0, minimumCycleRatioHoward(gp, &cycle), 1e-9);
+    ASSERT_APPROX_EQUAL(1.0, cycleRatio(cycle), 1e-9);
+
+    // a cycle without delay is a deadlock
+    gp.addEdge(4, p0, p0, 1.0, 0.0);
+    ASSERT_EQUAL(INFINITY, maximumCycleRatioHoward(gp, &cycle));
+    ASSERT_EQUAL(1, cycle.size());
+    ASSERT_EQUAL(4, cycle[0]->id);
+    ASSERT_MP_EXCEPTION(minimumCycleRatioHoward(gp, &cycle));
+
+    // no cycles
+    MCMgraph g2 = makeGraph2();
+    ASSERT_EQUAL(-INFINITY, maximumCycleRatioHoward(g2));
+    ASSERT_EQUAL(INFINITY, minimumCycleRatioHoward(g2));
+
+    // agreement with Young-Tarjan-Orlin
+    for (unsigned int k = 0; k < 50; k++) {
+        MCMgraph gr = makeRandomGraph(20, 60, k);
+        CDouble result = maximumCycleRatioHoward(gr, &cycle);
+        ASSERT_APPROX_EQUAL(result, cycleRatio(cycle), 1e-9);
+        ASSERT_APPROX_EQUAL(maxCycleRatioYoungTarjanOrlin(gr), result, 1e-6 * result);
+        result = minimumCycleRatioHoward(gr, &cycle);
+        ASSERT_APPROX_EQUAL(result, cycleRatio(cycle), 1e-9);
+        ASSERT_APPROX_EQUAL(minCycleRatioYoungTarjanOrlin(gr), result, 1e-6 * result);
+    }
+}
+
+/// Test the exact MCM and MCR on integer weights.
+void MCMTest::test_exact() {
+    std::cout << "Running test: MCM-exact" << std::endl;
+
+    MCMgraph g1 = makeGraph1();
+    std::vector<const MCMedge *> cycle;
+    const CFraction mcm = maximumCycleMeanExact(g1, &cycle);
+    ASSERT_EQUAL(5, mcm.numerator());
+    ASSERT_EQUAL(2, mcm.denominator());
+    ASSERT_EQUAL(4, cycle.size());
+
+    // g1 has a non-integer delay, give it integer ones
+    const CompactMCMgraph c1(g1);
+    const std::vector<std::int64_t> w1 = {1, 2, 3, 4, 1, 4, 1};
+    const CFraction mcr = maximumCycleRatioExact(c1, w1, {1, 4, 0, 1, 3, 0, 1}, &cycle);
+    ASSERT_EQUAL(5, mcr.numerator());
+    ASSERT_EQUAL(3, mcr.denominator());
+    ASSERT_EQUAL(4, cycle.size());
+    ASSERT_MP_EXCEPTION(maximumCycleRatioExact(g1));
+
+    // a cycle without delay, and no cycle at all
+    const CFraction deadlock = maximumCycleRatioExact(c1, w1, {1, 4, 0, 1, 0, 0, 1}, &cycle);
+    ASSERT_THROW(!deadlock.isFraction());
+    ASSERT_EQUAL(INFINITY, deadlock.value());
+    ASSERT_EQUAL(1, cycle.size());
+    ASSERT_EQUAL(4, cycle[0]->id);
+    MCMgraph g2 = makeGraph2();
+    const CFraction noCycle = maximumCycleMeanExact(g2);
+    ASSERT_THROW(!noCycle.isFraction());
+    ASSERT_EQUAL(-INFINITY, noCycle.value());
+
+    // cycle sums that do not fit in 64 bits
+    ASSERT_MP_EXCEPTION(maximumCycleMeanExact(c1, {1, 2, INT64_MAX, INT64_MAX, 1, 4, 1}));
+
+    // agreement with the floating point algorithms on integer weights
+    for (unsigned int k = 0; k < 20; k++) {
+        MCMgraph gr = makeRandomGraph(40, 120, k);
+        for (auto &e : gr.getEdges()) {
+            e.w = std::round(e.w * 1000.0);
+            e.d = std::round(e.d * 1000.0) + 1.0;
+        }
+        const CFraction mean = maximumCycleMeanExact(gr, &cycle);
+        ASSERT_APPROX_EQUAL(
+                maximumCycleMeanKarpDouble(CompactMCMgraph(gr)), mean.value(), 1e-9 * mean.value());
+        CDouble w = 0.0;
+        for (const auto *e : cycle) {
+            w += e->w;
+        }
+        ASSERT_EQUAL(w * static_cast<CDouble>(mean.denominator()),
+                     static_cast<CDouble>(mean.numerator())
+                             * static_cast<CDouble>(cycle.size()));
+
+        const CFraction ratio = maximumCycleRatioExact(gr, &cycle);
+        ASSERT_APPROX_EQUAL(maximumCycleRatioHoward(gr), ratio.value(), 1e-9 * ratio.value());
+        w = 0.0;
+        CDouble d = 0.0;
+        for (const auto *e : cycle) {
+            w += e->w;
+            d += e->d;
+        }
+        ASSERT_EQUAL(w * static_cast<CDouble>(ratio.denominator()),
+                     d * static_cast<CDouble>(ratio.numerator()));
+    }
+}
+
+/// Test the replacement of paths without delay by longest delay edges.
+void MCMTest::test_longestDelayEdges() {
+    std::cout << "Running test: MCM-longest-delay-edges" << std::endl;
+
+    MCMgraph g;
+    MCMnode &n0 = *g.addNode(0);
+    MCMnode &n1 = *g.addNode(1);
+    MCMnode &n2 = *g.addNode(2);
+    MCMnode &n3 = *g.addNode(3);
+    g.addEdge(0, n0, n1, 2.0, 1.0);
+    g.addEdge(1, n1, n2, 3.0, 0.0);
+    g.addEdge(2, n2, n3, 1.0, 0.0);
+    g.addEdge(3, n1, n3, 5.0, 0.0);
+    g.addEdge(4, n3, n0, 1.0, 2.0);
+    addLongestDelayEdgesToMCMgraph(g);
+
+    // the edge with two delays is split over a new node
+    ASSERT_EQUAL(5, g.getNodes().size());
+    std::map<std::pair<CId, CId>, CDouble> visible;
+    for (const auto &e : g.getEdges()) {
+        ASSERT_THROW(e.visible == (e.d != 0));
+        if (e.visible) {
+            ASSERT_EQUAL(1.0, e.d);
+            visible[std::make_pair(e.src->id, e.dst->id)] = e.w;
+        }
+    }
+    ASSERT_EQUAL(5, visible.size());
+    ASSERT_EQUAL(2.0, visible[std::make_pair(0, 1)]);
+    ASSERT_EQUAL(5.0, visible[std::make_pair(0, 2)]);
+    ASSERT_EQUAL(7.0, visible[std::make_pair(0, 3)]);
+    ASSERT_EQUAL(0.0, visible[std::make_pair(3, 4)]);
+    ASSERT_EQUAL(1.0, visible[std::make_pair(4, 0)]);
+
+    // every edge is in the adjacency lists once
+    for (const auto &n : g.getNodes()) {
+        for (const auto *e : n.out) {
+            ASSERT_EQUAL(1, std::count(n.out.begin(), n.out.end(), e));
+            ASSERT_THROW(e->src == &n);
+        }
+    }
+    size_t nrOut = 0;
+    for (const auto &n : g.getNodes()) {
+        nrOut += n.out.size();
+    }
+    ASSERT_EQUAL(g.getEdges().size(), nrOut);
+
+    // a cycle without delay is accepted if its weight is not positive
+    MCMgraph gz;
+    MCMnode &z0 = *gz.addNode(0);
+    MCMnode &z1 = *gz.addNode(1);
+    MCMnode &z2 = *gz.addNode(2);
+    gz.addEdge(0, z0, z1, 2.0, 1.0);
+    gz.addEdge(1, z1, z2, 0.0, 0.0);
+    gz.addEdge(2, z2, z1, 0.0, 0.0);
+    gz.addEdge(3, z2, z0, 3.0, 1.0);
+    addLongestDelayEdgesToMCMgraph(gz);
+    visible.clear();
+    for (const auto &e : gz.getEdges()) {
+        if (e.visible) {
+            visible[std::make_pair(e.src->id, e.dst->id)] = e.w;
+        }
+    }
+    ASSERT_EQUAL(3, visible.size());
+    ASSERT_EQUAL(2.0, visible[std::make_pair(0, 1)]);
+    ASSERT_EQUAL(2.0, visible[std::make_pair(0, 2)]);
+    ASSERT_EQUAL(3.0, visible[std::make_pair(2, 0)]);
+
+    // a cycle without delay and with a positive weight is rejected
+    MCMgraph gc;
+    MCMnode &c0 = *gc.addNode(0);
+    MCMnode &c1 = *gc.addNode(1);
+    gc.addEdge(0, c0, c1, 1.0, 0.0);
+    gc.addEdge(1, c1, c0, 1.0, 0.0);
+    ASSERT_MP_EXCEPTION(addLongestDelayEdgesToMCMgraph(gc));
+}
+
+/// Test the computation of the critical graph.
+void MCMTest::test_critical() {
+    std::cout << "Running test: MCM-critical" << std::endl;
+
+    // the cycle through nodes 0 .. 3 is the only critical cycle
+    MCMgraph g1 = makeGraph1();
+    CriticalGraph cg = criticalGraph(g1);
+    ASSERT_APPROX_EQUAL(2.5, cg.mcm, 1e-9);
+    ASSERT_EQUAL(1, cg.components.size());
+    ASSERT_EQUAL(4, cg.components[0].nodes.size());
+    ASSERT_EQUAL(4, cg.components[0].edges.size());
+    for (unsigned int i = 0; i < 4; i++) {
+        ASSERT_EQUAL(i, cg.components[0].nodes[i]->id);
+        ASSERT_EQUAL(i, cg.components[0].edges[i]->id);
+    }
+
+    // two critical cycles sharing node 0, a separate critical self-loop on node 4
+    // and a non-critical cycle from which they are reachable
+    MCMgraph g2;
+    for (CId i = 0; i < 7; i++) {
+        g2.addNode(i);
+    }
+    g2.addEdge(0, *g2.getNode(0), *g2.getNode(1), 3.0, 1.0);
+    g2.addEdge(1, *g2.getNode(1), *g2.getNode(0), 1.0, 1.0);
+    g2.addEdge(2, *g2.getNode(0), *g2.getNode(2), 2.0, 1.0);
+    g2.addEdge(3, *g2.getNode(2), *g2.getNode(3), 2.0, 1.0);
+    g2.addEdge(4, *g2.getNode(3), *g2.getNode(0), 2.0, 1.0);
+    g2.addEdge(5, *g2.getNode(1), *g2.getNode(2), 0.0, 1.0);
+    g2.addEdge(6, *g2.getNode(4), *g2.getNode(4), 2.0, 1.0);
+    g2.addEdge(7, *g2.getNode(5), *g2.getNode(6), 1.0, 1.0);
+    g2.addEdge(8, *g2.getNode(6), *g2.getNode(5), 1.0, 1.0);
+    g2.addEdge(9, *g2.getNode(5), *g2.getNode(0), 1.0, 1.0);
+    g2.addEdge(10, *g2.getNode(6), *g2.getNode(4), 1.0, 1.0);
+    cg = criticalGraph(g2);
+    ASSERT_APPROX_EQUAL(2.0, cg.mcm, 1e-9);
+    ASSERT_EQUAL(2, cg.components.size());
+    ASSERT_EQUAL(4, cg.components[0].nodes.size());
+    ASSERT_EQUAL(5, cg.components[0].edges.size());
+    ASSERT_EQUAL(1, cg.components[1].nodes.size());
+    ASSERT_EQUAL(4, cg.components[1].nodes[0]->id);
+    ASSERT_EQUAL(6, cg.components[1].edges[0]->id);
+
+    // no cycle
+    MCMgraph g3 = makeGraph2();
+    cg = criticalGraph(g3);
+    ASSERT_EQUAL(-INFINITY, cg.mcm);
+    ASSERT_THROW(cg.components.empty());
+
+    // an edge is critical if and only if the heaviest cycle through it is
+    // critical, which is checked with the longest paths of all pairs of nodes
+    for (unsigned int k = 0; k < 50; k++) {
+        MCMgraph gr = makeRandomGraph(12, 20, k);
+        // round the weights to make ties between cycles likely
+        for (auto &e : gr.getEdges()) {
+            e.w = std::floor(e.w / 25.0);
+        }
+        cg = criticalGraph(gr);
+        const CDouble mcm = maximumCycleMeanHoward(CompactMCMgraph(gr), nullptr);
+        ASSERT_APPROX_EQUAL(mcm, cg.mcm, 1e-9);
+
+        const size_t n = gr.getNodes().size();
+        std::vector<std::vector<CDouble>> longest(n, std::vector<CDouble>(n, -INFINITY));
+        for (size_t i = 0; i < n; i++) {
+            longest[i][i] = 0.0;
+        }
+        for (const auto &e : gr.getEdges()) {
+            longest[e.src->id][e.dst->id] =
+                    std::max(longest[e.src->id][e.dst->id], e.w - mcm);
+        }
+        for (size_t l = 0; l < n; l++) {
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < n; j++) {
+                    longest[i][j] = std::max(longest[i][j], longest[i][l] + longest[l][j]);
+                }
+            }
+        }
+
+        std::set<CId> criticalEdges;
+        for (const auto &c : cg.components) {
+            for (const auto *e : c.edges) {
+                criticalEdges.insert(e->id);
+            }
+        }
+        for (const auto &e : gr.getEdges()) {
+            bool isCritical = std::fabs(e.w - mcm + longest[e.dst->id][e.src->id]) < 1e-9;
+            ASSERT_EQUAL(isCritical, criticalEdges.count(e.id) == 1);
+        }
+    }
+}
+
+/// Test the incremental maintenance of the MCM.
+void MCMTest::test_incremental() {
+    std::cout << "Running test: MCM-incremental" << std::endl;
+
+    MCMgraph g;
+    IncrementalMCM inc(g);
+    ASSERT_EQUAL(-INFINITY, inc.mcm());
+    MCMnode *n0 = inc.addNode(0);
+    MCMnode *n1 = inc.addNode(1);
+    MCMnode *n2 = inc.addNode(2);
+    inc.addEdge(0, *n0, *n1, 1.0);
+    ASSERT_EQUAL(-INFINITY, inc.mcm());
+    inc.addEdge(1, *n1, *n0, 3.0);
+    ASSERT_APPROX_EQUAL(2.0, inc.mcm(), 1e-9);
+    // a lighter cycle and an edge out of the cycle leave the MCM unchanged
+    inc.addEdge(2, *n1, *n2, 1.0);
+    MCMedge *e3 = inc.addEdge(3, *n2, *n0, 1.0);
+    ASSERT_APPROX_EQUAL(2.0, inc.mcm(), 1e-9);
+    const unsigned int recomputations = inc.nrRecomputations();
+    inc.increaseWeight(*e3, 2.0);
+    ASSERT_APPROX_EQUAL(2.0, inc.mcm(), 1e-9);
+    ASSERT_EQUAL(recomputations, inc.nrRecomputations());
+    inc.increaseWeight(*e3, 7.0);
+    ASSERT_APPROX_EQUAL(3.0, inc.mcm(), 1e-9);
+    inc.addEdge(4, *n2, *n2, 3.5);
+    ASSERT_APPROX_EQUAL(3.5, inc.mcm(), 1e-9);
+    ASSERT_MP_EXCEPTION(inc.increaseWeight(*e3, 1.0));
+
+    // random sequences of insertions and weight increases, compared with
+    // computing the MCM from scratch
+    for (unsigned int k = 0; k < 20; k++) {
+        std::mt19937 rng(k);
+        // start from a part of the graph, then add to it
+        MCMgraph gr = makeRandomGraph(30, 20, k);
+        std::vector<MCMnode *> nodes;
+        for (auto &n : gr.getNodes()) {
+            nodes.push_back(&n);
+        }
+        std::vector<MCMedge *> edges;
+        for (auto &e : gr.getEdges()) {
+            edges.push_back(&e);
+        }
+        IncrementalMCM incr(gr);
+        const auto first = static_cast<CId>(edges.size());
+        for (CId i = first; i < first + 130; i++) {
+            if (i % 3 == 0) {
+                MCMedge *e = edges[rng() % edges.size()];
+                incr.increaseWeight(*e, e->w + static_cast<CDouble>(rng() % 100));
+            } else {
+                edges.push_back(incr.addEdge(i,
+                                             *nodes[rng() % nodes.size()],
+                                             *nodes[rng() % nodes.size()],
+                                             static_cast<CDouble>(rng() % 1000)));
+            }
+            CDouble expected = maximumCycleMeanKarpDouble(CompactMCMgraph(gr));
+            ASSERT_APPROX_EQUAL(expected, incr.mcm(), 1e-6);
+        }
+        // most updates are handled locally
+        ASSERT_THROW(incr.nrRecomputations() < 60);
+    }
+}
+
+/// Test reading and writing of compact graphs as text and binary files.
+void MCMTest::test_io() {
+    std::cout << "Running test: MCM-io" << std::endl;
+
+    // text with comments, a problem line, edges with and without delay and a
+    // last line without a newline
+    std::istringstream text("c a small graph\n"
+                            "p mcm 3 4\n"
+                            "a 1 2 4\n"
+                            "a 2 1 2.5 1\r\n"
+                            "\n"
+                            "  a 2 3 -1e1 0\n"
+                            "a 3 3 7.25");
+    CompactMCMgraph small = readCompactMCMgraph(text);
+    ASSERT_EQUAL(3U, small.nrNodes());
+    ASSERT_EQUAL(4U, small.nrEdges());
+    ASSERT_EQUAL(1U, small.source(1));
+    ASSERT_EQUAL(0U, small.destination(1));
+    ASSERT_APPROX_EQUAL(2.5, small.weight(1), 1e-12);
+    ASSERT_APPROX_EQUAL(1.0, small.delay(1), 1e-12);
+    ASSERT_APPROX_EQUAL(-10.0, small.weight(2), 1e-12);
+    ASSERT_APPROX_EQUAL(0.0, small.delay(0), 1e-12);
+    ASSERT_THROW(small.node(0) == nullptr);
+
+    // without a problem line the largest node number is the number of nodes
+    std::istringstream noProblem("a 5 2 1\n");
+    ASSERT_EQUAL(5U, readCompactMCMgraph(noProblem).nrNodes());
+
+    // malformed input
+    for (const char *bad : {"a 1 2\n", "p mcm 2 1\na 1 3 1\n", "a 0 1 1\n", "x\n", "a 1 1 1 1 1\n",
+                            "a 1 1 1\np mcm 1 1\n", "a 1 1 nan\n", "p mcm 1 4000000000\n"}) {
+        std::istringstream in(bad);
+        ASSERT_MP_EXCEPTION(readCompactMCMgraph(in));
+    }
+
+    // a random graph larger than a chunk survives text and binary round trips
+    MCMgraph gr = makeRandomGraph(1000, 20000, 46, 0.0, 3.0);
+    for (auto &e : gr.getEdges()) {
+        e.w /= 7.0;
+    }
+    CompactMCMgraph compact(gr);
+
+    std::stringstream stream;
+    writeCompactMCMgraph(stream, compact);
+    CompactMCMgraph fromText = readCompactMCMgraph(stream);
+
+    const std::string fileName = "mcmtest_io.bin";
+    saveBinaryMCMgraph(fileName, compact);
+    CompactMCMgraph fromBinary = loadBinaryMCMgraph(fileName);
+    std::remove(fileName.c_str());
+
+    for (const CompactMCMgraph *loaded : {&fromText, &fromBinary}) {
+        ASSERT_EQUAL(compact.nrNodes(), loaded->nrNodes());
+        ASSERT_EQUAL(compact.nrEdges(), loaded->nrEdges());
+        bool same = true;
+        for (unsigned int e = 0; e < compact.nrEdges(); e++) {
+            same = same && loaded->source(e) == compact.source(e)
+                   && loaded->destination(e) == compact.destination(e)
+                   && loaded->weight(e) == compact.weight(e)
+                   && loaded->delay(e) == compact.delay(e);
+        }
+        ASSERT_THROW(same);
+    }
+
+    // the materialized graph has the same maximum cycle mean
+    MCMgraph materialized = materializeMCMgraph(fromBinary);
+    ASSERT_EQUAL(gr.getNodes().size(), materialized.getNodes().size());
+    ASSERT_EQUAL(gr.getEdges().size(), materialized.getEdges().size());
+    ASSERT_APPROX_EQUAL(maximumCycleMeanKarpDouble(gr),
+                        maximumCycleMeanKarpDouble(materialized),
+                        1e-9);
+
+    ASSERT_MP_EXCEPTION(loadBinaryMCMgraph("mcmtest_io_missing.bin"));
+}
+
+/// Test the longest paths from a root node.
+void MCMTest::test_longestPaths() {
+    std::cout << "Running test: MCM-longest-paths" << std::endl;
+
+    // a chain with a detour and an unreachable node
+    MCMgraph g;
+    std::vector<MCMnode *> n;
+    for (CId i = 0; i < 5; i++) {
+        n.push_back(g.addNode(i));
+    }
+    g.addEdge(0, *n[0], *n[1], 2.0, 1.0);
+    g.addEdge(1, *n[1], *n[2], 3.0, 1.0);
+    g.addEdge(2, *n[0], *n[2], 4.0, 1.0);
+    g.addEdge(3, *n[2], *n[3], -1.0, 1.0);
+    g.addEdge(4, *n[4], *n[0], 1.0, 1.0);
+    CompactMCMgraph cg(g);
+    std::vector<CDouble> dist = longestPaths(cg, 0);
+    ASSERT_EQUAL(size_t{5}, dist.size());
+    ASSERT_APPROX_EQUAL(0.0, dist[0], 1e-12);
+    ASSERT_APPROX_EQUAL(2.0, dist[1], 1e-12);
+    ASSERT_APPROX_EQUAL(5.0, dist[2], 1e-12);
+    ASSERT_APPROX_EQUAL(4.0, dist[3], 1e-12);
+    ASSERT_THROW(dist[4] == -INFINITY);
+    std::vector<CDouble> normalized = normalizedLongestPaths(cg, 0, 2.0);
+    ASSERT_APPROX_EQUAL(2.0, normalized[2], 1e-12);
+    ASSERT_APPROX_EQUAL(-1.0, normalized[3], 1e-12);
+    // the edges leaving a node with an infinite value are not normalized
+    normalized = normalizedLongestPaths(cg, 0, {-INFINITY, 1.0, 1.0, 1.0, 1.0});
+    ASSERT_APPROX_EQUAL(4.0, normalized[2], 1e-12);
+    ASSERT_APPROX_EQUAL(2.0, normalized[3], 1e-12);
+
+    // a positive cycle reachable from the root is reported
+    g.addEdge(5, *n[3], *n[1], 0.0, 1.0);
+    ASSERT_MP_EXCEPTION((void)longestPaths(CompactMCMgraph(g), 0));
+    ASSERT_MP_EXCEPTION((void)g.longestPaths(0));
+
+    // random graphs normalized by their maximum cycle ratio, compared with
+    // Bellman-Ford over all edges
+    for (unsigned int k = 0; k < 20; k++) {
+        MCMgraph gr = makeRandomGraph(40, 120, k, 1.0, 4.0);
+        CompactMCMgraph compact(gr);
+        const unsigned int n = compact.nrNodes();
+        const CDouble mu = maximumCycleRatioHoward(compact);
+        const std::vector<CDouble> spfa = normalizedLongestPaths(compact, 0, mu);
+
+        // Bellman-Ford over all edges with the weight of edge e given by weight(e)
+        auto bellmanFord = [&compact, n](auto weight) {
+            std::vector<CDouble> result(n, -INFINITY);
+            result[0] = 0.0;
+            for (unsigned int round = 0; round < n; round++) {
+                for (unsigned int e = 0; e < compact.nrEdges(); e++) {
+                    result[compact.destination(e)] = std::max(
+                            result[compact.destination(e)], result[compact.source(e)] + weight(e));
+                }
+            }
+            return result;
+        };
+        const std::vector<CDouble> expected = bellmanFord(
+                [&](unsigned int e) { return compact.weight(e) - mu * compact.delay(e); });
+        // MCMgraph subtracts mu from every edge, whatever its delay
+        const std::vector<CDouble> expectedPlain =
+                bellmanFord([&](unsigned int e) { return compact.weight(e) - 3.0 * mu; });
+        const std::map<CId, CDouble> plain = gr.normalizedLongestPaths(0, 3.0 * mu);
+
+        std::vector<CDouble> perNode(n);
+        for (unsigned int v = 0; v < n; v++) {
+            perNode[v] = mu + static_cast<CDouble>(v % 3);
+        }
+        const std::vector<CDouble> spfaPerNode = normalizedLongestPaths(compact, 0, perNode);
+
+        bool same = true;
+        for (unsigned int v = 0; v < n; v++) {
+            if (expected[v] == -INFINITY) {
+                same = same && spfa[v] == -INFINITY && plain.at(v) == -DBL_MAX;
+            } else {
+                same = same && std::fabs(spfa[v] - expected[v]) < 1e-6
+                       && std::fabs(plain.at(v) - expectedPlain[v]) < 1e-6;
+            }
+        }
+        ASSERT_THROW(same);
+        // larger values of mu only make paths shorter
+        for (unsigned int v = 0; v < n; v++) {
+            ASSERT_THROW(spfaPerNode[v] <= spfa[v] + 1e-6);
+        }
+    }
+}
+
+/// Test the decomposition of a compact graph into its components.
+void MCMTest::test_decomposition() {
+    std::cout << "Running test: MCM-decomposition" << std::endl;
+
+    for (unsigned int k = 0; k < 20; k++) {
+        MCMgraph gr = makeRandomGraph(30, 20 + 3 * k, k, 1.0, 1.0);
+        CompactMCMgraph g(gr);
+        const unsigned int n = g.nrNodes();
+        ComponentDecomposition scc = decomposeComponents(g);
+
+        // reachability by a transitive closure
+        std::vector<std::vector<bool>> reach(n, std::vector<bool>(n, false));
+        for (unsigned int v = 0; v < n; v++) {
+            reach[v][v] = true;
+        }
+        for (unsigned int e = 0; e < g.nrEdges(); e++) {
+            reach[g.source(e)][g.destination(e)] = true;
+        }
+        for (unsigned int w = 0; w < n; w++) {
+            for (unsigned int u = 0; u < n; u++) {
+                for (unsigned int v = 0; v < n; v++) {
+                    reach[u][v] = reach[u][v] || (reach[u][w] && reach[w][v]);
+                }
+            }
+        }
+        bool consistent = true;
+        for (unsigned int u = 0; u < n; u++) {
+            for (unsigned int v = 0; v < n; v++) {
+                consistent = consistent
+                             && ((scc.component[u] == scc.component[v])
+                                 == (reach[u][v] && reach[v][u]));
+            }
+            const unsigned int c = scc.component[u];
+            consistent = consistent && scc.nodes[scc.nodeStart[c] + scc.position[u]] == u;
+        }
+        ASSERT_THROW(consistent);
+
+        // every edge is inside exactly one component or a cross edge, and the
+        // condensation has an edge for every cross edge, to a lower number
+        ASSERT_EQUAL(static_cast<size_t>(g.nrEdges()), scc.edges.size() + scc.crossEdges.size());
+        for (unsigned int c = 0; c < scc.nrComponents; c++) {
+            for (unsigned int i = scc.edgeStart[c]; i < scc.edgeStart[c + 1]; i++) {
+                consistent = consistent && scc.component[g.source(scc.edges[i])] == c
+                             && scc.component[g.destination(scc.edges[i])] == c;
+            }
+            for (unsigned int i = scc.successorStart[c]; i < scc.successorStart[c + 1]; i++) {
+                consistent = consistent && scc.successors[i] < c;
+            }
+        }
+        for (unsigned int e : scc.crossEdges) {
+            const unsigned int c = scc.component[g.source(e)];
+            const auto first = scc.successors.begin() + scc.successorStart[c];
+            const auto last = scc.successors.begin() + scc.successorStart[c + 1];
+            consistent =
+                    consistent && std::count(first, last, scc.component[g.destination(e)]) == 1;
+        }
+        ASSERT_THROW(consistent);
+
+        // Karp on the components in place agrees with Karp on the whole graph
+        const MCMnode *critical = nullptr;
+        const CDouble expected = maximumCycleMeanKarpDouble(g);
+        ASSERT_APPROX_EQUAL(expected, maximumCycleMeanKarpComponents(g, &critical), 1e-9);
+        if (expected != -INFINITY) {
+            // the critical node lies in a component with the maximum cycle mean
+            unsigned int v = 0;
+            while (g.node(v) != critical) {
+                v++;
+            }
+            ASSERT_APPROX_EQUAL(
+                    expected, maximumCycleMeanKarpDouble(g, scc, scc.component[v]), 1e-9);
+        } else {
+            ASSERT_THROW(critical == nullptr);
+        }
+    }
+
+    // a graph without cycles has no critical node
+    MCMgraph acyclic = makeGraph2();
+    const MCMnode *critical = acyclic.getNode(0);
+    ASSERT_EQUAL(-INFINITY, maximumCycleMeanKarpComponents(CompactMCMgraph(acyclic), &critical));
+    ASSERT_THROW(critical == nullptr);
+}
+
+/// Test the bounds of the anytime MCM.
+void MCMTest::test_anytime() {
+    std::cout << "Running test: MCM-anytime" << std::endl;
+
+    // a graph without cycles
+    MCMgraph acyclic;
+    MCMnode &a0 = *acyclic.addNode(0);
+    MCMnode &a1 = *acyclic.addNode(1);
+    acyclic.addEdge(0, a0, a1, 1.0, 1.0);
+    AnytimeMCMResult none = anytimeMaximumCycleMean(acyclic, AnytimeMCMOptions());
+    ASSERT_THROW(none.converged && none.lower == -INFINITY && none.upper == -INFINITY);
+
+    for (unsigned int k = 0; k < 20; k++) {
+        MCMgraph gr = makeRandomGraph(60, 200, k, 1.0, 1.0);
+        const CDouble expected = maximumCycleMeanKarpDouble(CompactMCMgraph(gr));
+
+        // the bounds enclose the maximum cycle mean at every checkpoint and
+        // close when the algorithm runs to the end
+        AnytimeMCMOptions options;
+        bool enclosed = true;
+        CDouble lastLower = -INFINITY;
+        CDouble lastUpper = INFINITY;
+        unsigned int nrCalls = 0;
+        options.progress = [&](const AnytimeMCMResult &bounds) {
+            nrCalls++;
+            enclosed = enclosed && bounds.lower <= expected + 1e-9
+                       && bounds.upper >= expected - 1e-9 && bounds.lower >= lastLower
+                       && bounds.upper <= lastUpper;
+            lastLower = bounds.lower;
+            lastUpper = bounds.upper;
+        };
+        AnytimeMCMResult full = anytimeMaximumCycleMean(gr, options);
+        ASSERT_THROW(enclosed);
+        ASSERT_THROW(full.converged);
+        ASSERT_EQUAL(full.nrIterations + 1, nrCalls);
+        ASSERT_APPROX_EQUAL(expected, full.lower, 1e-9);
+        ASSERT_APPROX_EQUAL(expected, full.upper, 1e-4);
+        CDouble sum = 0.0;
+        for (const MCMedge *e : full.cycle) {
+            sum += e->w;
+        }
+        ASSERT_APPROX_EQUAL(full.lower, sum / static_cast<CDouble>(full.cycle.size()), 1e-9);
+
+        // a deadline in the past stops at the first checkpoint with valid bounds
+        AnytimeMCMOptions early;
+        early.deadline = std::chrono::steady_clock::now();
+        AnytimeMCMResult first = anytimeMaximumCycleMean(gr, early);
+        ASSERT_EQUAL(0U, first.nrIterations);
+        ASSERT_THROW(first.upper >= expected && first.lower == -INFINITY);
+
+        // a wide tolerance stops as soon as the gap is small enough
+        AnytimeMCMOptions loose;
+        loose.tolerance = 100.0;
+        AnytimeMCMResult coarse = anytimeMaximumCycleMean(gr, loose);
+        ASSERT_THROW(coarse.converged && coarse.upper - coarse.lower <= 100.0);
+        ASSERT_THROW(coarse.lower <= expected + 1e-9 && coarse.upper >= expected - 1e-9);
+        ASSERT_THROW(coarse.nrIterations <= full.nrIterations);
+    }
+}
+
+/// Test the approximate MCM and MCR with Lawler's parametric search.
+void MCMTest::test_approximate() {
+    std::cout << "Running test: MCM-approximate" << std::endl;
+
+    // no cycles, a cycle without delay and an invalid accuracy
+    MCMgraph small;
+    MCMnode &s0 = *small.addNode(0);
+    MCMnode &s1 = *small.addNode(1);
+    small.addEdge(0, s0, s1, 1.0, 1.0);
+    ApproximateMCMResult none = approximateMaximumCycleRatio(small, 1e-3);
+    ASSERT_THROW(none.lower == -INFINITY && none.upper == -INFINITY && none.cycle.empty());
+    MCMedge *back = small.addEdge(1, s1, s0, 1.0, 0.0);
+    small.getEdge(0)->d = 0.0;
+    ApproximateMCMResult deadlock = approximateMaximumCycleRatio(small, 1e-3);
+    ASSERT_THROW(deadlock.lower == INFINITY && deadlock.cycle.size() == 2);
+    back->d = 2.0;
+    ASSERT_MP_EXCEPTION((void)approximateMaximumCycleRatio(small, 0.0));
+
+    // behind a long path the gain of a cycle is below the tolerance of the
+    // test, the upper bound must still contain its mean
+    MCMgraph far;
+    MCMnode &f0 = *far.addNode(0);
+    MCMnode &f1 = *far.addNode(1);
+    far.addEdge(0, f0, f0, 0.0, 1.0);
+    far.addEdge(1, f0, f1, 1e15, 1.0);
+    far.addEdge(2, f1, f1, 5.0, 1.0);
+    ApproximateMCMResult hidden = approximateMaximumCycleMean(far, 1e-3);
+    ASSERT_THROW(hidden.lower <= 5.0 && hidden.upper >= 5.0);
+
+    for (unsigned int k = 0; k < 20; k++) {
+        // large enough for the positive cycle test to run on several threads
+        const unsigned int n = k < 4 ? 4000 : 50;
+        MCMgraph gr = makeRandomGraph(n, 4 * n, k, 1.0, 4.0);
+        for (auto &e : gr.getEdges()) {
+            e.w -= 30.0;
+        }
+        CompactMCMgraph g(gr);
+        const CDouble exactRatio = maximumCycleRatioHoward(g);
+        const CDouble exactMean = maximumCycleMeanKarpDouble(g);
+
+        for (CDouble eps : {10.0, 1e-3}) {
+            ApproximateMCMResult ratio = approximateMaximumCycleRatio(g, eps, 1);
+            ASSERT_THROW(ratio.lower <= exactRatio + 1e-9 && ratio.upper >= exactRatio - 1e-9);
+            ASSERT_THROW(ratio.upper - ratio.lower <= eps);
+            CDouble w = 0.0;
+            CDouble d = 0.0;
+            for (const MCMedge *e : ratio.cycle) {
+                w += e->w;
+                d += e->d;
+            }
+            ASSERT_APPROX_EQUAL(ratio.lower, w / d, 1e-9);
+
+            // the result does not depend on the number of threads
+            ApproximateMCMResult parallel = approximateMaximumCycleRatio(g, eps, 4);
+            ASSERT_THROW(parallel.lower == ratio.lower && parallel.upper == ratio.upper
+                         && parallel.cycle == ratio.cycle);
+
+            ApproximateMCMResult mean = approximateMaximumCycleMean(g, eps);
+            ASSERT_THROW(mean.lower <= exactMean + 1e-9 && mean.upper >= exactMean - 1e-9);
+            ASSERT_THROW(mean.upper - mean.lower <= eps);
+        }
+    }
 }
@@ -15,7 +15,22 @@ public:
 
     void test_dg();
     void test_howard();
+    void test_howardRatio();
     void test_karp();
     void test_yto();
     void test_prune();
+    void test_compact();
+    void test_lookup();
+    void test_components();
+    void test_facade();
+    void test_batch();
+    void test_exact();
+    void test_longestDelayEdges();
+    void test_critical();
+    void test_incremental();
+    void test_io();
+    void test_longestPaths();
+    void test_decomposition();
+    void test_anytime();
+    void test_approximate();
 };
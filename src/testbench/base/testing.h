@@ -47,6 +47,22 @@ namespace testing {
         }                                                                                          \
     }
 
+#define ASSERT_MP_EXCEPTION(...)                                                                   \
+    {                                                                                              \
+        bool thrown = false;                                                                       \
+        try {                                                                                      \
+            __VA_ARGS__;                                                                           \
+        } catch (const MaxPlus::MPException &) {                                                   \
+            thrown = true;                                                                         \
+        }                                                                                          \
+        if (!thrown) {                                                                             \
+            throw std::runtime_error(std::string("Expected MPException not thrown.")               \
+                                     + std::string("\nIn:") + std::string(__FILE__)                \
+                                     + std::string(":") + std::to_string(__LINE__)                 \
+                                     + std::string(" in ") + std::string(__FUNCTION__));           \
+        }                                                                                          \
+    }
+
 class Test {
 
 public:
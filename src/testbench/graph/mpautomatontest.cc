@@ -21,6 +21,7 @@ void MPAutomatonTest::TearDown() {}
 void MPAutomatonTest::Run() {
     testCreateFSM();
     testDeterminizeFSM();
+    testNegativeRewardsFSM();
     testMinimizeFSM();
     testDFSFSM();
     testDetectCycleFSM();
@@ -103,6 +104,28 @@ void MPAutomatonTest::testDeterminizeFSM() {
     ASSERT_EQUAL(cycle->size(), 2);
 }
 
+void MPAutomatonTest::testNegativeRewardsFSM() {
+
+    std::cout << "Running test: NegativeRewardsFSM" << std::endl;
+
+    MaxPlusAutomatonWithRewards mpa;
+
+    MPARStateRef s1 = mpa.addState(makeMPAStateLabel(0, 0));
+    MPARStateRef s2 = mpa.addState(makeMPAStateLabel(0, 1));
+
+    // s1 -- (3,A,1) -> s2 -- (1,B,-0.5) -> s1 has ratio 4 / 0.5
+    mpa.addEdge(*s1, makeRewardEdgeLabel(MPTime(3.0), MPString("A"), 1.0), *s2);
+    mpa.addEdge(*s2, makeRewardEdgeLabel(MPTime(1.0), MPString("B"), -0.5), *s1);
+    // s1 -- (2,C,1) -> s1 has ratio 2
+    mpa.addEdge(*s1, makeRewardEdgeLabel(MPTime(2.0), MPString("C"), 1.0), *s1);
+    mpa.setInitialState(*s1);
+
+    ASSERT_APPROX_EQUAL(8.0, mpa.calculateMCR(), ASSERT_EPSILON);
+    std::shared_ptr<std::vector<const MPAREdge *>> cycle;
+    ASSERT_APPROX_EQUAL(8.0, mpa.calculateMCRAndCycle(&cycle), ASSERT_EPSILON);
+    ASSERT_EQUAL(2, cycle->size());
+}
+
 void MPAutomatonTest::testMinimizeFSM() {
 
     std::cout << "Running test: MinimizeFSM\n";
@@ -17,6 +17,7 @@ public:
     void Run() override;
     void testCreateFSM();
     void testDeterminizeFSM();
+    void testNegativeRewardsFSM();
     void testMinimizeFSM();
     void testDetectCycleFSM();
     void testDFSFSM();